@@ -69,6 +69,9 @@ void SystemClock_Config(void);
 #define PA_PSU_SEL_GPIO_Port GPIOC
 
 /* USER CODE BEGIN Private defines */
+/** Attention line to the SPI host, open-drain active low (USE_SPI_ATTN) */
+#define SPI_ATTN_Pin GPIO_PIN_9
+#define SPI_ATTN_GPIO_Port GPIOB
 
 /* USER CODE END Private defines */
 
@@ -61,6 +61,17 @@ void SPI1_IRQHandler(void);
 void LPUART1_IRQHandler(void);
 void SUBGHZ_Radio_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+#ifdef USE_UART_DMA_RX
+void DMA1_Channel1_IRQHandler(void);
+#endif
+#ifdef USE_UART_DMA_TX
+void DMA1_Channel2_IRQHandler(void);
+#endif
+#ifdef USE_SPI_DMA
+void DMA1_Channel3_IRQHandler(void);
+void DMA1_Channel4_IRQHandler(void);
+void EXTI15_10_IRQHandler(void);
+#endif
 
 /* USER CODE END EFP */
 
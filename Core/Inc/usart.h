@@ -35,6 +35,12 @@ extern "C" {
 extern UART_HandleTypeDef hlpuart1;
 
 /* USER CODE BEGIN Private defines */
+#ifdef USE_UART_DMA_RX
+extern DMA_HandleTypeDef hdma_lpuart1_rx;
+#endif
+#ifdef USE_UART_DMA_TX
+extern DMA_HandleTypeDef hdma_lpuart1_tx;
+#endif
 
 /* USER CODE END Private defines */
 
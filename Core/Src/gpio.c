@@ -100,7 +100,7 @@ void MX_GPIO_Init(void)
    * PB3 = DBG_SWO
    * PB6 = UART
    * PB7 = UART
-   * PB9 = GPIO
+   * PB9 = GPIO, SPI attention line when USE_SPI_ATTN
    * PB13 = GPIO
   */
 
@@ -114,11 +114,24 @@ void MX_GPIO_Init(void)
                         GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7 |
                         GPIO_PIN_8 | GPIO_PIN_9 | GPIO_PIN_10 | GPIO_PIN_11 | GPIO_PIN_12 | GPIO_PIN_13 |
                         GPIO_PIN_14 | GPIO_PIN_15;
+#endif
+#if defined(USE_SPI_DRIVER) && defined(USE_SPI_ATTN)
+  GPIO_InitStruct.Pin &= ~SPI_ATTN_Pin;
 #endif
   GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
   GPIO_InitStruct.Pull = GPIO_NOPULL;
   HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 
+#if defined(USE_SPI_DRIVER) && defined(USE_SPI_ATTN)
+  /*Configure GPIO pin : SPI_ATTN, released until something is to be reported to the host */
+  HAL_GPIO_WritePin(SPI_ATTN_GPIO_Port, SPI_ATTN_Pin, GPIO_PIN_SET);
+  GPIO_InitStruct.Pin = SPI_ATTN_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+  HAL_GPIO_Init(SPI_ATTN_GPIO_Port, &GPIO_InitStruct);
+#endif
+
   /*Configure GPIOC pins to analog except :
    * PC0 = VPA_SEL
    * PC1 = VPA_EN MOSI
@@ -72,6 +72,7 @@
 #include "kns_q.h"
 #include "kns_os.h"
 #include "mcu_tim.h"
+#include "mcu_prof.h"
 #include "kns_mac.h"
 #include "kns_app.h"
 #ifdef USE_GUI_APP
@@ -176,6 +177,29 @@ void assertMspOverflow(void)
   assert_param( *(stack_lower_limit) == 0xAAAAAAAA );
 }
 
+#ifdef USE_BAREMETAL
+/**
+ * @brief Check some task still has something to process, meaning low power mode cannot be entered
+ *
+ * With the event-driven Kineis OS scheduler, this is a single read of the task ready flags.
+ * Otherwise, all queues and the AT cmd FIFO are checked. Work deferred from ISRs is checked too.
+ *
+ * @retval true if some event is pending
+ */
+static inline bool IDLE_isEvtPending(void)
+{
+  if (KNS_OS_isWorkPending())
+    return true;
+#if defined(USE_KNS_OS_EVT_DRIVEN)
+  return (KNS_OS_getReadyMask() != 0);
+#elif defined(USE_GUI_APP)
+  return ((KNS_Q_getEvtMask() != 0) || MGR_AT_CMD_isPendingAt());
+#else
+  return (KNS_Q_getEvtMask() != 0);
+#endif
+}
+#endif
+
 /**
  * @brief IDLE task to be registered in OS
  *
@@ -219,7 +243,7 @@ static void IDLE_task(void)
   {
     /** wait wakeup pin to turn low (unplug debugger or by user) */
     while(HAL_GPIO_ReadPin(EXT_WKUP_BUTTON_GPIO_Port, EXT_WKUP_BUTTON_Pin) == GPIO_PIN_SET) {
-      if (KNS_Q_isEvtInSomeQ() || MGR_AT_CMD_isPendingAt())
+      if (IDLE_isEvtPending())
         return;
     }
     /** Do the last check on event out of for loop. */
@@ -230,7 +254,7 @@ static void IDLE_task(void)
   prim = __get_PRIMASK();
   __disable_irq();
   __disable_fault_irq();
-  if (KNS_Q_isEvtInSomeQ() || MGR_AT_CMD_isPendingAt()) {
+  if (IDLE_isEvtPending()) {
     if (!prim){
       __enable_fault_irq();
       __enable_irq();
@@ -262,7 +286,7 @@ static void IDLE_task(void)
   prim = __get_PRIMASK();
   __disable_irq();
   __disable_fault_irq();
-  if (KNS_Q_isEvtInSomeQ()) {
+  if (IDLE_isEvtPending()) {
     if (!prim){
       __enable_fault_irq();
       __enable_irq();
@@ -499,6 +523,10 @@ int main(void)
   /** End of init sequence, set LPM as runtime mode before starting all tasks */
   LPM_forceMode(LOW_POWER_MODE_NONE);
 
+#ifdef USE_MCU_PROF
+  MCU_PROF_init();
+#endif
+
   /** Start all tasks */
   KNS_OS_main();
 
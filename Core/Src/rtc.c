@@ -109,6 +109,15 @@ void MX_RTC_Init(void)
     Error_Handler();
   }
 
+  /** Read calendar counters directly (MCU_TIM_getTimeMs), shadow registers being out of date
+   * after a STOP mode exit until next synchro. BYPSHAD is in backup domain, kept over
+   * Standby/Shutdown.
+   */
+  if (HAL_RTCEx_EnableBypassShadow(&hrtc) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
   /* USER CODE END RTC_Init 2 */
 
 }
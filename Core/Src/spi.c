@@ -21,6 +21,13 @@
 #include "spi.h"
 
 /* USER CODE BEGIN 0 */
+#ifdef USE_SPI_DMA
+/** SPI commands are framed in one chip-select window, captured by DMA */
+DMA_HandleTypeDef hdma_spi1_rx;
+DMA_HandleTypeDef hdma_spi1_tx;
+/** NSS rising edge marks the end of a frame */
+static EXTI_HandleTypeDef hexti_spi1_nss;
+#endif
 
 /* USER CODE END 0 */
 
@@ -98,6 +105,65 @@ void HAL_SPI_MspInit(SPI_HandleTypeDef* spiHandle)
     HAL_NVIC_SetPriority(SPI1_IRQn, 0, 0);
     HAL_NVIC_EnableIRQ(SPI1_IRQn);
   /* USER CODE BEGIN SPI1_MspInit 1 */
+#ifdef USE_SPI_DMA
+    EXTI_ConfigTypeDef extiConfig = {0};
+
+    /* DMA controller clock enable */
+    __HAL_RCC_DMAMUX1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    /* SPI1_RX DMA Init */
+    hdma_spi1_rx.Instance = DMA1_Channel3;
+    hdma_spi1_rx.Init.Request = DMA_REQUEST_SPI1_RX;
+    hdma_spi1_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_spi1_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_spi1_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_spi1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi1_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_spi1_rx.Init.Mode = DMA_NORMAL;
+    hdma_spi1_rx.Init.Priority = DMA_PRIORITY_VERY_HIGH;
+    if (HAL_DMA_Init(&hdma_spi1_rx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(spiHandle, hdmarx, hdma_spi1_rx);
+
+    /* SPI1_TX DMA Init */
+    hdma_spi1_tx.Instance = DMA1_Channel4;
+    hdma_spi1_tx.Init.Request = DMA_REQUEST_SPI1_TX;
+    hdma_spi1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_spi1_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_spi1_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_spi1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_spi1_tx.Init.Mode = DMA_NORMAL;
+    hdma_spi1_tx.Init.Priority = DMA_PRIORITY_HIGH;
+    if (HAL_DMA_Init(&hdma_spi1_tx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(spiHandle, hdmatx, hdma_spi1_tx);
+
+    /* DMA1_Channel3/4_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+    HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+
+    /* PA15 stays in NSS alternate function, its EXTI line only reports the end of frame */
+    extiConfig.Line = EXTI_LINE_15;
+    extiConfig.Mode = EXTI_MODE_INTERRUPT;
+    extiConfig.Trigger = EXTI_TRIGGER_RISING;
+    extiConfig.GPIOSel = EXTI_GPIOA;
+    if (HAL_EXTI_SetConfigLine(&hexti_spi1_nss, &extiConfig) != HAL_OK)
+    {
+      Error_Handler();
+    }
+    HAL_NVIC_SetPriority(EXTI15_10_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+#endif
 
   /* USER CODE END SPI1_MspInit 1 */
   }
@@ -127,6 +193,15 @@ void HAL_SPI_MspDeInit(SPI_HandleTypeDef* spiHandle)
     /* SPI1 interrupt Deinit */
     HAL_NVIC_DisableIRQ(SPI1_IRQn);
   /* USER CODE BEGIN SPI1_MspDeInit 1 */
+#ifdef USE_SPI_DMA
+    /* SPI1 DMA and NSS EXTI DeInit */
+    HAL_NVIC_DisableIRQ(EXTI15_10_IRQn);
+    HAL_EXTI_ClearConfigLine(&hexti_spi1_nss);
+    HAL_DMA_DeInit(spiHandle->hdmarx);
+    HAL_DMA_DeInit(spiHandle->hdmatx);
+    HAL_NVIC_DisableIRQ(DMA1_Channel3_IRQn);
+    HAL_NVIC_DisableIRQ(DMA1_Channel4_IRQn);
+#endif
 
   /* USER CODE END SPI1_MspDeInit 1 */
   }
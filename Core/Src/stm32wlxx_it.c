@@ -22,6 +22,8 @@
 #include "stm32wlxx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "kns_os.h"
+#include "mcu_prof.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -230,10 +232,12 @@ void SysTick_Handler(void)
 void RTC_WKUP_IRQHandler(void)
 {
   /* USER CODE BEGIN RTC_WKUP_IRQn 0 */
+  MCU_PROF_START();
 
   /* USER CODE END RTC_WKUP_IRQn 0 */
   HAL_RTCEx_WakeUpTimerIRQHandler(&hrtc);
   /* USER CODE BEGIN RTC_WKUP_IRQn 1 */
+  MCU_PROF_STOP(MCU_PROF_SLOT_ISR_RTC_WKUP);
 
   /* USER CODE END RTC_WKUP_IRQn 1 */
 }
@@ -244,10 +248,12 @@ void RTC_WKUP_IRQHandler(void)
 void TIM16_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM16_IRQn 0 */
+  MCU_PROF_START();
 
   /* USER CODE END TIM16_IRQn 0 */
   HAL_TIM_IRQHandler(&htim16);
   /* USER CODE BEGIN TIM16_IRQn 1 */
+  MCU_PROF_STOP(MCU_PROF_SLOT_ISR_TIM16);
 
   /* USER CODE END TIM16_IRQn 1 */
 }
@@ -258,10 +264,12 @@ void TIM16_IRQHandler(void)
 void SPI1_IRQHandler(void)
 {
   /* USER CODE BEGIN SPI1_IRQn 0 */
+  MCU_PROF_START();
 
   /* USER CODE END SPI1_IRQn 0 */
   HAL_SPI_IRQHandler(&hspi1);
   /* USER CODE BEGIN SPI1_IRQn 1 */
+  MCU_PROF_STOP(MCU_PROF_SLOT_ISR_SPI);
 
   /* USER CODE END SPI1_IRQn 1 */
 }
@@ -272,10 +280,12 @@ void SPI1_IRQHandler(void)
 void LPUART1_IRQHandler(void)
 {
   /* USER CODE BEGIN LPUART1_IRQn 0 */
+  MCU_PROF_START();
 
   /* USER CODE END LPUART1_IRQn 0 */
   HAL_UART_IRQHandler(&hlpuart1);
   /* USER CODE BEGIN LPUART1_IRQn 1 */
+  MCU_PROF_STOP(MCU_PROF_SLOT_ISR_LPUART);
 
   /* USER CODE END LPUART1_IRQn 1 */
 }
@@ -286,14 +296,84 @@ void LPUART1_IRQHandler(void)
 void SUBGHZ_Radio_IRQHandler(void)
 {
   /* USER CODE BEGIN SUBGHZ_Radio_IRQn 0 */
+  MCU_PROF_START();
 
   /* USER CODE END SUBGHZ_Radio_IRQn 0 */
   HAL_SUBGHZ_IRQHandler(&hsubghz);
   /* USER CODE BEGIN SUBGHZ_Radio_IRQn 1 */
+  KNS_OS_setTaskReady(KNS_OS_TASK_MAC);
+  MCU_PROF_STOP(MCU_PROF_SLOT_ISR_SUBGHZ);
 
   /* USER CODE END SUBGHZ_Radio_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
+#ifdef USE_UART_DMA_RX
+extern DMA_HandleTypeDef hdma_lpuart1_rx;
+
+/**
+  * @brief This function handles DMA1 Channel 1 Interrupt (LPUART1 RX).
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  MCU_PROF_START();
+
+  HAL_DMA_IRQHandler(&hdma_lpuart1_rx);
+  MCU_PROF_STOP(MCU_PROF_SLOT_ISR_LPUART);
+}
+#endif
+
+#ifdef USE_UART_DMA_TX
+extern DMA_HandleTypeDef hdma_lpuart1_tx;
+
+/**
+  * @brief This function handles DMA1 Channel 2 Interrupt (LPUART1 TX).
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  MCU_PROF_START();
+
+  HAL_DMA_IRQHandler(&hdma_lpuart1_tx);
+  MCU_PROF_STOP(MCU_PROF_SLOT_ISR_LPUART);
+}
+#endif
+
+#ifdef USE_SPI_DMA
+extern DMA_HandleTypeDef hdma_spi1_rx;
+extern DMA_HandleTypeDef hdma_spi1_tx;
+
+/**
+  * @brief This function handles DMA1 Channel 3 Interrupt (SPI1 RX).
+  */
+void DMA1_Channel3_IRQHandler(void)
+{
+  MCU_PROF_START();
+
+  HAL_DMA_IRQHandler(&hdma_spi1_rx);
+  MCU_PROF_STOP(MCU_PROF_SLOT_ISR_SPI);
+}
+
+/**
+  * @brief This function handles DMA1 Channel 4 Interrupt (SPI1 TX).
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+  MCU_PROF_START();
+
+  HAL_DMA_IRQHandler(&hdma_spi1_tx);
+  MCU_PROF_STOP(MCU_PROF_SLOT_ISR_SPI);
+}
+
+/**
+  * @brief This function handles EXTI Lines [15:10] Interrupt (SPI1 NSS rising edge).
+  */
+void EXTI15_10_IRQHandler(void)
+{
+  MCU_PROF_START();
+
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_15);
+  MCU_PROF_STOP(MCU_PROF_SLOT_ISR_SPI);
+}
+#endif
 
 /* USER CODE END 1 */
@@ -31,6 +31,27 @@
  * * KNS_OS_TASK_MAC Kineis stack main task
  * * KNS_OS_TASK_IDLE idle tsak entering LPM when other task are not active
  *
+ * @section kns_os_sched Scheduling
+ *
+ * By default, the baremetal Kineis OS calls all registered tasks in a row, forever.
+ *
+ * With USE_KNS_OS_EVT_DRIVEN compilation flag, only ready tasks are run, highest-priority first
+ * (refer to \ref KNS_OS_taskHdlr_t order). A task is ready when:
+ * * it consumes the highest-priority non-empty queue (\ref KNS_OS_TASK_QUEUES), the flag being
+ *   raised by queue pushes. Consumers of lower-priority queues are not ready meanwhile, as
+ *   \ref KNS_Q_pop would not give them any event,
+ * * it was flagged through \ref KNS_OS_setTaskReady, typically from console RX or timer ISRs, or
+ *   by the task itself when it has some more work to do without any incoming event.
+ *
+ * IDLE task is run only when no task is ready, thus going into low power mode straight away.
+ *
+ * @section kns_os_work Deferred work
+ *
+ * ISRs should stay short, so that the SUBGHZ radio interrupt latency remains bounded. Some heavy
+ * processing (parsing, copy, logs, ...) can be deferred through \ref KNS_OS_postWork: the ISR
+ * posts a function pointer plus its context, and the scheduler runs all posted works in a row, in
+ * posting order, before running any task.
+ *
  * @section kns_os_subpages Sub-pages
  *
  * * @subpage kns_os_conf_page
@@ -60,6 +81,9 @@
 
 /* Structures ---------------------------------------------------------------------------------- */
 
+/** Deferred work function, run from main loop context */
+typedef void (*KNS_OS_work_t)(void *ctx);
+
 /* Function prototypes ------------------------------------------------------------------------- */
 
 /**
@@ -87,6 +111,48 @@ enum KNS_status_t KNS_OS_registerTask(enum KNS_OS_taskHdlr_t tskHdlr, void (*tas
  */
 void KNS_OS_main(void);
 
+/**
+ * @brief This function is used to flag a task as having something to process
+ *
+ * Task will be run once by the event-driven scheduler. This can be called from ISR context.
+ *
+ * @note Without USE_KNS_OS_EVT_DRIVEN, all tasks are run anyway and this call has no effect.
+ *
+ * @param[in] tskHdlr: task handler
+ */
+void KNS_OS_setTaskReady(enum KNS_OS_taskHdlr_t tskHdlr);
+
+/**
+ * @brief This function is used to defer some processing from ISR context to main loop context
+ *
+ * Work will be run once, before the next task is run. This can be called from ISR context.
+ *
+ * @param[in] work: function to run
+ * @param[in] ctx: context given to the function
+ * @retval KNS_STATUS_OK if posted, KNS_STATUS_QFULL if too many works are pending (caller may then
+ * run it in place)
+ */
+enum KNS_status_t KNS_OS_postWork(KNS_OS_work_t work, void *ctx);
+
+/**
+ * @brief This function is used to check some deferred work is pending
+ *
+ * @retval true if some work is posted and not run yet, false otherwise
+ */
+bool KNS_OS_isWorkPending(void);
+
+#ifdef USE_KNS_OS_EVT_DRIVEN
+/**
+ * @brief This function is used to get tasks ready to be run, IDLE task excluded
+ *
+ * This is aimed to be used by the IDLE task to check it is possible to go into low power mode,
+ * with one single call.
+ *
+ * @retval mask of ready tasks, one bit per task handler
+ */
+uint32_t KNS_OS_getReadyMask(void);
+#endif
+
 #pragma GCC visibility pop
 
 #endif /* KNS_OS_H */
@@ -16,19 +16,64 @@
 #include <stddef.h>
 
 #include "kns_os.h"
+#include "kns_q.h"
+#include "mcu_prof.h"
+#include "kns_cs.h"
 
 #pragma GCC visibility push(default)
 
 /* Defines ------------------------------------------------------------------------------------- */
 
+/** Bit of a task in ready masks */
+#define KNS_OS_TASK_MASK(tskHdlr) (1UL << (tskHdlr))
+
+_Static_assert(KNS_OS_TASK_MAX <= 32, "taskReadyMask holds one bit per task");
+_Static_assert((KNS_OS_WORK_MAX & (KNS_OS_WORK_MAX - 1)) == 0 && KNS_OS_WORK_MAX <= 128,
+	"work ring uint8_t indexes wrap around");
+
 /* Structures ---------------------------------------------------------------------------------- */
 
+/** Deferred work entry */
+struct KNS_OS_workElt_t {
+	KNS_OS_work_t work;
+	void *ctx;
+};
+
 /* Variables ----------------------------------------------------------------------------------- */
 
 void (*taskPool[KNS_OS_TASK_MAX])(void) = {NULL};
 
+/** Tasks flagged as having something to process, all tasks run once at start-up */
+static uint32_t taskReadyMask = KNS_OS_TASK_MASK(KNS_OS_TASK_MAX) - 1;
+
+#ifdef USE_KNS_OS_EVT_DRIVEN
+/** Queues consumed by each task: a task is also ready as long as one of its queues is not empty */
+static const uint32_t taskQMask[KNS_OS_TASK_MAX] = KNS_OS_TASK_QUEUES;
+#endif
+
+/** Deferred works ring, posted from ISRs, run from main loop */
+static struct KNS_OS_workElt_t workRing[KNS_OS_WORK_MAX];
+static volatile uint8_t workRIdx;
+static volatile uint8_t workWIdx;
+
 /* Local functions ----------------------------------------------------------------------------- */
 
+/**
+ * @brief Run all deferred works, including the ones posted meanwhile
+ */
+static void KNS_OS_runWork(void)
+{
+	struct KNS_OS_workElt_t elt;
+
+	while (workRIdx != workWIdx) {
+		KNS_CS_enter();
+		elt = workRing[workRIdx % KNS_OS_WORK_MAX];
+		workRIdx++;
+		KNS_CS_exit();
+		elt.work(elt.ctx);
+	}
+}
+
 /* Function prototypes ------------------------------------------------------------------------- */
 
 enum KNS_status_t KNS_OS_registerTask(enum KNS_OS_taskHdlr_t tskHdlr, void (*taskFctPtr)(void))
@@ -41,17 +86,103 @@ enum KNS_status_t KNS_OS_registerTask(enum KNS_OS_taskHdlr_t tskHdlr, void (*tas
 }
 
 
+void KNS_OS_setTaskReady(enum KNS_OS_taskHdlr_t tskHdlr)
+{
+	__atomic_fetch_or(&taskReadyMask, KNS_OS_TASK_MASK(tskHdlr), __ATOMIC_RELEASE);
+}
+
+enum KNS_status_t KNS_OS_postWork(KNS_OS_work_t work, void *ctx)
+{
+	enum KNS_status_t status = KNS_STATUS_QFULL;
+
+	if (work == NULL)
+		return KNS_STATUS_ERROR;
+
+	/** ISRs of different priorities may post concurrently */
+	KNS_CS_enter();
+	if ((uint8_t)(workWIdx - workRIdx) < KNS_OS_WORK_MAX) {
+		workRing[workWIdx % KNS_OS_WORK_MAX].work = work;
+		workRing[workWIdx % KNS_OS_WORK_MAX].ctx = ctx;
+		workWIdx++;
+		status = KNS_STATUS_OK;
+	}
+	KNS_CS_exit();
+
+	return status;
+}
+
+bool KNS_OS_isWorkPending(void)
+{
+	return (workRIdx != workWIdx);
+}
+
+#ifdef USE_KNS_OS_EVT_DRIVEN
+uint32_t KNS_OS_getReadyMask(void)
+{
+	uint32_t readyMask = __atomic_load_n(&taskReadyMask, __ATOMIC_ACQUIRE);
+	uint32_t qMask = KNS_Q_getEvtMask();
+	uint8_t idx;
+
+	/** KNS_Q_pop() only serves the highest-priority non-empty queue (highest index), so only
+	 * its consumer can make progress. Making the consumer of a lower-priority queue ready would
+	 * have it spin on QEMPTY and starve the task which has to drain the higher-priority queue.
+	 */
+	if (qMask != 0)
+		qMask = 1UL << (31 - __builtin_clz(qMask));
+
+	for (idx = 0; idx < KNS_OS_TASK_MAX; idx++) {
+		if (qMask & taskQMask[idx])
+			readyMask |= KNS_OS_TASK_MASK(idx);
+	}
+
+	return readyMask & ~KNS_OS_TASK_MASK(KNS_OS_TASK_IDLE);
+}
+
+void KNS_OS_main(void)
+{
+	int8_t idx;
+	uint32_t readyMask;
+
+	while (1) {
+		KNS_OS_runWork();
+
+		/** Run the highest-priority ready task, then re-evaluate as running it may have made
+		 * some higher-priority task ready. IDLE task only runs when no other task is ready.
+		 */
+		readyMask = KNS_OS_getReadyMask();
+		for (idx = KNS_OS_TASK_MAX - 1; idx >= 0; idx--) {
+			if (readyMask & KNS_OS_TASK_MASK(idx))
+				break;
+		}
+		if (idx < 0)
+			idx = KNS_OS_TASK_IDLE;
+
+		/** Flag is cleared before running, so that events raised meanwhile are not lost */
+		__atomic_fetch_and(&taskReadyMask, ~KNS_OS_TASK_MASK(idx), __ATOMIC_ACQ_REL);
+		if (taskPool[idx] != NULL) {
+			MCU_PROF_START();
+			taskPool[idx]();
+			MCU_PROF_STOP(idx);
+		}
+	}
+}
+#else
 void KNS_OS_main(void)
 {
 	uint8_t idx;
 
 	while (1) {
 		for (idx = 0; idx < KNS_OS_TASK_MAX; idx++) {
-			if (taskPool[idx] != NULL)
+			KNS_OS_runWork();
+			if (taskPool[idx] != NULL) {
+				MCU_PROF_START();
 				taskPool[idx]();
+				MCU_PROF_STOP(idx);
+			}
 		}
 	}
 }
+#endif
 
 #pragma GCC visibility pop
 
@@ -44,6 +44,16 @@
  * @attention due to simple FIFO-full mechanism implemented so far, queues needs to be one element
  * longer than expected by the system, in case of baremetaol Kineis OS.
  *
+ * In case of baremetal Kineis OS, a queue can be declared single-producer/single-consumer (isSpsc
+ * in \ref q_desc_t). Such queue is lock-free: each side only writes its own index, element is
+ * copied before the index is published, and IRQs are never masked. Other queues keep a critical
+ * section around the copy.
+ *
+ * A single-producer/single-consumer queue can also be declared variable-length (codec in
+ * \ref q_desc_t). Elements are still pushed and popped as full structures, but are stored packed
+ * in a byte ring, behind a length tag. This saves RAM on queues whose largest event is far longer
+ * than the usual ones (e.g. MAC2APP in HDA4).
+ *
  * A priority is assigned to those queues, meaning some event in higher-priority queue should be
  * executed before lower-priority queue's events (refer to kineis_sw architecture for details).
  *
@@ -67,8 +77,43 @@
 
 #pragma GCC visibility push(default)
 
+/* Defines ------------------------------------------------------------------------------------- */
+
+#ifdef USE_BAREMETAL
+/** Bit of a queue in the non-empty queue mask (\ref KNS_Q_getEvtMask) */
+#define KNS_Q_EVT_MASK(qHandle) (1UL << (qHandle))
+#endif
+
 /* Structures ---------------------------------------------------------------------------------- */
 
+#ifdef USE_BAREMETAL
+/**
+ * @struct KNS_Q_stats_t
+ * @brief Usage statistics of a queue, aimed at sizing KNS_Q_*_LEN from field data
+ *
+ * Counters are cumulated since boot or since last KNS_Q_resetStats.
+ */
+struct KNS_Q_stats_t {
+	uint32_t pushCnt;        /**< number of elements pushed or committed */
+	uint32_t popCnt;         /**< number of elements popped or released */
+	uint32_t qfullCnt;       /**< number of push or reserve rejected as queue was full */
+	uint32_t maxResidenceMs; /**< longest time an element stayed in queue, in ms */
+	uint8_t capacity;        /**< max number of elements queue can hold */
+	uint8_t depth;           /**< number of elements currently in queue */
+	uint8_t hwm;             /**< high-water mark, max number of elements seen in queue */
+};
+#endif
+
+/* Variables ----------------------------------------------------------------------------------- */
+
+#ifdef USE_BAREMETAL
+/** Non-empty queue mask, one bit per queue handle (KNS_Q_EVT_MASK). Bit is set once an element is
+ * published in the queue and cleared once the queue is empty again.
+ * @attention read only, use KNS_Q_getEvtMask
+ */
+extern uint32_t qEvtMask;
+#endif
+
 /* Function prototypes ------------------------------------------------------------------------- */
 
 /**
@@ -131,6 +176,76 @@ enum KNS_status_t KNS_Q_push(enum KNS_Q_handle_t qHandle, void *qItem);
 enum KNS_status_t KNS_Q_pop(enum KNS_Q_handle_t qHandle, void *qItem);
 
 #ifdef USE_BAREMETAL
+/**
+ * @brief This function is used to get the next free slot of a queue, to be filled-up in place
+ *
+ * The producer writes the element directly into the returned slot, then calls KNS_Q_commit to
+ * make it visible to the consumer. This avoids building the element on the stack before copying it
+ * into the queue.
+ *
+ * @attention Only available on single-producer/single-consumer queues (isSpsc). Only one slot can
+ * be reserved at a time, and no KNS_Q_push can occur on the same queue until it is committed.
+ *
+ * @note On variable-length queues, the slot is a producer scratch element packed into the queue at
+ * commit time, and reserve fails as long as an element of maximum length does not fit.
+ *
+ * @param[in] qHandle: queue handle
+ * @param[out] qItem: pointer to the reserved slot, NULL if queue is full
+ * @retval KNS_STATUS_OK if slot is reserved, KNS_STATUS_QFULL if no more place in queue,
+ * KNS_STATUS_BAD_SETTING if queue is not single-producer/single-consumer.
+ */
+enum KNS_status_t KNS_Q_reserve(enum KNS_Q_handle_t qHandle, void **qItem);
+
+/**
+ * @brief This function is used to publish the slot previously reserved with KNS_Q_reserve
+ *
+ * @param[in] qHandle: queue handle
+ * @retval KNS_STATUS_OK, KNS_STATUS_BAD_SETTING if queue is not single-producer/single-consumer.
+ */
+enum KNS_status_t KNS_Q_commit(enum KNS_Q_handle_t qHandle);
+
+/**
+ * @brief This function is used to read next element of a queue in place, without removing it
+ *
+ * The consumer reads the element directly from the queue slot, then calls KNS_Q_release to free
+ * it. Same priority rule as KNS_Q_pop applies.
+ *
+ * @attention Only available on single-producer/single-consumer queues (isSpsc).
+ *
+ * @note On variable-length queues, the element is unpacked into a consumer scratch element, thus
+ * it stays valid while the producer reserves and commits.
+ *
+ * @param[in] qHandle: queue handle
+ * @param[out] qItem: pointer to the element, NULL if queue is empty
+ * @retval KNS_STATUS_OK if some element was found, KNS_STATUS_QEMPTY if no element present in
+ * queue, KNS_STATUS_BAD_SETTING if queue is not single-producer/single-consumer.
+ */
+enum KNS_status_t KNS_Q_peek(enum KNS_Q_handle_t qHandle, void **qItem);
+
+/**
+ * @brief This function is used to free the element previously read with KNS_Q_peek
+ *
+ * @param[in] qHandle: queue handle
+ * @retval KNS_STATUS_OK, KNS_STATUS_BAD_SETTING if queue is not single-producer/single-consumer.
+ */
+enum KNS_status_t KNS_Q_release(enum KNS_Q_handle_t qHandle);
+
+/**
+ * @brief This function is used to get usage statistics of a queue
+ *
+ * @param[in] qHandle: queue handle
+ * @param[out] stats: statistics of the queue
+ * @retval KNS_STATUS_OK, KNS_STATUS_BAD_SETTING if queue handle is unknown.
+ */
+enum KNS_status_t KNS_Q_getStats(enum KNS_Q_handle_t qHandle, struct KNS_Q_stats_t *stats);
+
+/**
+ * @brief This function is used to clear usage statistics of all queues
+ *
+ * Current depth is not affected as it reflects queue content.
+ */
+void KNS_Q_resetStats(void);
+
 /**
  * @brief This function is used to check some higher-priority queue contains elements, meaning
  * preemption is required.
@@ -152,6 +267,19 @@ bool KNS_Q_isEvtInHigherPrioQ(enum KNS_Q_handle_t qHandle);
  * @retval true if some element present in higher priority queue, false otherwise.
  */
 bool KNS_Q_isEvtInSomeQ(void);
+
+/**
+ * @brief This function is used to get the non-empty queue mask
+ *
+ * As queues are sorted by priority, bits are sorted the same way. This is aimed to be used by the
+ * scheduler or the low power manager to check pending events with one single read.
+ *
+ * @retval mask of non-empty queues, see KNS_Q_EVT_MASK
+ */
+static inline uint32_t KNS_Q_getEvtMask(void)
+{
+	return __atomic_load_n(&qEvtMask, __ATOMIC_ACQUIRE);
+}
 #endif
 
 #pragma GCC visibility pop
@@ -19,22 +19,115 @@
 
 /* Includes ------------------------------------------------------------------------------------ */
 
+#include <string.h>
 #include "kns_cs.h"
 #include "kns_q_conf.h"
 #include "kns_q.h"
+#include "kineis_sw_conf.h"
+#include KINEIS_SW_ASSERT_H
 
 //#undef VERBOSE
 #include "mgr_log.h"
 
 #pragma GCC visibility push(default)
 
+/* Defines ------------------------------------------------------------------------------------- */
+
+/** Read/write indexes are shared between producer and consumer contexts. Publication is done with
+ * release semantic so that the element content is visible before the index moves, and reading is
+ * done with acquire semantic so that element content is not read before the index is seen.
+ */
+#define KNS_Q_LOAD_IDX(idx)       __atomic_load_n(&(idx), __ATOMIC_ACQUIRE)
+#define KNS_Q_STORE_IDX(idx, val) __atomic_store_n(&(idx), (val), __ATOMIC_RELEASE)
+
+/** Variable-length queues: length tag stored before each element, and tag value telling the rest
+ * of the ring is unused and next element is at the start of the ring.
+ */
+#define KNS_Q_VAR_TAG_SIZE      sizeof(uint16_t)
+#define KNS_Q_VAR_TAG_WRAP      0xFFFF
+/** Byte size of an element stored in a variable-length queue, kept 16-bit aligned */
+#define KNS_Q_VAR_ELT_SIZE(len) (KNS_Q_VAR_TAG_SIZE + (((len) + 1U) & ~1U))
+
+_Static_assert(KNS_Q_MAX <= 32, "qEvtMask holds one bit per queue");
 
 /* Variables ----------------------------------------------------------------------------------- */
 
 extern struct q_desc_t *qPool[KNS_Q_MAX];
 
+uint32_t qEvtMask = 0;
+
+/** Usage statistics, one per queue. Producer-side counters are only written by the producer and
+ * consumer-side ones by the consumer, the same way as queue indexes.
+ */
+static struct KNS_Q_stats_t qStats[KNS_Q_MAX];
+
 /* Local functions ----------------------------------------------------------------------------- */
 
+/**
+ * @brief Flag queue as containing some element, to be called once write index is published
+ * @param[in] qHandle: queue handle
+ */
+static inline void KNS_Q_setEvtMask(enum KNS_Q_handle_t qHandle)
+{
+	__atomic_fetch_or(&qEvtMask, KNS_Q_EVT_MASK(qHandle), __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Clear queue flag if the queue is now empty, to be called once read index is published
+ *
+ * Flag is cleared first and queue is checked again, so that an element published by the producer
+ * in the meantime is never hidden.
+ *
+ * @param[in] q: queue descriptor
+ * @param[in] qHandle: queue handle
+ */
+static inline void KNS_Q_clearEvtMaskIfEmpty(struct q_desc_t *q, enum KNS_Q_handle_t qHandle)
+{
+	if (q->rIdx != KNS_Q_LOAD_IDX(q->wIdx))
+		return;
+	__atomic_fetch_and(&qEvtMask, ~KNS_Q_EVT_MASK(qHandle), __ATOMIC_ACQ_REL);
+	if (q->rIdx != KNS_Q_LOAD_IDX(q->wIdx))
+		KNS_Q_setEvtMask(qHandle);
+}
+
+/**
+ * @brief Get number of elements currently in queue
+ * @param[in] q: queue descriptor
+ * @retval number of elements
+ */
+static inline uint8_t KNS_Q_getDepth(struct q_desc_t *q)
+{
+	return (KNS_Q_LOAD_IDX(q->wIdx) + q->nbElt - KNS_Q_LOAD_IDX(q->rIdx)) % q->nbElt;
+}
+
+/**
+ * @brief Update statistics once an element is published in the queue
+ * @param[in] q: queue descriptor
+ * @param[in] qHandle: queue handle
+ */
+static void KNS_Q_statsPushed(struct q_desc_t *q, enum KNS_Q_handle_t qHandle)
+{
+	uint8_t depth = KNS_Q_getDepth(q);
+
+	qStats[qHandle].pushCnt++;
+	if (depth > qStats[qHandle].hwm)
+		qStats[qHandle].hwm = depth;
+}
+
+/**
+ * @brief Update statistics when an element is about to leave the queue
+ * @param[in] q: queue descriptor
+ * @param[in] qHandle: queue handle
+ */
+static void KNS_Q_statsPopped(struct q_desc_t *q, enum KNS_Q_handle_t qHandle)
+{
+	uint32_t residenceMs = KNS_Q_getTickMs() - q->eltTick[q->rIdx];
+
+	qStats[qHandle].popCnt++;
+	if (residenceMs > qStats[qHandle].maxResidenceMs)
+		qStats[qHandle].maxResidenceMs = residenceMs;
+}
+
 /**
  * @brief  Log array of uint8_t
  * @param[in] data: pointer to table
@@ -49,6 +142,265 @@ static void MGR_LOG_VERBOSE_array(__attribute__((unused)) uint8_t *data, uint16_
 	MGR_LOG_VERBOSE_RAW("\r\n");
 }
 
+/**
+ * @brief Find where to store an element in a variable-length queue
+ *
+ * Element is stored at write offset if it fits before the end of the ring, otherwise at the start
+ * of the ring, leaving a wrap tag at write offset. As an empty queue has rOff equal to wOff, any
+ * element up to half of the ring always fits into an empty queue.
+ *
+ * @param[in] q: queue descriptor
+ * @param[in] eltSize: byte size of the stored element, length tag included
+ * @retval byte offset where to store the element, -1 if not enough room
+ */
+static int32_t KNS_Q_varFindOff(struct q_desc_t *q, uint16_t eltSize)
+{
+	uint16_t wOff = q->wOff;
+	uint16_t rOff;
+	bool isEmpty;
+
+	/** rIdx is read before rOff as the consumer publishes them the other way round */
+	isEmpty = (KNS_Q_LOAD_IDX(q->rIdx) == q->wIdx);
+	rOff = KNS_Q_LOAD_IDX(q->rOff);
+
+	if ((wOff == rOff) && !isEmpty)
+		return -1;
+	if (wOff >= rOff) {
+		if (eltSize <= q->ringSize - wOff)
+			return wOff;
+		if (eltSize <= rOff)
+			return 0;
+		return -1;
+	}
+	if (eltSize <= rOff - wOff)
+		return wOff;
+	return -1;
+}
+
+/**
+ * @brief Pack an element into a variable-length queue, without publishing it
+ *
+ * @param[in] q: queue descriptor
+ * @param[in] qItem: pointer to queue element
+ * @retval true if element was written, false if not enough room
+ */
+static bool KNS_Q_varWrite(struct q_desc_t *q, const void *qItem)
+{
+	uint16_t len = q->codec->eltLen(qItem);
+	uint16_t tag = KNS_Q_VAR_TAG_WRAP;
+	int32_t off = KNS_Q_varFindOff(q, KNS_Q_VAR_ELT_SIZE(len));
+
+	if (off < 0)
+		return false;
+
+	if (off != q->wOff)
+		memcpy(q->data + q->wOff, &tag, KNS_Q_VAR_TAG_SIZE);
+	memcpy(q->data + off, &len, KNS_Q_VAR_TAG_SIZE);
+	q->codec->eltPack(q->data + off + KNS_Q_VAR_TAG_SIZE, qItem);
+
+	off += KNS_Q_VAR_ELT_SIZE(len);
+	q->wOff = (off == q->ringSize) ? 0 : off;
+
+	return true;
+}
+
+/**
+ * @brief Get byte offset and packed length of the oldest element of a variable-length queue
+ *
+ * @param[in] q: queue descriptor
+ * @param[out] len: packed length of the element
+ * @retval byte offset of the element (length tag)
+ */
+static uint16_t KNS_Q_varReadOff(struct q_desc_t *q, uint16_t *len)
+{
+	uint16_t off = q->rOff;
+
+	memcpy(len, q->data + off, KNS_Q_VAR_TAG_SIZE);
+	if (*len == KNS_Q_VAR_TAG_WRAP) {
+		off = 0;
+		memcpy(len, q->data, KNS_Q_VAR_TAG_SIZE);
+	}
+
+	return off;
+}
+
+/**
+ * @brief Unpack the oldest element of a variable-length queue, without removing it
+ *
+ * @param[in] q: queue descriptor
+ * @param[out] qItem: pointer to queue element
+ */
+static void KNS_Q_varRead(struct q_desc_t *q, void *qItem)
+{
+	uint16_t len;
+	uint16_t off = KNS_Q_varReadOff(q, &len);
+
+	q->codec->eltUnpack(qItem, q->data + off + KNS_Q_VAR_TAG_SIZE);
+}
+
+/**
+ * @brief Check a single-producer/single-consumer queue has no more free element
+ *
+ * @param[in] q: queue descriptor
+ * @retval true if queue is full
+ */
+static inline bool KNS_Q_isFullSpsc(struct q_desc_t *q)
+{
+	return (((q->wIdx + 1) % q->nbElt) == KNS_Q_LOAD_IDX(q->rIdx));
+}
+
+/**
+ * @brief Get the next free slot of a single-producer/single-consumer queue
+ *
+ * In case of variable-length queue, the producer scratch element is returned once there is enough
+ * room for an element of maximum length, as the actual packed length is only known at commit time.
+ *
+ * @param[in] q: queue descriptor
+ * @retval pointer to the slot, NULL if queue is full
+ */
+static uint8_t *KNS_Q_reserveSpsc(struct q_desc_t *q)
+{
+	if (KNS_Q_isFullSpsc(q))
+		return NULL;
+
+	if (q->codec != NULL) {
+		if (KNS_Q_varFindOff(q, KNS_Q_VAR_ELT_SIZE(q->eltSize)) < 0)
+			return NULL;
+		return q->wScratch;
+	}
+
+	return q->data + q->eltSize * q->wIdx;
+}
+
+/**
+ * @brief Publish the element written at write index of a single-producer/single-consumer queue
+ *
+ * Only the producer writes wIdx and only the consumer writes rIdx. Thus no critical section is
+ * needed: element is written first, then the new write index is published.
+ *
+ * @param[in] q: queue descriptor
+ * @param[in] qHandle: queue handle
+ */
+static void KNS_Q_publishSpsc(struct q_desc_t *q, enum KNS_Q_handle_t qHandle)
+{
+	q->eltTick[q->wIdx] = KNS_Q_getTickMs();
+	KNS_Q_STORE_IDX(q->wIdx, (q->wIdx + 1) % q->nbElt);
+	KNS_Q_setEvtMask(qHandle);
+	KNS_Q_statsPushed(q, qHandle);
+}
+
+/**
+ * @brief Publish the slot previously reserved in a single-producer/single-consumer queue
+ *
+ * @param[in] q: queue descriptor
+ * @param[in] qHandle: queue handle
+ */
+static void KNS_Q_commitSpsc(struct q_desc_t *q, enum KNS_Q_handle_t qHandle)
+{
+	bool isWritten;
+
+	if (q->codec != NULL) {
+		/** Room for an element of maximum length was checked at reserve time */
+		isWritten = KNS_Q_varWrite(q, q->wScratch);
+		kns_assert(isWritten);
+	}
+	KNS_Q_publishSpsc(q, qHandle);
+}
+
+/**
+ * @brief Get the oldest element of a single-producer/single-consumer queue, without removing it
+ *
+ * In case of variable-length queue, element is unpacked into the consumer scratch element.
+ *
+ * @param[in] q: queue descriptor
+ * @retval pointer to the slot, NULL if queue is empty
+ */
+static uint8_t *KNS_Q_peekSpsc(struct q_desc_t *q)
+{
+	uint8_t rIdx = q->rIdx;
+
+	if (rIdx == KNS_Q_LOAD_IDX(q->wIdx))
+		return NULL;
+
+	if (q->codec != NULL) {
+		KNS_Q_varRead(q, q->rScratch);
+		return q->rScratch;
+	}
+
+	return q->data + q->eltSize * rIdx;
+}
+
+/**
+ * @brief Free the slot previously peeked in a single-producer/single-consumer queue
+ *
+ * @param[in] q: queue descriptor
+ * @param[in] qHandle: queue handle
+ */
+static void KNS_Q_releaseSpsc(struct q_desc_t *q, enum KNS_Q_handle_t qHandle)
+{
+	uint16_t len;
+	uint16_t off;
+
+	KNS_Q_statsPopped(q, qHandle);
+	if (q->codec != NULL) {
+		off = KNS_Q_varReadOff(q, &len) + KNS_Q_VAR_ELT_SIZE(len);
+		KNS_Q_STORE_IDX(q->rOff, (off == q->ringSize) ? 0 : off);
+	}
+	KNS_Q_STORE_IDX(q->rIdx, (q->rIdx + 1) % q->nbElt);
+	KNS_Q_clearEvtMaskIfEmpty(q, qHandle);
+}
+
+/**
+ * @brief Lock-free push used on single-producer/single-consumer queues
+ *
+ * @param[in] q: queue descriptor
+ * @param[in] qHandle: queue handle
+ * @param[in] qItem: pointer to queue element
+ * @retval KNS_STATUS_OK if element was added, KNS_STATUS_QFULL if no more place in queue
+ */
+static enum KNS_status_t KNS_Q_pushSpsc(struct q_desc_t *q, enum KNS_Q_handle_t qHandle,
+	void *qItem)
+{
+	bool isWritten = !KNS_Q_isFullSpsc(q);
+
+	if (isWritten) {
+		if (q->codec != NULL)
+			isWritten = KNS_Q_varWrite(q, qItem);
+		else
+			memcpy(q->data + q->eltSize * q->wIdx, qItem, q->eltSize);
+	}
+	if (!isWritten) {
+		qStats[qHandle].qfullCnt++;
+		return KNS_STATUS_QFULL;
+	}
+	KNS_Q_publishSpsc(q, qHandle);
+
+	return KNS_STATUS_OK;
+}
+
+/**
+ * @brief Lock-free pop used on single-producer/single-consumer queues
+ *
+ * @param[in] q: queue descriptor
+ * @param[in] qHandle: queue handle
+ * @param[out] qItem: pointer to queue element
+ * @retval KNS_STATUS_OK if some element was found, KNS_STATUS_QEMPTY otherwise
+ */
+static enum KNS_status_t KNS_Q_popSpsc(struct q_desc_t *q, enum KNS_Q_handle_t qHandle,
+	void *qItem)
+{
+	if (q->rIdx == KNS_Q_LOAD_IDX(q->wIdx))
+		return KNS_STATUS_QEMPTY;
+
+	if (q->codec != NULL)
+		KNS_Q_varRead(q, qItem);
+	else
+		memcpy(qItem, q->data + q->eltSize * q->rIdx, q->eltSize);
+	KNS_Q_releaseSpsc(q, qHandle);
+
+	return KNS_STATUS_OK;
+}
+
 /* Function prototypes ------------------------------------------------------------------------- */
 
 #ifndef UNIT_TEST
@@ -62,6 +414,8 @@ enum KNS_status_t KNS_Q_create(enum KNS_Q_handle_t qHandle, uint8_t qLength, uin
 		return KNS_STATUS_BAD_SETTING;
 	if (qEltByteSize != q->eltSize)
 		return KNS_STATUS_BAD_SETTING;
+	if ((q->codec != NULL) && !q->isSpsc)
+		return KNS_STATUS_BAD_SETTING;
 	return KNS_STATUS_OK;
 }
 
@@ -70,13 +424,25 @@ __attribute((__weak__))
 #endif
 enum KNS_status_t KNS_Q_push(enum KNS_Q_handle_t qHandle, void *qItem)
 {
-	uint16_t eltIdx;
 	uint8_t wIdxNext;
-	uint8_t *qEltPtr, *qItemPtr;
+	uint8_t wIdxPrev;
+	uint8_t *qEltPtr;
+	enum KNS_status_t status;
 	struct q_desc_t *q = qPool[qHandle];
-#ifdef DEBUG
-	uint8_t wIdxPrev = q->wIdx;
-#endif
+
+	if (q->isSpsc) {
+		wIdxPrev = q->wIdx;
+		status = KNS_Q_pushSpsc(q, qHandle, qItem);
+		if (status != KNS_STATUS_OK) {
+			MGR_LOG_DEBUG("[KNS_Q] push QFULL %s, idx %d, evt=0x%x\r\n",
+				qIdx2Str[qHandle], wIdxPrev, ((uint8_t *)qItem)[0]);
+			return status;
+		}
+		MGR_LOG_VERBOSE("[KNS_Q] push q %s, idx %d, size %d: ", qIdx2Str[qHandle],
+			wIdxPrev, q->eltSize);
+		MGR_LOG_VERBOSE_array(qItem, q->eltSize);
+		return KNS_STATUS_OK;
+	}
 
 	/** Get queue's mutex to write into FIFO
 	 */
@@ -89,8 +455,10 @@ enum KNS_status_t KNS_Q_push(enum KNS_Q_handle_t qHandle, void *qItem)
 	/** Check FIFO full, @note, with this mechanism, there is always one empty element before
 	 *  FIFO full
 	 */
-	wIdxNext = (q->wIdx  + 1) % q->nbElt;
+	wIdxPrev = q->wIdx;
+	wIdxNext = (wIdxPrev + 1) % q->nbElt;
 	if (wIdxNext == q->rIdx) {
+		qStats[qHandle].qfullCnt++;
 		q->mutex = false;
 		KNS_CS_exit();
 		MGR_LOG_DEBUG("[KNS_Q] push QFULL %s, idx %d, evt=0x%x\r\n", qIdx2Str[qHandle],
@@ -98,12 +466,13 @@ enum KNS_status_t KNS_Q_push(enum KNS_Q_handle_t qHandle, void *qItem)
 		return KNS_STATUS_QFULL;
 	}
 
-	qEltPtr = q->data + q->eltSize * q->wIdx;
-	qItemPtr = (uint8_t *)qItem;
-	for (eltIdx = 0; eltIdx < q->eltSize; eltIdx++)
-		qEltPtr[eltIdx] = qItemPtr[eltIdx];
+	qEltPtr = q->data + q->eltSize * wIdxPrev;
+	memcpy(qEltPtr, qItem, q->eltSize);
+	q->eltTick[wIdxPrev] = KNS_Q_getTickMs();
 
-	q->wIdx = wIdxNext;
+	KNS_Q_STORE_IDX(q->wIdx, wIdxNext);
+	KNS_Q_setEvtMask(qHandle);
+	KNS_Q_statsPushed(q, qHandle);
 
 	q->mutex = false;
 	KNS_CS_exit();
@@ -120,8 +489,7 @@ __attribute((__weak__))
 #endif
 enum KNS_status_t KNS_Q_pop(enum KNS_Q_handle_t qHandle, void *qItem)
 {
-	uint16_t eltIdx;
-	uint8_t *qEltPtr, *qItemPtr;
+	uint8_t *qEltPtr;
 	struct q_desc_t *q = qPool[qHandle];
 #if (defined(VERBOSE))
 	uint8_t rIdxPrev __attribute__((unused)) = q->rIdx;
@@ -133,6 +501,13 @@ enum KNS_status_t KNS_Q_pop(enum KNS_Q_handle_t qHandle, void *qItem)
 	if (KNS_Q_isEvtInHigherPrioQ(qHandle))
 		return KNS_STATUS_QEMPTY;
 
+	if (q->isSpsc) {
+		if (KNS_Q_popSpsc(q, qHandle, qItem) != KNS_STATUS_OK)
+			return KNS_STATUS_QEMPTY;
+		MGR_LOG_VERBOSE("[KNS_Q] pop  q %s, idx %d\r\n", qIdx2Str[qHandle], rIdxPrev);
+		return KNS_STATUS_OK;
+	}
+
 	/** Get queue's mutex to update read pointer of the FIFO
 	 */
 	KNS_CS_enter();
@@ -151,11 +526,11 @@ enum KNS_status_t KNS_Q_pop(enum KNS_Q_handle_t qHandle, void *qItem)
 	}
 
 	qEltPtr = q->data + q->eltSize * q->rIdx;
-	qItemPtr = (uint8_t *)qItem;
-	for (eltIdx = 0; eltIdx < q->eltSize; eltIdx++)
-		qItemPtr[eltIdx] = qEltPtr[eltIdx];
+	memcpy(qItem, qEltPtr, q->eltSize);
+	KNS_Q_statsPopped(q, qHandle);
 
-	q->rIdx = (q->rIdx  + 1) % q->nbElt;
+	KNS_Q_STORE_IDX(q->rIdx, (q->rIdx  + 1) % q->nbElt);
+	KNS_Q_clearEvtMaskIfEmpty(q, qHandle);
 
 	q->mutex = false;
 	KNS_CS_exit();
@@ -165,40 +540,117 @@ enum KNS_status_t KNS_Q_pop(enum KNS_Q_handle_t qHandle, void *qItem)
 	return KNS_STATUS_OK;
 }
 
-bool KNS_Q_isEvtInHigherPrioQ(enum KNS_Q_handle_t qHandle)
+enum KNS_status_t KNS_Q_reserve(enum KNS_Q_handle_t qHandle, void **qItem)
 {
-	struct q_desc_t *q;
-	enum KNS_Q_handle_t qHandleTmp;
-
-	for (qHandleTmp = qHandle + 1; qHandleTmp <  KNS_Q_MAX; qHandleTmp++) {
-		q = qPool[qHandleTmp];
-		if (q->rIdx != q->wIdx) {
-			MGR_LOG_VERBOSE("[KNS_Q] higher-prio check q %s, evt found in q %s\r\n",
-				qIdx2Str[qHandle], qIdx2Str[qHandleTmp]);
-			return true;
-		}
+	struct q_desc_t *q = qPool[qHandle];
+
+	if (!q->isSpsc)
+		return KNS_STATUS_BAD_SETTING;
+
+	*qItem = KNS_Q_reserveSpsc(q);
+	if (*qItem == NULL) {
+		qStats[qHandle].qfullCnt++;
+		MGR_LOG_DEBUG("[KNS_Q] reserve QFULL %s\r\n", qIdx2Str[qHandle]);
+		return KNS_STATUS_QFULL;
 	}
 
-	return false;
+	return KNS_STATUS_OK;
 }
 
-bool KNS_Q_isEvtInSomeQ()
+enum KNS_status_t KNS_Q_commit(enum KNS_Q_handle_t qHandle)
+{
+	struct q_desc_t *q = qPool[qHandle];
+
+	if (!q->isSpsc)
+		return KNS_STATUS_BAD_SETTING;
+
+	MGR_LOG_VERBOSE("[KNS_Q] commit q %s, idx %d, size %d: ", qIdx2Str[qHandle],
+		q->wIdx, q->eltSize);
+	MGR_LOG_VERBOSE_array((q->codec != NULL) ? q->wScratch : q->data + q->eltSize * q->wIdx,
+		q->eltSize);
+
+	KNS_Q_commitSpsc(q, qHandle);
+
+	return KNS_STATUS_OK;
+}
+
+enum KNS_status_t KNS_Q_peek(enum KNS_Q_handle_t qHandle, void **qItem)
+{
+	struct q_desc_t *q = qPool[qHandle];
+
+	*qItem = NULL;
+
+	if (!q->isSpsc)
+		return KNS_STATUS_BAD_SETTING;
+
+	/** Same priority rule as KNS_Q_pop */
+	if (KNS_Q_isEvtInHigherPrioQ(qHandle))
+		return KNS_STATUS_QEMPTY;
+
+	*qItem = KNS_Q_peekSpsc(q);
+	if (*qItem == NULL)
+		return KNS_STATUS_QEMPTY;
+
+	return KNS_STATUS_OK;
+}
+
+enum KNS_status_t KNS_Q_release(enum KNS_Q_handle_t qHandle)
+{
+	struct q_desc_t *q = qPool[qHandle];
+
+	if (!q->isSpsc)
+		return KNS_STATUS_BAD_SETTING;
+
+	MGR_LOG_VERBOSE("[KNS_Q] release q %s, idx %d\r\n", qIdx2Str[qHandle], q->rIdx);
+
+	KNS_Q_releaseSpsc(q, qHandle);
+
+	return KNS_STATUS_OK;
+}
+
+enum KNS_status_t KNS_Q_getStats(enum KNS_Q_handle_t qHandle, struct KNS_Q_stats_t *stats)
 {
 	struct q_desc_t *q;
-	enum KNS_Q_handle_t qHandleTmp;
-
-	for (qHandleTmp = 0; qHandleTmp <  KNS_Q_MAX; qHandleTmp++) {
-		q = qPool[qHandleTmp];
-		if (q->rIdx != q->wIdx) {
-			MGR_LOG_VERBOSE("[KNS_Q] some-Q check, evt found in q %s\r\n",
-				qIdx2Str[qHandleTmp]);
-			return true;
-		}
+
+	if (qHandle >= KNS_Q_MAX)
+		return KNS_STATUS_BAD_SETTING;
+	q = qPool[qHandle];
+
+	/** Non-SPSC queues are updated from ISRs, take a consistent snapshot */
+	KNS_CS_enter();
+	*stats = qStats[qHandle];
+	stats->depth = KNS_Q_getDepth(q);
+	KNS_CS_exit();
+	stats->capacity = q->nbElt - 1;
+
+	return KNS_STATUS_OK;
+}
+
+void KNS_Q_resetStats(void)
+{
+	KNS_CS_enter();
+	memset(qStats, 0, sizeof(qStats));
+	KNS_CS_exit();
+}
+
+bool KNS_Q_isEvtInHigherPrioQ(enum KNS_Q_handle_t qHandle)
+{
+	uint32_t mask = KNS_Q_getEvtMask() & ~((KNS_Q_EVT_MASK(qHandle) << 1) - 1);
+
+	if (mask != 0) {
+		MGR_LOG_VERBOSE("[KNS_Q] higher-prio check q %s, evt mask 0x%x\r\n",
+			qIdx2Str[qHandle], mask);
+		return true;
 	}
 
 	return false;
 }
 
+bool KNS_Q_isEvtInSomeQ()
+{
+	return (KNS_Q_getEvtMask() != 0);
+}
+
 #pragma GCC visibility pop
 
 #endif /* KNS_Q_BAREMETAL_C */
@@ -33,6 +33,9 @@
 /** Value returned by \ref u8UTIL_convertCharToHex4bits on failing conversion */
 #define HEX_DEC_4BIT_CONVERSION_FAILED_CODE   0xFF
 
+/** Initial value of \ref u16UTIL_crc16 */
+#define UTIL_CRC16_INIT                       0xFFFF
+
 /* Exported functions prototypes ---------------------------------------------*/
 
 /**
@@ -57,6 +60,37 @@ bool bUTIL_strcmp(uint8_t *pu8_Str1, const uint8_t *pu8_Str2, uint8_t u8_strLeng
  */
 uint8_t u8UTIL_convertCharToHex4bits(uint8_t u8_num);
 
+/**
+ * @brief Decode an hexadecimal ASCII string into binary, in a single pass
+ *
+ * Decoding stops at the first non-hexadecimal character or once u16_maxChar characters are
+ * decoded. Output is MSB first: an odd last nibble is set in the high part of the last byte, its
+ * low part being cleared.
+ *
+ * @note Output buffer may be the same as input buffer (in place decoding)
+ *
+ * @param [in] pu8_in : hexadecimal ASCII string
+ * @param [in] u16_maxChar : maximum number of characters to decode
+ * @param [out] pu8_out : binary output, must be able to hold (u16_maxChar + 1) / 2 bytes
+ *
+ * @return number of decoded characters (i.e. number of decoded bits divided by 4)
+ */
+uint16_t u16UTIL_convertHexStringToBin(const uint8_t *pu8_in, uint16_t u16_maxChar,
+	uint8_t *pu8_out);
+
+/**
+ * @brief Compute CRC-16/CCITT-FALSE (polynomial 0x1021, MSB first, no final XOR)
+ *
+ * CRC can be computed by chunks, passing the result of previous chunk as input CRC.
+ *
+ * @param [in] u16_crc : \ref UTIL_CRC16_INIT for first chunk, CRC of previous chunks otherwise
+ * @param [in] pu8_data : data
+ * @param [in] u16_len : data length in bytes
+ *
+ * @return CRC of data (e.g. 0x29B1 for "123456789")
+ */
+uint16_t u16UTIL_crc16(uint16_t u16_crc, const uint8_t *pu8_data, uint16_t u16_len);
+
 #endif /* __STRLIB_H */
 
 /**
@@ -16,6 +16,22 @@
 /* Includes ------------------------------------------------------------------*/
 #include "strutil_lib.h"
 
+/* Private variables ---------------------------------------------------------*/
+
+/** ASCII to nibble lookup table. Entries hold nibble value + 1, 0 stands for non-hex character */
+static const uint8_t cau8_hexLut[256] = {
+	['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5,
+	['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+	['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+	['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+};
+
+/** CRC-16/CCITT remainders of one nibble, small table to save flash */
+static const uint16_t cau16_crc16Lut[16] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
 /* Functions Implementation --------------------------------------------------*/
 
 bool bUTIL_strcmp(uint8_t *pu8_Str1, const uint8_t *pu8_Str2, uint8_t u8_strLength)
@@ -35,16 +51,49 @@ bool bUTIL_strcmp(uint8_t *pu8_Str1, const uint8_t *pu8_Str2, uint8_t u8_strLeng
 
 uint8_t u8UTIL_convertCharToHex4bits(uint8_t u8_num)
 {
-	if ((u8_num >= 'A') && (u8_num <= 'F'))
-		return u8_num - 'A' + 10;
+	if (cau8_hexLut[u8_num] == 0)
+		return HEX_DEC_4BIT_CONVERSION_FAILED_CODE;
+
+	return cau8_hexLut[u8_num] - 1;
+}
+
+uint16_t u16UTIL_convertHexStringToBin(const uint8_t *pu8_in, uint16_t u16_maxChar,
+	uint8_t *pu8_out)
+{
+	uint16_t u16_charNb = 0;
+	uint8_t u8_high, u8_low;
+
+	/* Decode by pairs of characters */
+	while ((u16_charNb + 1) < u16_maxChar) {
+		u8_high = cau8_hexLut[pu8_in[u16_charNb]];
+		u8_low = cau8_hexLut[pu8_in[u16_charNb + 1]];
+		if ((u8_high == 0) || (u8_low == 0))
+			break;
+		pu8_out[u16_charNb / 2] = ((u8_high - 1) << 4) | (u8_low - 1);
+		u16_charNb += 2;
+	}
+
+	/* Odd last character */
+	if (u16_charNb < u16_maxChar) {
+		u8_high = cau8_hexLut[pu8_in[u16_charNb]];
+		if (u8_high != 0) {
+			pu8_out[u16_charNb / 2] = (u8_high - 1) << 4;
+			u16_charNb++;
+		}
+	}
 
-	if ((u8_num >= 'a') && (u8_num <= 'f'))
-		return u8_num - 'a' + 10;
+	return u16_charNb;
+}
 
-	if ((u8_num >= '0') && (u8_num <= '9'))
-		return u8_num - '0';
+uint16_t u16UTIL_crc16(uint16_t u16_crc, const uint8_t *pu8_data, uint16_t u16_len)
+{
+	while (u16_len-- > 0) {
+		u16_crc = (u16_crc << 4) ^ cau16_crc16Lut[(u16_crc >> 12) ^ (*pu8_data >> 4)];
+		u16_crc = (u16_crc << 4) ^ cau16_crc16Lut[(u16_crc >> 12) ^ (*pu8_data & 0x0F)];
+		pu8_data++;
+	}
 
-	return HEX_DEC_4BIT_CONVERSION_FAILED_CODE;
+	return u16_crc;
 }
 
 /**
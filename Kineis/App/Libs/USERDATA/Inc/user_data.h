@@ -106,10 +106,6 @@
  * @brief Maximum number of bytes of user data field
  *
  * On Kineis RAT, the maximum size is 196 bits which is 24.5 bytes. Round it to 25.
- *
- * @note So far MGR_AT_CMD makes the FIFO to contain the USER data as ASCII-HEX string. Thus:
- * * multiply length by 2
- * * add 1 extra for end-of-string ('\0')
  */
 #ifndef USERDATA_TX_DATAFIELD_SIZE
 #ifdef USE_HDA4
@@ -119,8 +115,13 @@
 #endif
 #endif
 
+/**
+ * @brief Size in bytes of the user data buffer of TX FIFO elements
+ *
+ * @note MGR_AT_CMD and MGR_SPI_CMD store user data in FIFO as binary, thus same as data field.
+ */
 #ifndef USERDATA_TX_PAYLOAD_MAX_SIZE
-#define USERDATA_TX_PAYLOAD_MAX_SIZE ((USERDATA_TX_DATAFIELD_SIZE * 2) + 1)
+#define USERDATA_TX_PAYLOAD_MAX_SIZE USERDATA_TX_DATAFIELD_SIZE
 #endif
 
 #if (USERDATA_TX_DATAFIELD_SIZE < 25)
@@ -224,6 +225,9 @@ struct sUserDataTxFifoElt_t {
 				*/
 	union sUserDataAttribute_t u8Attr;
 	uint16_t u16DataBitLen;
+	bool bIsCrcRsp;        /** when true, TX result is reported to host with data CRC only */
+	uint16_t u16DataCrc;   /** CRC-16 of data, as received from host (e.g. AT+TXB) */
+	uint16_t u16MsgHandle; /** per-submission id reported with TX results (e.g. SPI MAC events) */
 	struct sUserDataTxFifoRatCtrl_t sRatCtrl; /**< struct w/ ctrl info from RAT managers */
 	struct sUserDataTxFifoElt_t *spNext; /**< pointer to next element of the chained list */
 };
@@ -264,6 +268,19 @@ extern struct sUserDataClientCb_t sUserDataClientCb[];
  */
 struct sUserDataTxFifoElt_t *USERDATA_txFifoReserveElt();
 
+/**
+ * @brief Get several elements from memory pool at once, e.g. for a batch of messages
+ *
+ * Elements are all reserved within a single critical section, thus no other producer can take
+ * free elements in the middle of a batch. Same as \ref USERDATA_txFifoReserveElt otherwise.
+ *
+ * @param[out] aspElt array filled-up with pointers on reserved elements
+ * @param[in] u8_eltNb number of elements requested
+ *
+ * @return number of reserved elements, lower than requested if there is not enough free elements
+ */
+uint8_t USERDATA_txFifoReserveElts(struct sUserDataTxFifoElt_t *aspElt[], uint8_t u8_eltNb);
+
 /**
  * @brief Add element in TX fifo
  *
@@ -42,6 +42,9 @@ const struct sUserDataTxFifoElt_t sUserDataTxEltDflt =  {
 		.bIsToBeTransmit = false,
 		.u8Attr.u8_raw = 0x00,
 		.u16DataBitLen = 0,
+		.bIsCrcRsp = false,
+		.u16DataCrc = 0,
+		.u16MsgHandle = 0,
 		//.sRatCtrl = {0}, //.sRatCtrl will be initialized by calling client's callbacks
 		.spNext = NULL
 };
@@ -155,6 +158,37 @@ struct sUserDataTxFifoElt_t *USERDATA_txFifoReserveElt(void)
 	return spFreeElt;
 }
 
+uint8_t USERDATA_txFifoReserveElts(struct sUserDataTxFifoElt_t *aspElt[], uint8_t u8_eltNb)
+{
+	uint8_t eltIdx;
+	uint8_t u8_reservedNb = 0;
+
+	KNS_CS_enter();
+	for (eltIdx = 0;
+	     eltIdx < USERDATA_TX_FIFO_SIZE && u8_reservedNb < u8_eltNb;
+	     eltIdx++) {
+		if (sUserDataTxFifoBuf[eltIdx].bIsToBeTransmit == true)
+			continue;
+
+		/* check elt is not already part of the fifo */
+		kns_assert(!USERDATA_txFifoIsEltInFifo(&sUserDataTxFifoBuf[eltIdx]));
+
+		sUserDataTxFifoBuf[eltIdx].bIsToBeTransmit = true;
+		aspElt[u8_reservedNb++] = &sUserDataTxFifoBuf[eltIdx];
+	}
+	KNS_CS_exit();
+
+	/* elements are no more free, reset them to default out of critical section */
+	for (eltIdx = 0; eltIdx < u8_reservedNb; eltIdx++) {
+		*aspElt[eltIdx] = sUserDataTxEltDflt;
+		aspElt[eltIdx]->bIsToBeTransmit = true;
+	}
+
+	MGR_LOG_VERBOSE("USERDATA: TX FIFO: reserve %d/%d elts\r\n", u8_reservedNb, u8_eltNb);
+
+	return u8_reservedNb;
+}
+
 
 #pragma GCC push_options
 #pragma GCC optimize("O0")
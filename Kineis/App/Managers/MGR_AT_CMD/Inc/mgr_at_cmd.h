@@ -71,7 +71,11 @@ bool MGR_AT_CMD_isPendingAt(void);
 /**
  * @brief API used to get next AT command stored in internal fifo
  *
- * @retval Pointer to the AT cmd to be decoded
+ * The AT cmd remains valid until next call, which releases it. AT cmds dropped as the fifo was
+ * full are reported here to the host ("+ERROR=<ERROR_AT_CMD_FIFO_FULL>"), in the order they were
+ * received.
+ *
+ * @retval Pointer to the AT cmd to be decoded, NULL if fifo is empty
  */
 uint8_t *MGR_AT_CMD_popNextAt(void);
 
@@ -84,6 +88,16 @@ uint8_t *MGR_AT_CMD_popNextAt(void);
  */
 bool MGR_AT_CMD_decodeAt(uint8_t *pu8_atcmd);
 
+/**
+ * @brief Get the raw block received right after an AT cmd line (e.g. AT+TXB binary payload)
+ *
+ * @param[in] pu8_atcmd pointer to AT command, as popped from internal fifo
+ * @param[out] pu16_len number of raw bytes actually received, 0 if none
+ *
+ * @retval Pointer to the raw block
+ */
+uint8_t *MGR_AT_CMD_getRawBlock(uint8_t *pu8_atcmd, uint16_t *pu16_len);
+
 /**
  * @brief Fct used to retreive and process event coming from kineis stack as answers to AT commands
  *
@@ -21,36 +21,37 @@
 
 /* Defines -------------------------------------------------------------------*/
 
-/** Indexes for AT commands present in system */
+/** Indexes for AT commands present in system
+ *
+ * @attention Indexes must follow the ASCII order of the command names (see
+ * \ref cas_atcmd_list_array) as AT cmd decoding is a binary search over the names.
+ */
 enum  atcmd_idx_t {
-	// General commands
-	AT_VERSION,      /**< Get AT commands version */
-	AT_PING,         /**< Ping command */
-	AT_FW,           /**< Get fw version command */
 	AT_ADDR,         /**< Get/set device address command */
+	AT_CW,           /**< Index for CW/MW commands */
+	AT_FW,           /**< Get fw version command */
 	AT_ID,           /**< Get/set device ID command */
-	AT_SECKEY,       /**< Get/set device secret key */
-	AT_SN,           /**< Get device serial number command */
-	AT_RCONF,        /**< Get/Set radio configuration command */
-	AT_SAVE_RCONF,   /**< Save radio configuration into Flash command */
+	AT_KMAC,         /**< Index for change profile */
 	AT_LPM,          /**< Get/Set low power mode command */
-	AT_TCXO_WU,      /**< Get/Set TCXO Warm up in ms */
-
-	// User data commands
-	AT_TX,           /**< Index for TX commands */
+	AT_PING,         /**< Ping command */
+	AT_PREPASS_EN,   /**< Index for get/set PREVIPASS algo */
+#ifdef USE_MCU_PROF
+	AT_PROF,         /**< Get/Reset tasks and ISRs cycle profiling */
+#endif
+	AT_QSTAT,        /**< Get/Reset queues usage statistics */
+	AT_RCONF,        /**< Get/Set radio configuration command */
 #ifdef USE_RX_STACK
 	AT_RX,           /**< Index for TX commands */
 #endif
-
-	// Certif commands
-	AT_CW,           /**< Index for CW/MW commands */
-
-	// Satellite pass predictions commands
-	AT_PREPASS_EN,   /**< Index for get/set PREVIPASS algo */
+	AT_SAVE_RCONF,   /**< Save radio configuration into Flash command */
+	AT_SECKEY,       /**< Get/set device secret key */
+	AT_SN,           /**< Get device serial number command */
+	AT_TCXO_WU,      /**< Get/Set TCXO Warm up in ms */
+	AT_TX,           /**< Index for TX commands */
+	AT_TXB,          /**< Index for binary TX commands */
+	AT_TXBATCH,      /**< Index for batched TX commands */
 	AT_UDATE,        /**< Index for UTC date/time update */
-
-	// MAC commands
-	AT_KMAC,         /**< Index for change profile */
+	AT_VERSION,      /**< Get AT commands version */
 
 	ATCMD_MAX_COUNT,
 	ATCMD_UNKNOWN_COMMAND = ATCMD_MAX_COUNT
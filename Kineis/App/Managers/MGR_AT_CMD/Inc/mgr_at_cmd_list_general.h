@@ -176,15 +176,17 @@ bool bMGR_AT_CMD_SAVE_RCONF_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e
  */
 bool bMGR_AT_CMD_LPM_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode);
 
-/** @brief Set/Get TCXO warmup time in ms
+/** @brief Set/Get TCXO warmup and idle hold times in ms
  *
- * 1) "AT+TCXO_WU=<Time in MS> will configure the expected Warmup time for the TCXO.
+ * 1) "AT+TCXO_WU=<warmup ms>[,<hold ms>]" will configure the expected Warmup time for the TCXO
+ * (up to 30000 ms) and, optionally, the time TCXO is kept on after last transmission (up to
+ * \ref MCU_MISC_TCXO_HOLD_MAX_MS, 0 switches it off right away). Back-to-back transmissions
+ * within hold time do not pay the warm-up again.
  *
- * @attention Warmup is not asynchronous, it will block the context so don't used it in ISR context
+ * 2) "AT+TCXO_WU=?" will reply the TCXO times configured, and the last warm-up time measured
+ * from TCXO enabling to ready.
  *
- * 2) "AT+TCXO=?" will reply the TCXO time configured
- *
- * Response format: "+TCXO=<ms>" depending on your implementation.
+ * Response format: "+TCXO=<warmup ms>,<hold ms>,<measured warmup ms>"
  *
  * @param[in] pu8_cmdParamString: string containing AT command
  * @param[in] e_exec_mode: type of the command (status command or action command)
@@ -193,6 +195,41 @@ bool bMGR_AT_CMD_LPM_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_m
  */
 bool bMGR_AT_CMD_TCXO_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode);
 
+/** @brief Get/Reset Kineis OS queues usage statistics
+ *
+ * 1) "AT+QSTAT" will clear counters, high-water marks and residence times of all queues.
+ *
+ * 2) "AT+QSTAT=?" will reply one line per queue, sorted by queue handle (0: APP2MAC,
+ * 1: MAC2APP, 2: INFRA2MAC, 3: SRVC2MAC)
+ *
+ * Response format: "+QSTAT=<q>,<capacity>,<depth>,<hwm>,<push>,<pop>,<qfull>,<max residence ms>"
+ *
+ * @param[in] pu8_cmdParamString: string containing AT command
+ * @param[in] e_exec_mode: type of the command (status command or action command)
+ *
+ * @return true if command is correctly received and processed, false if error
+ */
+bool bMGR_AT_CMD_QSTAT_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode);
+
+#ifdef USE_MCU_PROF
+/** @brief Get/Reset cycle profiling of Kineis OS tasks and main ISRs
+ *
+ * 1) "AT+PROF" will clear call counters, total and max cycles of all slots.
+ *
+ * 2) "AT+PROF=?" will reply one line per profiled slot: Kineis OS tasks (APP, MAC, IDLE) then
+ * ISRs (LPUART, SPI, TIM16, RTC_WKUP, SUBGHZ). Cycles are core clock cycles, task cycles include
+ * the ISRs served meanwhile.
+ *
+ * Response format: "+PROF=<name>,<calls>,<total cycles>,<max cycles>"
+ *
+ * @param[in] pu8_cmdParamString: string containing AT command
+ * @param[in] e_exec_mode: type of the command (status command or action command)
+ *
+ * @return true if command is correctly received and processed, false if error
+ */
+bool bMGR_AT_CMD_PROF_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode);
+#endif
+
 #endif /* __MGR_AT_CMD_LIST_GENERAL_H */
 /**
  * @}
@@ -79,6 +79,47 @@ uint16_t u16MGR_AT_CMD_convertAsciiToInt32(uint8_t *pu8InputBuffer, uint32_t *u3
  */
 bool bMGR_AT_CMD_TX_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode);
 
+/**
+ * @brief Process AT command "AT+TXB" send binary user data.
+ *
+ * 1) "AT+TXB=<Len>[,0x<Attr>]\r" followed by <Len> raw data bytes then their CRC-16 starts a
+ *    transmission of the data with "Attr" attribute (same as AT+TX). Raw bytes follow the '\r'
+ *    immediately, without any '\n'.
+ *
+ * 2) "AT+TXB=?" Mode Not supported for this command
+ *
+ * CRC is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over data bytes, sent MSB first.
+ * Once transmitted, the result is reported as "+TXB=<err>,<CRC>" instead of the "+TX=..." echo of
+ * the whole data. A bad CRC is reported as ERROR_USER_DATA_CRC, a raw block truncated by more than
+ * 100ms between two bytes as ERROR_INVALID_USER_DATA_LENGTH.
+ *
+ * @param[in] pu8_cmdParamString: string containing AT command
+ * @param[in] e_exec_mode: type of the command (status command or action command)
+ *
+ * @return true if command is correctly received and processed, false if error
+ */
+bool bMGR_AT_CMD_TXB_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode);
+
+/**
+ * @brief Process AT command "AT+TXBATCH" send several user data at once.
+ *
+ * 1) "AT+TXBATCH=<HexData1>[,0x<Attr1>][;<HexData2>[,0x<Attr2>]]..." starts a transmission of
+ *    each "HexData" with its "Attr" attribute (same as AT+TX). Up to USERDATA_TX_FIFO_SIZE items.
+ *
+ * 2) "AT+TXBATCH=?" Mode Not supported for this command
+ *
+ * TCXO is warmed-up once for the whole batch. The command is answered right away with
+ * "+TXBATCH=<AcceptedNb>,<Err1>,...,<ErrN>", one AT cmd error code per item (0 if accepted).
+ * Each accepted item is then reported once transmitted, same as AT+TX. If TCXO was cold, items are
+ * pushed to MAC at the end of its warm-up, and a MAC queue full is then reported as "+ERROR=21".
+ *
+ * @param[in] pu8_cmdParamString: string containing AT command
+ * @param[in] e_exec_mode: type of the command (status command or action command)
+ *
+ * @return true if at least one item is accepted, false otherwise
+ */
+bool bMGR_AT_CMD_TXBATCH_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode);
+
 #ifdef USE_RX_STACK
 /**
  * @brief Process AT command "AT+RX" received data. This is mainly aimed at updating AOP/CS data
@@ -23,34 +23,57 @@
 #include KINEIS_SW_ASSERT_H
 #include "mgr_log.h"
 #include "subghz.h"
+#include "kns_os.h"
+#include "kns_cs.h"
+#include "user_data.h"
 /* Defines --------------------------------------------------------------------------------------*/
 
-/** Define AT commands FIFO length. As long as sending AT+TX one by one, it is not that usefull to
- * enqueue AT commands so far. Later, this may be useful to increase FIFO in case application or
- * GUI is sending several commands in a raw.
+/** Define AT commands FIFO size, in bytes. AT cmd lines are stored one after the other in this
+ * byte arena, each one taking only its own length (plus a small header). Thus, many short commands
+ * such as AT+PING can be pipelined, while a single long AT+TX still fits.
  *
- * @attention AT CMD FIFO_MAX_SIZE must be superior or equal to 2
- *
- * @attention Ensure there is always one extra free space in fifo between write index and read
- *            index meaning that if you expect to store 3 AT cmd at maximum, FIFO size should be
- *            3+1 minimum if you want to avoid overflow.
+ * @attention AT CMD FIFO_MAX_SIZE must fit, at least, one AT cmd line of FRAME_MAX_LEN.
  */
-#define FIFO_MAX_SIZE                                   4
 #ifdef USE_HDA4
+#define FIFO_MAX_SIZE                                   2048
 #define FRAME_MAX_LEN                                   1280
 #else
-#define FRAME_MAX_LEN                                   128
+#define FIFO_MAX_SIZE                                   512
+/** Fits an AT+TXBATCH cmd carrying one full LDA2 payload per USERDATA element */
+#define FRAME_MAX_LEN                                   256
+#endif
+
+/** Size of the header of each AT cmd line stored in FIFO: record length (uint16) then number of AT
+ * cmds dropped right before this one (uint8). A zero record length means FIFO wraps to its start.
+ */
+#define REC_HDR_SIZE                                    3
+/** Size of the raw block length stored in FIFO, right after the AT cmd string */
+#define RAW_LEN_SIZE                                    2
+/** Size of the CRC-16 ending AT+TXB raw block */
+#define TXB_CRC_SIZE                                    2
+
+#if FIFO_MAX_SIZE < (REC_HDR_SIZE + FRAME_MAX_LEN + 1 + RAW_LEN_SIZE)
+#error "FIFO_MAX_SIZE must fit, at least, one AT cmd line of FRAME_MAX_LEN"
 #endif
 
-#if FIFO_MAX_SIZE < 2
-#error "FIFO_MAX_SIZE must be superior or equal to 2"
+#if FRAME_MAX_LEN < (USERDATA_TX_DATAFIELD_SIZE + TXB_CRC_SIZE + RAW_LEN_SIZE + 32)
+#error "FRAME_MAX_LEN must fit AT+TXB cmd followed by a full user data raw block"
 #endif
 
 /* Structure Declaration ------------------------------------------------------------------------*/
+
+/**
+ * @brief FIFO of AT cmd lines, as a byte arena. A line is never split around the end of the arena.
+ *
+ * Written from AT console RX context, read from APP task. The last popped line remains valid
+ * until next pop, while it is decoded.
+ */
 struct atcmdfifo_t {
-	uint8_t au8_fifo[FIFO_MAX_SIZE][FRAME_MAX_LEN];
-	uint8_t u8_widx;
-	uint8_t u8_ridx;
+	uint8_t au8_fifo[FIFO_MAX_SIZE];
+	uint16_t u16_wOff;   /**< end of the last committed line */
+	uint16_t u16_popOff; /**< start of the next line to pop */
+	uint16_t u16_rOff;   /**< start of the oldest line in use (the one being decoded) */
+	uint8_t u8_dropNb;   /**< AT cmds dropped since last committed line, FIFO being full */
 };
 
 struct atcmd_info_t {
@@ -61,9 +84,140 @@ struct atcmd_info_t {
 /* Private variables ----------------------------------------------------------------------------*/
 
 static struct atcmdfifo_t s_atcmdfifo; /**< A FIFO used to store AT commands received from UART */
+static uint8_t *s_rawRec; /**< FIFO record waiting for its raw block, NULL if none */
+static uint16_t s_rawRecEnd; /**< end offset of the record waiting for its raw block */
 
 /* Private functions ----------------------------------------------------------------------------*/
 
+/**
+ * @brief Reserve a line record in the FIFO, contiguous in the arena
+ *
+ * One byte always remains free between end of writing and start of reading, so that an empty and
+ * a full FIFO can be told apart.
+ *
+ * @attention This fct may be called from ISR context
+ *
+ * @param[in] u16_recLen length of the record, header included
+ * @param[out] pu16_recEnd offset of the record end, to commit it
+ *
+ * @retval pointer to the record, NULL if FIFO is full
+ */
+static uint8_t *MGR_AT_CMD_reserveRec(uint16_t u16_recLen, uint16_t *pu16_recEnd)
+{
+	uint16_t u16_wOff = s_atcmdfifo.u16_wOff;
+	uint16_t u16_rOff = s_atcmdfifo.u16_rOff;
+
+	if (u16_wOff >= u16_rOff) {
+		if ((FIFO_MAX_SIZE - u16_wOff) >= u16_recLen) {
+			*pu16_recEnd = u16_wOff + u16_recLen;
+			return &s_atcmdfifo.au8_fifo[u16_wOff];
+		}
+		/* Not enough room at the end, wrap to the start of the arena */
+		if (u16_recLen >= u16_rOff)
+			return NULL;
+		if ((FIFO_MAX_SIZE - u16_wOff) >= REC_HDR_SIZE) {
+			s_atcmdfifo.au8_fifo[u16_wOff] = 0;
+			s_atcmdfifo.au8_fifo[u16_wOff + 1] = 0;
+		}
+		*pu16_recEnd = u16_recLen;
+		return &s_atcmdfifo.au8_fifo[0];
+	}
+
+	if (u16_recLen >= (u16_rOff - u16_wOff))
+		return NULL;
+	*pu16_recEnd = u16_wOff + u16_recLen;
+	return &s_atcmdfifo.au8_fifo[u16_wOff];
+}
+
+/**
+ * @brief Push a reserved line record into the FIFO
+ *
+ * @attention This fct may be called from ISR context
+ *
+ * @param[in] pu8_rec pointer to the record
+ * @param[in] u16_recEnd offset of the record end
+ */
+static void MGR_AT_CMD_commitRec(uint8_t *pu8_rec, uint16_t u16_recEnd)
+{
+	uint16_t u16_recLen = &s_atcmdfifo.au8_fifo[u16_recEnd] - pu8_rec;
+
+	pu8_rec[0] = (uint8_t)u16_recLen;
+	pu8_rec[1] = (uint8_t)(u16_recLen >> 8);
+	pu8_rec[2] = s_atcmdfifo.u8_dropNb;
+	s_atcmdfifo.u8_dropNb = 0;
+	s_atcmdfifo.u16_wOff = u16_recEnd;
+	KNS_OS_setTaskReady(KNS_OS_TASK_APP);
+}
+
+/**
+ * @brief Account an AT cmd dropped as FIFO is full, it will be reported in order to the host
+ *
+ * @attention This fct may be called from ISR context
+ */
+static void MGR_AT_CMD_dropLine(void)
+{
+	if (s_atcmdfifo.u8_dropNb < UINT8_MAX)
+		s_atcmdfifo.u8_dropNb++;
+	KNS_OS_setTaskReady(KNS_OS_TASK_APP);
+}
+
+/**
+ * @brief Get length of the raw block following an AT cmd line, if any
+ *
+ * So far, only "AT+TXB=<len>[,...]" is followed by a raw block: <len> data bytes then a CRC-16.
+ *
+ * @param[in] pu8_atcmd pointer to AT cmd line (not necessarily NUL terminated)
+ * @param[in] i16_atcmdLen length of AT cmd line
+ *
+ * @retval raw block length in bytes, 0 if AT cmd line is not followed by a raw block
+ */
+static uint16_t MGR_AT_CMD_getRawBlockLen(const uint8_t *pu8_atcmd, int16_t i16_atcmdLen)
+{
+	const struct atcmd_desc_t *txb = &cas_atcmd_list_array[AT_TXB];
+	const int16_t i16_paramIdx = txb->u8_cmdNameLen + 1;
+	int16_t i16_idx;
+	uint32_t u32_len = 0;
+
+	if ((i16_atcmdLen <= i16_paramIdx) ||
+	    (strncmp(txb->pu8_cmdNameString, (const char *)pu8_atcmd, txb->u8_cmdNameLen) != 0) ||
+	    (pu8_atcmd[i16_paramIdx - 1] != '='))
+		return 0;
+
+	for (i16_idx = i16_paramIdx; (i16_idx < i16_atcmdLen) &&
+			(pu8_atcmd[i16_idx] >= '0') && (pu8_atcmd[i16_idx] <= '9'); i16_idx++) {
+		u32_len = (u32_len * 10) + (pu8_atcmd[i16_idx] - '0');
+		if (u32_len > (UINT16_MAX - TXB_CRC_SIZE))
+			return 0;
+	}
+	if (i16_idx == i16_paramIdx)
+		return 0;
+
+	return u32_len + TXB_CRC_SIZE;
+}
+
+/**
+ * @brief Raw block callback, push pending AT cmd into the FIFO now that its raw block is over
+ *
+ * @attention This fct may be called from ISR context
+ *
+ * @param[in] u16_rxLen number of raw bytes received
+ */
+static void MGR_AT_CMD_rawBlockCb(uint16_t u16_rxLen)
+{
+	uint8_t *pu8_rec = s_rawRec;
+	uint8_t *pu8_rawLen;
+
+	/* Block was discarded */
+	if (pu8_rec == NULL)
+		return;
+
+	pu8_rawLen = pu8_rec + REC_HDR_SIZE + strlen((const char *)(pu8_rec + REC_HDR_SIZE)) + 1;
+	pu8_rawLen[0] = (uint8_t)u16_rxLen;
+	pu8_rawLen[1] = (uint8_t)(u16_rxLen >> 8);
+	s_rawRec = NULL;
+	MGR_AT_CMD_commitRec(pu8_rec, s_rawRecEnd);
+}
+
 /**
  * @brief API used to extract the latest AT cmds from the incoming received data stream.
  *
@@ -71,6 +225,8 @@ static struct atcmdfifo_t s_atcmdfifo; /**< A FIFO used to store AT commands rec
  * If several frames are received in a row, only the last AT cmd is extracted
  *
  * Once AT cmd is found, it is removed from the stream and stored into the FIFO if not full.
+ * Otherwise, it is dropped and an error is reported to the host once previous AT cmds are
+ * processed (\ref MGR_AT_CMD_popNextAt).
  *
  * As this fct is the entry point into FW, it is real-time critical and may be more robust. Some
  * design limitations are describerd below.
@@ -80,6 +236,10 @@ static struct atcmdfifo_t s_atcmdfifo; /**< A FIFO used to store AT commands rec
  * @note Any garbage after the found AT cmd is also removed from stream. But the garbage before
  *       remains in the original stream.
  *
+ * @note An AT cmd followed by a raw block (e.g. AT+TXB) is only pushed into the FIFO once the
+ *       block is over (\ref MGR_AT_CMD_rawBlockCb). The block is stored in the same FIFO record,
+ *       right after the AT cmd string and the number of raw bytes actually received.
+ *
  * @param[in,out] pu8_RxBuffer pointer to start of RX buffer
  * @param[in,out] pi16_nbRxValidChar number of valid charecters in RX buffer
  *
@@ -90,6 +250,9 @@ static bool MGR_AT_CMD_parseStreamCb(uint8_t *pu8_RxBuffer, int16_t *pi16_nbRxVa
 	int16_t idxEnd = 0;
 	int16_t idxStart = 0;
 	int16_t i16_atcmdLen = 0;
+	uint16_t u16_rawLen;
+	uint16_t u16_recEnd;
+	uint8_t *pu8_rec;
 	bool isEOLdetected = false;
 	bool isFirstCharDetected = false;
 
@@ -133,29 +296,48 @@ static bool MGR_AT_CMD_parseStreamCb(uint8_t *pu8_RxBuffer, int16_t *pi16_nbRxVa
 	 *
 	 */
 	*pi16_nbRxValidChar = idxStart;
+	i16_atcmdLen = idxEnd - idxStart;
+	u16_rawLen = MGR_AT_CMD_getRawBlockLen(&pu8_RxBuffer[idxStart], i16_atcmdLen);
+
+	/* Check AT cmd length overflow. Limit AT cmd len to maximum if overflow was
+	 * detected (reserve end-of-string'\0' and raw block length).
+	 */
+	if ((i16_atcmdLen + 1 + RAW_LEN_SIZE) > FRAME_MAX_LEN)
+		i16_atcmdLen = FRAME_MAX_LEN - 1 - RAW_LEN_SIZE;
 
-	/* In case FIFO is full (read index is reached), skip this new AT CMD. We need to wait for
-	 * FW to consume the previous AT CMDs before.
+	/* Reserve room for the AT cmd and its raw block, if any. If the raw block does not fit, it
+	 * is discarded and the AT cmd will report some length error. In case FIFO is full, drop
+	 * this new AT CMD and its raw block: we need to wait for FW to consume the previous AT CMDs.
 	 */
-	if ( ((s_atcmdfifo.u8_widx+1) % FIFO_MAX_SIZE) == (s_atcmdfifo.u8_ridx % FIFO_MAX_SIZE))
+	pu8_rec = MGR_AT_CMD_reserveRec(REC_HDR_SIZE + i16_atcmdLen + 1 + RAW_LEN_SIZE + u16_rawLen,
+			&u16_recEnd);
+	if ((pu8_rec == NULL) && (u16_rawLen > 0)) {
+		MCU_AT_CONSOLE_rxRaw(NULL, u16_rawLen, MGR_AT_CMD_rawBlockCb);
+		u16_rawLen = 0;
+		pu8_rec = MGR_AT_CMD_reserveRec(REC_HDR_SIZE + i16_atcmdLen + 1 + RAW_LEN_SIZE,
+				&u16_recEnd);
+	}
+	if (pu8_rec == NULL) {
+		MGR_AT_CMD_dropLine();
 		return true;
+	}
+
 	/* Set the frame in the UART fifo */
-	i16_atcmdLen = idxEnd - idxStart;
-	/* Check AT cmd length overflow. Limit AT cmd len to maximum if overflow was
-	 * detected (reserve last character for end-of-string'\0').
-	 */
-	if ((i16_atcmdLen + 1) > FRAME_MAX_LEN)
-		i16_atcmdLen = FRAME_MAX_LEN - 1;
-	memcpy(s_atcmdfifo.au8_fifo[s_atcmdfifo.u8_widx % FIFO_MAX_SIZE],
-		&pu8_RxBuffer[idxStart], i16_atcmdLen);
-	s_atcmdfifo.au8_fifo[s_atcmdfifo.u8_widx % FIFO_MAX_SIZE][i16_atcmdLen] = '\0';
-	/* Increment write index to next free position */
-	s_atcmdfifo.u8_widx++;
-
-	/* In case read index is reached, skip oldest stored AT cmd to let a newest one to come */
-	if (s_atcmdfifo.u8_widx % FIFO_MAX_SIZE == s_atcmdfifo.u8_ridx % FIFO_MAX_SIZE)
-		kns_assert(0); // should no more happen
-		// s_atcmdfifo.u8_ridx++;
+	memcpy(&pu8_rec[REC_HDR_SIZE], &pu8_RxBuffer[idxStart], i16_atcmdLen);
+	pu8_rec[REC_HDR_SIZE + i16_atcmdLen] = '\0';
+	memset(&pu8_rec[REC_HDR_SIZE + i16_atcmdLen + 1], 0, RAW_LEN_SIZE);
+
+	/* AT cmd waits for its raw block */
+	if (u16_rawLen > 0) {
+		s_rawRec = pu8_rec;
+		s_rawRecEnd = u16_recEnd;
+		if (MCU_AT_CONSOLE_rxRaw(&pu8_rec[REC_HDR_SIZE + i16_atcmdLen + 1 + RAW_LEN_SIZE],
+				u16_rawLen, MGR_AT_CMD_rawBlockCb))
+			return true;
+		s_rawRec = NULL;
+	}
+
+	MGR_AT_CMD_commitRec(pu8_rec, u16_recEnd);
 
 	return true;
 }
@@ -169,6 +351,10 @@ static bool MGR_AT_CMD_parseStreamCb(uint8_t *pu8_RxBuffer, int16_t *pi16_nbRxVa
  * AT cmds without pattern above is an action-type command. It is used to set some information into
  * the device (e.g. "AT+TX=<...>\r\n").
  *
+ * Command name is delimited by the first '=', '\r' or '\n' character. It is then exactly matched
+ * with a binary search over \ref cas_atcmd_list_array, sorted by name. Thus a command cannot be
+ * shadowed by another one being its prefix (e.g. AT+TX and AT+TXB).
+ *
  * @note This fct may be called from ISR context
  *
  * @param[in] pu8_atcmd pointer to the AT command
@@ -177,73 +363,130 @@ static bool MGR_AT_CMD_parseStreamCb(uint8_t *pu8_RxBuffer, int16_t *pi16_nbRxVa
  */
 static struct atcmd_info_t MGR_AT_CMD_getAtType(uint8_t *pu8_atcmd)
 {
-	uint8_t __u8_k;
-	uint8_t *p_atcmd_start;
-	uint8_t u8foundCmdIndex = ATCMD_UNKNOWN_COMMAND;
-	uint16_t u16_offset_search = 0;
+	uint8_t *p_atcmd_end;
+	uint16_t u16_nameLen;
+	int16_t i16_low = 0;
+	int16_t i16_high = ATCMD_MAX_COUNT - 1;
+	int16_t i16_mid;
+	int i_cmp;
 	struct atcmd_info_t atcmd_info;
 
+	atcmd_info.ATcmdIndex = ATCMD_UNKNOWN_COMMAND;
+	atcmd_info.ATcmdExecType = ATCMD_INVALID_USAGE;
 
-	atcmd_info.ATcmdIndex = u8foundCmdIndex;
-
-	/* Loop over table and check for match */
-	for (__u8_k = 0; __u8_k < ATCMD_MAX_COUNT; __u8_k++) {
-		u16_offset_search = cas_atcmd_list_array[__u8_k].u8_cmdNameLen;
+	/* Find end of command name */
+	for (u16_nameLen = 0; (pu8_atcmd[u16_nameLen] != '\0') &&
+			(pu8_atcmd[u16_nameLen] != '=') &&
+			(pu8_atcmd[u16_nameLen] != '\r') &&
+			(pu8_atcmd[u16_nameLen] != '\n'); u16_nameLen++) {
+		// empty loop
+	}
+	p_atcmd_end = &pu8_atcmd[u16_nameLen];
 
-		if (bUTIL_strcmp((uint8_t *)cas_atcmd_list_array[__u8_k].pu8_cmdNameString,
-					pu8_atcmd,
-					u16_offset_search)) {
-			u8foundCmdIndex = (enum atcmd_idx_t)__u8_k;
-			break;
+	/* Checks if next characters after command are either "=?\r", "=?\n" or
+	 * "=<params>\r" or "=<params>\n"
+	 *
+	 * @note "AT+<cmd>\r\n" is considered as action mode. it will be filtered in the
+	 * next parsing level.
+	 */
+	if (p_atcmd_end[0] == '\0')
+		return atcmd_info;
+	else if ((p_atcmd_end[0] == '=') && (p_atcmd_end[1] == '?') &&
+			((p_atcmd_end[2] == '\r') || (p_atcmd_end[2] == '\n')))
+		atcmd_info.ATcmdExecType = ATCMD_STATUS_MODE;
+	else
+		atcmd_info.ATcmdExecType = ATCMD_ACTION_MODE;
+
+	/* Binary search of the exact command name */
+	while (i16_low <= i16_high) {
+		i16_mid = (i16_low + i16_high) / 2;
+		i_cmp = strncmp(cas_atcmd_list_array[i16_mid].pu8_cmdNameString,
+				(const char *)pu8_atcmd, u16_nameLen);
+		if ((i_cmp == 0) && (cas_atcmd_list_array[i16_mid].u8_cmdNameLen == u16_nameLen)) {
+			atcmd_info.ATcmdIndex = (enum atcmd_idx_t)i16_mid;
+			return atcmd_info;
 		}
+		/** Same prefix but longer name in list, it sorts after the received one */
+		if (i_cmp == 0)
+			i_cmp = 1;
+		if (i_cmp < 0)
+			i16_low = i16_mid + 1;
+		else
+			i16_high = i16_mid - 1;
 	}
-	/* If command is found in list, check type */
-	if (u8foundCmdIndex < ATCMD_UNKNOWN_COMMAND) {
-		u16_offset_search = cas_atcmd_list_array[u8foundCmdIndex].u8_cmdNameLen;
-		p_atcmd_start = pu8_atcmd;
-
-		/* Checks if next characters after command are either "=?\r", "=?\n" or
-		 * "=<params>\r" or "=<params>\n"
-		 *
-		 * @note "AT+<cmd>\r\n" is considered as action mode. it will be filtered in the
-		 * next parsing level.
-		 */
-		if ((p_atcmd_start[u16_offset_search] == '=')
-				&& (p_atcmd_start[u16_offset_search+1] == '?')
-				&& ((p_atcmd_start[u16_offset_search+2] == '\r')
-					|| (p_atcmd_start[u16_offset_search+2] == '\n'))) {
-			atcmd_info.ATcmdExecType = ATCMD_STATUS_MODE;
-			atcmd_info.ATcmdIndex = u8foundCmdIndex;
-		} else if ((p_atcmd_start[u16_offset_search] == '=')
-				|| (p_atcmd_start[u16_offset_search] == '\r')
-				|| (p_atcmd_start[u16_offset_search] == '\n')) {
-			atcmd_info.ATcmdExecType = ATCMD_ACTION_MODE;
-			atcmd_info.ATcmdIndex = u8foundCmdIndex;
-		} else
-			atcmd_info.ATcmdIndex = ATCMD_UNKNOWN_COMMAND;
-	}
+
+	atcmd_info.ATcmdExecType = ATCMD_INVALID_USAGE;
 	return atcmd_info;
 }
 
+/**
+ * @brief Check AT cmd list is sorted by name as expected by \ref MGR_AT_CMD_getAtType
+ *
+ * @retval true if sorted, false otherwise
+ */
+static bool MGR_AT_CMD_isListSorted(void)
+{
+	uint8_t u8_k;
+
+	for (u8_k = 1; u8_k < ATCMD_MAX_COUNT; u8_k++)
+		if (strcmp(cas_atcmd_list_array[u8_k - 1].pu8_cmdNameString,
+				cas_atcmd_list_array[u8_k].pu8_cmdNameString) >= 0)
+			return false;
+	return true;
+}
+
 /* Functions ------------------------------------------------------------------------------------*/
 
 bool MGR_AT_CMD_start(void *context)
 {
+	kns_assert(MGR_AT_CMD_isListSorted());
 	return MCU_AT_CONSOLE_register(context, MGR_AT_CMD_parseStreamCb);
 
 }
 
 bool MGR_AT_CMD_isPendingAt(void)
 {
-	return (s_atcmdfifo.u8_ridx % FIFO_MAX_SIZE != s_atcmdfifo.u8_widx % FIFO_MAX_SIZE);
+	return ((s_atcmdfifo.u16_popOff != s_atcmdfifo.u16_wOff) || (s_atcmdfifo.u8_dropNb != 0));
 }
 
 uint8_t *MGR_AT_CMD_popNextAt(void)
 {
-	if (s_atcmdfifo.u8_ridx % FIFO_MAX_SIZE != s_atcmdfifo.u8_widx % FIFO_MAX_SIZE)
-		return s_atcmdfifo.au8_fifo[s_atcmdfifo.u8_ridx++ % FIFO_MAX_SIZE];
-	else
-		return NULL;
+	uint8_t *pu8_rec = NULL;
+	uint8_t u8_dropNb;
+
+	KNS_CS_enter();
+	/* Previously popped AT cmd is over, release it */
+	s_atcmdfifo.u16_rOff = s_atcmdfifo.u16_popOff;
+	if (s_atcmdfifo.u16_popOff == s_atcmdfifo.u16_wOff) {
+		/* FIFO is empty, restart from the beginning of the arena unless a line is waiting
+		 * for its raw block. Report AT cmds dropped after the last committed line.
+		 */
+		if (s_rawRec == NULL) {
+			s_atcmdfifo.u16_wOff = 0;
+			s_atcmdfifo.u16_popOff = 0;
+			s_atcmdfifo.u16_rOff = 0;
+		}
+		u8_dropNb = s_atcmdfifo.u8_dropNb;
+		s_atcmdfifo.u8_dropNb = 0;
+	} else {
+		pu8_rec = &s_atcmdfifo.au8_fifo[s_atcmdfifo.u16_popOff];
+		if (((FIFO_MAX_SIZE - s_atcmdfifo.u16_popOff) < REC_HDR_SIZE) ||
+		    ((pu8_rec[0] | pu8_rec[1]) == 0)) {
+			pu8_rec = &s_atcmdfifo.au8_fifo[0];
+			s_atcmdfifo.u16_rOff = 0;
+		}
+		s_atcmdfifo.u16_popOff = (pu8_rec - s_atcmdfifo.au8_fifo) +
+				(pu8_rec[0] | (pu8_rec[1] << 8));
+		u8_dropNb = pu8_rec[2];
+		pu8_rec += REC_HDR_SIZE;
+	}
+	KNS_CS_exit();
+
+	/* AT cmds dropped as FIFO was full are reported in the order they were received */
+	for (; u8_dropNb > 0; u8_dropNb--)
+		bMGR_AT_CMD_logFailedMsg(ERROR_AT_CMD_FIFO_FULL);
+
+	return pu8_rec;
 }
 
 bool MGR_AT_CMD_decodeAt(uint8_t *pu8_atcmd)
@@ -270,6 +513,14 @@ bool MGR_AT_CMD_decodeAt(uint8_t *pu8_atcmd)
 	return status;
 }
 
+uint8_t *MGR_AT_CMD_getRawBlock(uint8_t *pu8_atcmd, uint16_t *pu16_len)
+{
+	uint8_t *pu8_rawLen = pu8_atcmd + strlen((const char *)pu8_atcmd) + 1;
+
+	*pu16_len = pu8_rawLen[0] | (pu8_rawLen[1] << 8);
+	return pu8_rawLen + RAW_LEN_SIZE;
+}
+
 __attribute((__weak__))
 enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 {
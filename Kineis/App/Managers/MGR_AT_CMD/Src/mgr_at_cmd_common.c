@@ -43,6 +43,10 @@ bool bMGR_AT_CMD_sendResponse(enum atcmd_rsp_type_t atcmd_response_type, void *a
 			uint8_t *pu8UserDataPtr = spUserDataMsg->u8DataBuf;
 			uint16_t u16UserDataBitlen = spUserDataMsg->u16DataBitLen;
 
+			if (spUserDataMsg->bIsCrcRsp) {
+				MCU_AT_CONSOLE_send("+TXB=0,%04X\r\n", spUserDataMsg->u16DataCrc);
+				return true;
+			}
 			MCU_AT_CONSOLE_send("+TX=0,");
 			MCU_AT_CONSOLE_send_dataBuf(pu8UserDataPtr, u16UserDataBitlen);
 			MCU_AT_CONSOLE_send("\r\n");
@@ -63,6 +67,11 @@ bool bMGR_AT_CMD_sendResponse(enum atcmd_rsp_type_t atcmd_response_type, void *a
 			if (atcmd_response_type == ATCMD_RSP_RXTIMEOUT)
 				error_id = ERROR_RX_TIMEOUT;
 
+			if (spUserDataMsg->bIsCrcRsp) {
+				MCU_AT_CONSOLE_send("+TXB=%d,%04X\r\n", error_id,
+					spUserDataMsg->u16DataCrc);
+				return true;
+			}
 			MCU_AT_CONSOLE_send("+TX=%d,", error_id);
 			MCU_AT_CONSOLE_send_dataBuf(pu8UserDataPtr, u16UserDataBitlen);
 			MCU_AT_CONSOLE_send("\r\n");
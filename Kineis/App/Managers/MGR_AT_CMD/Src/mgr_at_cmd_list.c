@@ -19,38 +19,46 @@
 #include "mgr_at_cmd_list_mac.h"
 #include "mgr_at_cmd_list_certif.h"
 
-const char *atcmd_version = "v0.5";
+const char *atcmd_version = "v0.8";
 
-/** @attention update AT cmd version above if you add or remove commands in this list */
+/** @attention update AT cmd version above if you add or remove commands in this list
+ * @attention entries are indexed by \ref atcmd_idx_t which must follow the ASCII order of names
+ */
 const struct atcmd_desc_t cas_atcmd_list_array[ATCMD_MAX_COUNT] = {
 	/**< General commands */
-	{ "AT+VERSION",      10, bMGR_AT_CMD_VERSION_cmd},
-	{ "AT+PING",          7, bMGR_AT_CMD_PING_cmd},
-	{ "AT+FW",            5, bMGR_AT_CMD_FW_cmd},
-	{ "AT+ADDR",          7, bMGR_AT_CMD_ADDR_cmd},
-	{ "AT+ID",            5, bMGR_AT_CMD_ID_cmd},
-	{ "AT+SECKEY",        9, bMGR_AT_CMD_SECKEY_cmd},
-	{ "AT+SN",            5, bMGR_AT_CMD_SN_cmd},
-	{ "AT+RCONF",         8, bMGR_AT_CMD_RCONF_cmd},
-	{ "AT+SAVE_RCONF",   13, bMGR_AT_CMD_SAVE_RCONF_cmd},
-	{ "AT+LPM",           6, bMGR_AT_CMD_LPM_cmd},
-	{ "AT+TCXO_WU",      10, bMGR_AT_CMD_TCXO_cmd},
+	[AT_VERSION]    = { "AT+VERSION",      10, bMGR_AT_CMD_VERSION_cmd},
+	[AT_PING]       = { "AT+PING",          7, bMGR_AT_CMD_PING_cmd},
+	[AT_FW]         = { "AT+FW",            5, bMGR_AT_CMD_FW_cmd},
+	[AT_ADDR]       = { "AT+ADDR",          7, bMGR_AT_CMD_ADDR_cmd},
+	[AT_ID]         = { "AT+ID",            5, bMGR_AT_CMD_ID_cmd},
+	[AT_SECKEY]     = { "AT+SECKEY",        9, bMGR_AT_CMD_SECKEY_cmd},
+	[AT_SN]         = { "AT+SN",            5, bMGR_AT_CMD_SN_cmd},
+	[AT_RCONF]      = { "AT+RCONF",         8, bMGR_AT_CMD_RCONF_cmd},
+	[AT_SAVE_RCONF] = { "AT+SAVE_RCONF",   13, bMGR_AT_CMD_SAVE_RCONF_cmd},
+	[AT_LPM]        = { "AT+LPM",           6, bMGR_AT_CMD_LPM_cmd},
+	[AT_TCXO_WU]    = { "AT+TCXO_WU",      10, bMGR_AT_CMD_TCXO_cmd},
+	[AT_QSTAT]      = { "AT+QSTAT",         8, bMGR_AT_CMD_QSTAT_cmd},
+#ifdef USE_MCU_PROF
+	[AT_PROF]       = { "AT+PROF",          7, bMGR_AT_CMD_PROF_cmd},
+#endif
 
 	/**< User data commands */
-	{ "AT+TX",            5, bMGR_AT_CMD_TX_cmd},
+	[AT_TX]         = { "AT+TX",            5, bMGR_AT_CMD_TX_cmd},
+	[AT_TXB]        = { "AT+TXB",           6, bMGR_AT_CMD_TXB_cmd},
+	[AT_TXBATCH]    = { "AT+TXBATCH",      10, bMGR_AT_CMD_TXBATCH_cmd},
 #ifdef USE_RX_STACK
-	{ "AT+RX",            5, bMGR_AT_CMD_RX_cmd},
+	[AT_RX]         = { "AT+RX",            5, bMGR_AT_CMD_RX_cmd},
 #endif
 
 	/**< Certif commands */
-	{ "AT+CW",            5, bMGR_AT_CMD_CW_cmd},
+	[AT_CW]         = { "AT+CW",            5, bMGR_AT_CMD_CW_cmd},
 
 	/**< Satellite pass predictions commands (not functionnal, only to avoid GUI to crash) */
-	{ "AT+PREPASS_EN",   13, bMGR_AT_CMD_PREPASS_EN_cmd},
-	{ "AT+UDATE",         8, bMGR_AT_CMD_UDATE_cmd},
+	[AT_PREPASS_EN] = { "AT+PREPASS_EN",   13, bMGR_AT_CMD_PREPASS_EN_cmd},
+	[AT_UDATE]      = { "AT+UDATE",         8, bMGR_AT_CMD_UDATE_cmd},
 
 	/**< MAC commands (not functionnal, only to avoid GUI to crash) */
-	{ "AT+KMAC",          7, bMGR_AT_CMD_KMAC_cmd},
+	[AT_KMAC]       = { "AT+KMAC",          7, bMGR_AT_CMD_KMAC_cmd},
 };
 
 /**
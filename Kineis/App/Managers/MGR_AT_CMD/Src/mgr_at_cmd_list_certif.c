@@ -23,35 +23,17 @@
 #include "mgr_at_cmd_common.h"
 #include "mgr_log.h"
 #include "kns_assert.h" // for kns_assert only
+#include "kns_os.h" // for deferred work
 
 /* Defines -------------------------------------------------------------------------------------- */
 
 #define SUPPORT_MW_WITH_DELAYED_RETX
 #ifdef SUPPORT_MW_WITH_DELAYED_RETX
-#include "kns_app_conf.h"
-#include INCLUDE_NOP_H // for __NOP()
-
-/** @note Define a delay macro which does not depend on systick interrupt in a way to be able to run
- * from any ISR (e.g. turn ON PA wrapper below will be called from SUBGHZ ISR during continuous
- * modulated wave)
- *
- * @attention at typical 32MHz clock and 4 instruction cycle per loop, max value is 536870 ms
- *
- * NOP             : 1 cycle
- * SUBS R3, #1     : 1 cycle
- * CMP  R3, #0     : 1 cycle
- * BNE  <ADDR>     : 1 cycle
+/** @note Delay between bursts runs on a software timer (MCU_TIM_SW_CERTIF_REP) instead of
+ * busy-waiting, thus it is not blocking any ISR (e.g. end of TX callback called from SUBGHZ ISR
+ * during continuous modulated wave)
  */
-//#define DELAY_MS(time_ms) HAL_Delay(time_ms)
-extern uint32_t SystemCoreClock;
-#define FOR_LOOP_CYCLE_NB 4
-#define DELAY_MS(time_ms) \
-{ \
-	uint32_t _nb_for_loop_per_ms = SystemCoreClock / 1000 / FOR_LOOP_CYCLE_NB; \
-	for (uint32_t _count = time_ms * _nb_for_loop_per_ms; \
-		_count > 0 ; \
-		_count--) __NOP(); \
-}
+#include "mcu_tim.h"
 #endif
 
 /* Private type ----------------------------------------------------------------------------------*/
@@ -114,6 +96,31 @@ static bool MGR_AT_CMD_sendRandomTxData(struct KNS_tx_rf_cfg_t *rf_cfg);
 
 /* Private functions ---------------------------------------------------------*/
 
+#if defined(SUPPORT_MW_WITH_DELAYED_RETX) && !defined(KNS_RF_IN_BLOCKING_MODE)
+/** @brief  Send next modulated wave burst, run from Kineis OS deferred work
+ *
+ * @param[in] ctx: unused
+ */
+static void eoAtMWRep_work(void *ctx)
+{
+	/** Modulated wave may have been stopped meanwhile */
+	if (mw_cfg.valid == true)
+		MGR_AT_CMD_sendRandomTxData(NULL);
+}
+
+/** @brief  Callback function notifying end of delay between two modulated wave bursts
+ *
+ * Next burst is sent out of ISR context from Kineis OS deferred work.
+ *
+ * @attention This callback fct is called from timer ISR context.
+ */
+static void eoAtMWRep_isr_cb(void)
+{
+	if (KNS_OS_postWork(eoAtMWRep_work, NULL) != KNS_STATUS_OK)
+		eoAtMWRep_work(NULL);
+}
+#endif
+
 /** @brief  Log array of uint8_t
  * @param[in] data: pointer to table
  * @param[in] len: number of bytes to log from the table
@@ -129,36 +136,53 @@ static void MGR_LOG_array(__attribute__((unused)) uint8_t *data, uint16_t len)
 }
 
 #ifndef KNS_RF_IN_BLOCKING_MODE
+/** @brief  Power off RF and re-transmit UL bitstream, run from Kineis OS deferred work
+ *
+ * @param[in] ctx: unused
+ */
+static void eoAtMW_work(void *ctx)
+{
+	/** Modulated wave may have been stopped meanwhile */
+	if (mw_cfg.valid == false)
+		return;
+
+	isToBeTransmit = false;
+	KNS_RFTX_powerOff(NULL);
+#ifdef SUPPORT_MW_WITH_DELAYED_RETX
+	if (repPeriod_s > 1)
+		mw_cfg.isRfAlreadyOn = false; // clear to force TCXOWU again
+	if (repPeriod_s != 0) {
+		/** Next burst is sent from timer callback */
+		if (MCU_TIM_swStart(MCU_TIM_SW_CERTIF_REP, repPeriod_s * 1000,
+		    eoAtMWRep_isr_cb) != MCU_TIM_STATUS_OK)
+			MGR_LOG_DEBUG("[ERROR] MW: cannot start repetition timer\r\n");
+		return;
+	}
+#endif
+	if (!MGR_AT_CMD_sendRandomTxData(NULL))
+		MGR_LOG_DEBUG("[ERROR] MW: cannot start next burst\r\n");
+}
+
 /** @brief  Callback function notifying end of TX processing in case of modulated wave
  *
  * Its purpose is to re-transmit UL bitstream as soon as previous transmission is complete. It will
  * lead to a kind of continuous flow of TX bursts.
  *
- * @attention This callback fct is called from ISR context so far. Limit inner processing if
- * application is realtime critical. In case of realtime critical application, suggest to post/copy
- * the event to background task
+ * RF power off and next burst are posted to Kineis OS deferred work so that this callback stays
+ * short. If the work queue is full, they are processed in place.
+ *
+ * @attention This callback fct is called from ISR context so far.
  *
  * @param[in] evt: callback event context
  *
- * @retval KNS_STATUS_OK if TX DONE or KNS_STATUS_TIMEOUT if timeout reached, KNS_STATUS_ERROR
- *         otherwise
+ * @retval KNS_STATUS_OK
  */
 static enum KNS_status_t eoAtMW_isr_cb(struct KNS_RF_evt_t *evt)
 {
 	/** Start new TX if continuous wave is still requested */
 	if ((evt->id == TX_DONE) && (mw_cfg.valid == true)) {
-		isToBeTransmit = false;
-		KNS_RFTX_powerOff(NULL);
-#ifdef SUPPORT_MW_WITH_DELAYED_RETX
-		if (repPeriod_s > 1)
-			mw_cfg.isRfAlreadyOn = false; // clear to force TCXOWU again
-		if (repPeriod_s != 0)
-			DELAY_MS(repPeriod_s * 1000);
-#endif
-		if (MGR_AT_CMD_sendRandomTxData(NULL))
-			return KNS_STATUS_OK;
-		else
-			return KNS_STATUS_ERROR;
+		if (KNS_OS_postWork(eoAtMW_work, NULL) != KNS_STATUS_OK)
+			eoAtMW_work(NULL);
 	}
 
 	return KNS_STATUS_OK;
@@ -454,8 +478,13 @@ bool bMGR_AT_CMD_CW_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mo
 #ifdef SUPPORT_MW_WITH_DELAYED_RETX
 			if (repPeriod_s > 1)
 				mw_cfg.isRfAlreadyOn = false; // clear to force TCXOWU again
-			if (repPeriod_s != 0)
-				DELAY_MS(repPeriod_s * 1000);
+			if (repPeriod_s != 0) {
+				MCU_TIM_swStart(MCU_TIM_SW_CERTIF_REP, repPeriod_s * 1000, NULL);
+				while (MCU_TIM_swIsRunning(MCU_TIM_SW_CERTIF_REP) &&
+				       !MGR_AT_CMD_isPendingAt())
+					;
+				MCU_TIM_swStop(MCU_TIM_SW_CERTIF_REP);
+			}
 #endif
 			bool_status = MGR_AT_CMD_sendRandomTxData(NULL);
 		};
@@ -474,6 +503,10 @@ bool bMGR_AT_CMD_CW_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mo
 			mw_cfg.valid = false;
 			mw_cfg.isRfAlreadyOn = false;
 		}
+#ifdef SUPPORT_MW_WITH_DELAYED_RETX
+		/** Cancel next burst if waiting for repetition delay */
+		MCU_TIM_swStop(MCU_TIM_SW_CERTIF_REP);
+#endif
 		switch (mw_cfg.rf_cfg.modulation) {
 		case KNS_TX_MOD_LDA2:
 		case KNS_TX_MOD_LDA2L:
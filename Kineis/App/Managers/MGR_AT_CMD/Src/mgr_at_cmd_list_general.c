@@ -12,6 +12,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
+#include <inttypes.h>
 #include <string.h>
 
 #include "kns_types.h"
@@ -30,6 +31,8 @@
 #include "mgr_log.h"
 #include "mcu_nvm.h"
 #include "mcu_aes.h"
+#include "kns_q.h"
+#include "mcu_prof.h"
 
 
 /* Functions -----------------------------------------------------------------*/
@@ -323,45 +326,101 @@ bool bMGR_AT_CMD_LPM_cmd(uint8_t *pu8_cmdParamString __attribute__((unused)),
 	return false;
 }
 
-bool bMGR_AT_CMD_TCXO_cmd(uint8_t *pu8_cmdParamString __attribute__((unused)),
-	enum atcmd_type_t e_exec_mode)
+bool bMGR_AT_CMD_TCXO_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode)
 {
+	int16_t scanParamRes;
 	uint32_t tcxo_ms;
+	uint32_t hold_ms;
+	uint32_t measured_ms;
+
 	if (e_exec_mode == ATCMD_STATUS_MODE) {
 		MCU_MISC_TCXO_get_warmup(&tcxo_ms);
-		MCU_AT_CONSOLE_send("+TCXO=%d\r\n", tcxo_ms);
+		MCU_MISC_TCXO_get_hold(&hold_ms);
+		MCU_MISC_TCXO_get_measured_warmup(&measured_ms);
+		MCU_AT_CONSOLE_send("+TCXO=%lu,%lu,%lu\r\n", tcxo_ms, hold_ms, measured_ms);
 		return true;
 	} else if (e_exec_mode == ATCMD_ACTION_MODE) {
-		uint16_t nbChar;
-		while(pu8_cmdParamString[strlen((char*)pu8_cmdParamString) - 1] == '\r' ||
-				pu8_cmdParamString[strlen((char*)pu8_cmdParamString) - 1] == '\n')
-		{
-			pu8_cmdParamString[strlen((char*)pu8_cmdParamString) - 1] = '\0';
+		MGR_LOG_DEBUG("%s", __func__);
+		/** Hold time is optional, keep current one if missing */
+		MCU_MISC_TCXO_get_hold(&hold_ms);
+		scanParamRes = sscanf((const char *)pu8_cmdParamString,
+			(const char *)"AT+TCXO_WU=%" SCNu32 ",%" SCNu32, &tcxo_ms, &hold_ms);
+		if (scanParamRes < 1)
+			return bMGR_AT_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT);
+
+		if (tcxo_ms > 30000) {
+			MGR_LOG_DEBUG("[ERROR] Invalid TCXO Warmup time, should be less than 30 000ms\r\n");
+			return bMGR_AT_CMD_logFailedMsg(ERROR_INCOMPATIBLE_VALUE);
+		}
+		if (hold_ms > MCU_MISC_TCXO_HOLD_MAX_MS) {
+			MGR_LOG_DEBUG("[ERROR] Invalid TCXO hold time, max value is %d ms\r\n",
+				MCU_MISC_TCXO_HOLD_MAX_MS);
+			return bMGR_AT_CMD_logFailedMsg(ERROR_INCOMPATIBLE_VALUE);
 		}
 
-			MGR_LOG_DEBUG("%s",__func__);
-			nbChar = strlen((char*)pu8_cmdParamString+11);
-			if (nbChar > 5)
-			{
-				MGR_LOG_DEBUG("[ERROR] Invalid TCXO MS length, max value is 30 000ms\r\n");	
-				return bMGR_AT_CMD_logFailedMsg(ERROR_INCOMPATIBLE_VALUE);
-			}
-			
-			u16MGR_AT_CMD_convertAsciiToInt32(pu8_cmdParamString + 11, &tcxo_ms);
+		MCU_MISC_TCXO_set_warmup(tcxo_ms);
+		MCU_MISC_TCXO_set_hold(hold_ms);
+		return bMGR_AT_CMD_logSucceedMsg();
+	} else {
+		return bMGR_AT_CMD_logFailedMsg(ERROR_UNKNOWN_AT_CMD);
+	}
+}
 
-			if (tcxo_ms > 30000)
-			{
-				MGR_LOG_DEBUG("[ERROR] Invalid ID TCXO Warmup time, should be less than 30 000ms\r\n");
-				return bMGR_AT_CMD_logFailedMsg(ERROR_INCOMPATIBLE_VALUE);
-			}
+bool bMGR_AT_CMD_QSTAT_cmd(uint8_t *pu8_cmdParamString __attribute__((unused)),
+	enum atcmd_type_t e_exec_mode)
+{
+	struct KNS_Q_stats_t stats;
+	enum KNS_Q_handle_t qHandle;
 
-			MCU_MISC_TCXO_set_warmup(tcxo_ms);
-			return bMGR_AT_CMD_logSucceedMsg();	
+	if (e_exec_mode == ATCMD_STATUS_MODE) {
+		for (qHandle = 0; qHandle < KNS_Q_MAX; qHandle++) {
+			KNS_Q_getStats(qHandle, &stats);
+			MCU_AT_CONSOLE_send("+QSTAT=%d,%d,%d,%d,%lu,%lu,%lu,%lu\r\n", qHandle,
+				stats.capacity, stats.depth, stats.hwm, stats.pushCnt, stats.popCnt,
+				stats.qfullCnt, stats.maxResidenceMs);
+		}
+		return true;
+	} else if (e_exec_mode == ATCMD_ACTION_MODE) {
+		KNS_Q_resetStats();
+		return bMGR_AT_CMD_logSucceedMsg();
 	} else {
 		return bMGR_AT_CMD_logFailedMsg(ERROR_UNKNOWN_AT_CMD);
 	}
 }
 
+#ifdef USE_MCU_PROF
+bool bMGR_AT_CMD_PROF_cmd(uint8_t *pu8_cmdParamString __attribute__((unused)),
+	enum atcmd_type_t e_exec_mode)
+{
+	struct MCU_PROF_stats_t stats;
+	enum MCU_PROF_slot_t slot;
+	uint32_t totalHi;
+	uint32_t totalLo;
+
+	if (e_exec_mode == ATCMD_STATUS_MODE) {
+		for (slot = 0; slot < MCU_PROF_SLOT_MAX; slot++) {
+			MCU_PROF_getStats(slot, &stats);
+			/** printf from nano lib does not support 64-bit integers, split in decimal */
+			totalHi = (uint32_t)(stats.totalCyc / 1000000000ULL);
+			totalLo = (uint32_t)(stats.totalCyc % 1000000000ULL);
+			if (totalHi != 0)
+				MCU_AT_CONSOLE_send("+PROF=%s,%lu,%lu%09lu,%lu\r\n",
+					MCU_PROF_getName(slot), stats.callCnt, totalHi, totalLo,
+					stats.maxCyc);
+			else
+				MCU_AT_CONSOLE_send("+PROF=%s,%lu,%lu,%lu\r\n", MCU_PROF_getName(slot),
+					stats.callCnt, totalLo, stats.maxCyc);
+		}
+		return true;
+	} else if (e_exec_mode == ATCMD_ACTION_MODE) {
+		MCU_PROF_reset();
+		return bMGR_AT_CMD_logSucceedMsg();
+	} else {
+		return bMGR_AT_CMD_logFailedMsg(ERROR_UNKNOWN_AT_CMD);
+	}
+}
+#endif
+
 /**
  * @}
  */
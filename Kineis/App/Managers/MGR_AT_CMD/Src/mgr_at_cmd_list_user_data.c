@@ -24,11 +24,36 @@
 #include KINEIS_SW_ASSERT_H
 #include "mgr_log.h"
 #include "mcu_misc.h"
+#include "mgr_at_cmd.h"
+#include "mcu_at_console.h"
 
 #include "main.h"
 
 /* Private macro -------------------------------------------------------------*/
 
+/** Maximum number of hex characters of AT+TX user data. Last byte of the data field is only half
+ * used by Kineis protocols (e.g. 24.5 bytes for LDA2, 632.5 bytes for HDA4).
+ *
+ * @attention AT+TX cmd length shall not be longer than the length defined by FRAME_MAX_LEN.
+ */
+#define MGR_AT_CMD_TX_DATA_MAX_CHAR ((USERDATA_TX_DATAFIELD_SIZE * 2) - 1)
+
+/** Maximum number of items of AT+TXBATCH, as many as USERDATA elements */
+#define MGR_AT_CMD_TXBATCH_MAX_ITEM USERDATA_TX_FIFO_SIZE
+
+/** Size of the CRC-16 ending AT+TXB raw block */
+#define MGR_AT_CMD_TXB_CRC_SIZE 2
+
+/* Private variables ----------------------------------------------------------*/
+
+/** User data elements accepted but not pushed to MAC yet, in submission order. They wait for RF
+ * power-up, or for some room in APP2MAC queue.
+ */
+static struct sUserDataTxFifoElt_t *s_apPendingElt[USERDATA_TX_FIFO_SIZE];
+static uint8_t s_u8PendingNb;
+/** RF power-up is on-going, pending elements are pushed once it is over */
+static bool s_bRfWaiting;
+
 /* Private functions ----------------------------------------------------------*/
 
 /** @brief  Set/clear a GPIO around transmission
@@ -102,9 +127,219 @@ static enum ERROR_RETURN_T convKnsStatusToAtErr(enum KNS_status_t knsStatus)
 	}
 }
 
-/** @brief Handle new TX data, this is the core function of AT+TX cmd
+/** @brief Check AT cmd parameter string is over
+ *
+ * @param[in] u8_c: character to check
+ *
+ * @return true if character is an end-of-line or end-of-string
+ */
+static bool bMGR_AT_CMD_isParamEnd(uint8_t u8_c)
+{
+	return ((u8_c == '\r') || (u8_c == '\n') || (u8_c == '\0'));
+}
+
+/** @brief Parse optional attribute field of AT+TX cmd (",0x<hex>")
+ *
+ * @param[in] pu8_param: pointer to the character following user data
+ * @param[out] pu8Attr: attribute, default one (0x00, i.e. no service) if field is absent
+ *
+ * @return pointer to the character following attribute field (same as pu8_param if absent), NULL
+ *         if attribute field is badly formatted
+ */
+static const uint8_t *pu8MGR_AT_CMD_parseTxAttr(const uint8_t *pu8_param,
+	union sUserDataAttribute_t *pu8Attr)
+{
+	uint8_t u8_nibbleNb;
+	uint8_t u8_nibble;
+
+	pu8Attr->u8_raw = 0x0; /* default attribute to data, no service */
+
+	if (pu8_param[0] != ',')
+		return pu8_param;
+
+	if ((pu8_param[1] != '0') || ((pu8_param[2] != 'x') && (pu8_param[2] != 'X')))
+		return NULL;
+	pu8_param += 3;
+
+	/* Attribute is one byte, up to 2 hex digits */
+	for (u8_nibbleNb = 0; u8_nibbleNb < 2; u8_nibbleNb++) {
+		u8_nibble = u8UTIL_convertCharToHex4bits(pu8_param[u8_nibbleNb]);
+		if (u8_nibble == HEX_DEC_4BIT_CONVERSION_FAILED_CODE)
+			break;
+		pu8Attr->u8_raw = (pu8Attr->u8_raw << 4) | u8_nibble;
+	}
+
+	if (u8_nibbleNb == 0)
+		return NULL;
+	return pu8_param + u8_nibbleNb;
+}
+
+/** @brief Queue a filled-up user data element for transmission
+ *
+ * The APP2MAC slot is reserved first, so that user data element is only added once the MAC event
+ * can be sent. Element is left reserved on failure.
+ *
+ * @param[in] spUserDataMsg: reserved element, with data, bit length and attribute set
+ *
+ * @return ERROR_NO if element is queued, AT cmd error code otherwise
+ */
+static enum ERROR_RETURN_T eMGR_AT_CMD_queueTxElt(struct sUserDataTxFifoElt_t *spUserDataMsg)
+{
+	enum KNS_status_t status;
+	struct KNS_MAC_appEvt_t *appEvt;
+
+	status = KNS_Q_reserve(KNS_Q_DL_APP2MAC, (void **)&appEvt);
+	switch (status) {
+	case KNS_STATUS_QFULL:
+		return ERROR_DATA_QUEUE_FULL;
+	break;
+	default:
+		return ERROR_UNKNOWN;
+	break;
+	case KNS_STATUS_OK:
+	break;
+	}
+
+	kns_assert(USERDATA_txFifoAddElt(spUserDataMsg, true));
+
+	/** Fill-up MAC event directly in queue slot */
+	appEvt->id = KNS_MAC_SEND_DATA;
+	memcpy(appEvt->data_ctxt.usrdata, spUserDataMsg->u8DataBuf,
+		sizeof(appEvt->data_ctxt.usrdata));
+	appEvt->data_ctxt.usrdata_bitlen = spUserDataMsg->u16DataBitLen;
+	appEvt->data_ctxt.sf =
+		(enum KNS_serviceFlag_t)(spUserDataMsg->u8Attr.sf);
+
+	KNS_Q_commit(KNS_Q_DL_APP2MAC);
+	return ERROR_NO;
+}
+
+/** @brief Push pending user data elements to MAC, in order, as long as APP2MAC has some room
  *
- * @attention This fct assumes user data set by user is multiple of 8 bits.
+ * Called on submission, once RF is ready, and after each MAC event as MAC pops one APP2MAC event
+ * before reporting it. Unexpected errors are reported to the host as they occur, the AT cmd being
+ * already answered.
+ */
+static void MGR_AT_CMD_pushPendingTxElts(void)
+{
+	enum ERROR_RETURN_T eErr;
+
+	while (!s_bRfWaiting && (s_u8PendingNb > 0)) {
+		eErr = eMGR_AT_CMD_queueTxElt(s_apPendingElt[0]);
+		if (eErr == ERROR_DATA_QUEUE_FULL)
+			break; /* keep it pending, retried on next MAC event */
+		if (eErr != ERROR_NO) {
+			s_apPendingElt[0]->bIsToBeTransmit = false; /* release reserved element */
+			MCU_MISC_RF_release();
+			bMGR_AT_CMD_logFailedMsg(eErr);
+		}
+		s_u8PendingNb--;
+		memmove(&s_apPendingElt[0], &s_apPendingElt[1],
+			s_u8PendingNb * sizeof(s_apPendingElt[0]));
+	}
+}
+
+/** @brief Drop pending user data elements, as TX FIFO is flushed
+ *
+ * RF ready callback may never come once the last RF user is gone (\ref MCU_MISC_RF_release), so
+ * stop waiting for it. Next submission acquires RF again.
+ */
+static void MGR_AT_CMD_flushPendingTxElts(void)
+{
+	for (; s_u8PendingNb > 0; s_u8PendingNb--) {
+		s_apPendingElt[s_u8PendingNb - 1]->bIsToBeTransmit = false;
+		MCU_MISC_RF_release();
+	}
+	s_bRfWaiting = false;
+}
+
+/** @brief RF is ready, push user data elements decoded during its power-up to MAC, in order */
+static void MGR_AT_CMD_rfReadyCb(void)
+{
+	s_bRfWaiting = false;
+	MGR_AT_CMD_pushPendingTxElts();
+}
+
+/** @brief Submit a filled-up user data element for transmission, without waiting for RF
+ *
+ * Each element holds the RF until it leaves the TX FIFO (\ref MGR_AT_CMD_releaseTxElt).
+ * Element is pushed to MAC right away if RF is ready (TCXO warm, PA powered) and APP2MAC queue has
+ * some room. Else it stays pending, and is pushed once RF power-up is over
+ * (\ref MGR_AT_CMD_rfReadyCb) or MAC has consumed some event (\ref MGR_AT_CMD_macEvtProcess).
+ * Elements submitted during the same power-up share it.
+ *
+ * Thus, as long as a USERDATA element could be reserved, the element is accepted.
+ *
+ * @param[in] spUserDataMsg: reserved element, with data, bit length and attribute set
+ *
+ * @return ERROR_NO, element being queued or pending
+ */
+static enum ERROR_RETURN_T eMGR_AT_CMD_submitTxElt(struct sUserDataTxFifoElt_t *spUserDataMsg)
+{
+	if (!MCU_MISC_RF_acquire(MGR_AT_CMD_rfReadyCb))
+		s_bRfWaiting = true;
+
+	/* Each pending element is a reserved one, thus pending list cannot overflow */
+	kns_assert(s_u8PendingNb < USERDATA_TX_FIFO_SIZE);
+	s_apPendingElt[s_u8PendingNb++] = spUserDataMsg;
+	MGR_AT_CMD_pushPendingTxElts();
+	return ERROR_NO;
+}
+
+/** @brief Free a user data element notified to the host, and release its RF hold
+ *
+ * TCXO is kept warm for next transmission, see \ref MCU_MISC_RF_release.
+ *
+ * @param[in] spUserDataMsg: element to be removed from TX FIFO
+ */
+static void MGR_AT_CMD_releaseTxElt(struct sUserDataTxFifoElt_t *spUserDataMsg)
+{
+	if (USERDATA_txFifoRemoveElt(spUserDataMsg))
+		MCU_MISC_RF_release();
+}
+
+/** @brief Decode one "<HexData>[,0x<Attr>]" item straight into a reserved element, as binary
+ *
+ * It only checks incoming data is not exceeding \ref MGR_AT_CMD_TX_DATA_MAX_CHAR hex characters.
+ *
+ * @param[in,out] ppu8_param: pointer to the item, set to the character following the item
+ * @param[out] spUserDataMsg: reserved element, data, bit length and attribute are set
+ *
+ * @return ERROR_NO if item is valid, AT cmd error code otherwise
+ */
+static enum ERROR_RETURN_T eMGR_AT_CMD_decodeTxItem(const uint8_t **ppu8_param,
+	struct sUserDataTxFifoElt_t *spUserDataMsg)
+{
+	const uint8_t *pu8_param = *ppu8_param;
+	uint16_t u16UserDataCharNb;
+
+	/** Decode up to max length, data is too long if a hex char still follows (checked below) */
+	u16UserDataCharNb = u16UTIL_convertHexStringToBin(pu8_param,
+		MGR_AT_CMD_TX_DATA_MAX_CHAR, spUserDataMsg->u8DataBuf);
+	pu8_param += u16UserDataCharNb;
+	MGR_LOG_VERBOSE("[%s %d] %d\r\n", __func__, __LINE__, u16UserDataCharNb);
+
+	if (u16UserDataCharNb == 0) {
+		/* Case ARGOS Message without user data */
+		MGR_LOG_VERBOSE("[ERROR] AT+TX command is badly formatted\r\n");
+		return ERROR_MISSING_PARAMETERS;
+	}
+	if (u8UTIL_convertCharToHex4bits(*pu8_param) != HEX_DEC_4BIT_CONVERSION_FAILED_CODE) {
+		MGR_LOG_VERBOSE("[ERROR] User data is badly formatted (check length)\r\n");
+		return ERROR_INVALID_USER_DATA_LENGTH;
+	}
+	pu8_param = pu8MGR_AT_CMD_parseTxAttr(pu8_param, &spUserDataMsg->u8Attr);
+	if (pu8_param == NULL) {
+		MGR_LOG_VERBOSE("[ERROR] AT+TX attribute is badly formatted\r\n");
+		return ERROR_PARAMETER_FORMAT;
+	}
+
+	spUserDataMsg->u16DataBitLen = u16UserDataCharNb * 4;
+	*ppu8_param = pu8_param;
+	return ERROR_NO;
+}
+
+/** @brief Handle new TX data, this is the core function of AT+TX cmd
  *
  * This fct is sensible from security point of view, as it is USER entry. It should be robust to
  * overflow.
@@ -113,140 +348,211 @@ static enum ERROR_RETURN_T convKnsStatusToAtErr(enum KNS_status_t knsStatus)
  *  * for A4 VLD protocols: 24 bits
  * All this will be checked in details in lower-layer frame formating.
  *
- * Here, at AT cmd and USERDATA level, it only checks incoming data is not exceeding the USERDATA
- * buffer size.
+ * Here, at AT cmd and USERDATA level, user data are decoded in a single pass from the AT cmd line
+ * straight into the USERDATA element, as binary (\ref eMGR_AT_CMD_decodeTxItem).
  *
  * @param[in] pu8_cmdParamString: string containing AT command
- * @param[in] pcAtCmdPattern: AT command pattern to parse
  *
  * @return true if data is correctly processed, else otherwise
  */
-static bool bMGR_AT_CMD_handleNewTxData(uint8_t *pu8_cmdParamString, const char *pcAtCmdPattern)
+static bool bMGR_AT_CMD_handleNewTxData(uint8_t *pu8_cmdParamString)
 {
-	enum KNS_status_t status = KNS_STATUS_OK;
 	struct sUserDataTxFifoElt_t *spUserDataMsg;
-	union sUserDataAttribute_t u8UserDataAttr;
-	uint8_t *pu8UserDataBuf;
-	int16_t i16_scan_param_res;
-	uint16_t u16UserDataCharNb;
-	uint16_t u16UserDataBitlen;
-	uint16_t idx;
-
-//	enum KNS_status_t knsStatus;
-	struct KNS_MAC_appEvt_t appEvt = {
-		.id = KNS_MAC_SEND_DATA,
-		.data_ctxt = {
-			.usrdata = {0},
-			.usrdata_bitlen = 0,      /* to be filled-up later below */
-			.sf = KNS_SF_NO_SERVICE,
-		}
-	};
+	const uint8_t *pu8_param;
+	enum ERROR_RETURN_T eErr;
+
+	/** User data start right after "AT+TX=" */
+	pu8_param = pu8_cmdParamString + sizeof("AT+TX") - 1;
+	if (*pu8_param != '=') {
+		MGR_LOG_VERBOSE("[ERROR] AT+TX command is badly formatted\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_MISSING_PARAMETERS);
+	}
+	pu8_param++;
 
-	MCU_MISC_TCXO_Force_State(true);
-	uint32_t tcxo_warmup_ms = 0;
-	MCU_MISC_TCXO_get_warmup(&tcxo_warmup_ms);
-	HAL_Delay(tcxo_warmup_ms);
 	spUserDataMsg = USERDATA_txFifoReserveElt();
-	if (spUserDataMsg != NULL) {
+	if (spUserDataMsg == NULL) {
+		MGR_LOG_VERBOSE("[ERROR] TX FIFO full, cannot get extra data.\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_DATA_QUEUE_FULL);
+	}
 
-		for (idx = 0; idx < sizeof(spUserDataMsg->u8DataBuf); idx++)
-			spUserDataMsg->u8DataBuf[idx] = 0;
-		pu8UserDataBuf =  spUserDataMsg->u8DataBuf;
-		kns_assert(pu8UserDataBuf != NULL);
+	eErr = eMGR_AT_CMD_decodeTxItem(&pu8_param, spUserDataMsg);
+	if ((eErr == ERROR_NO) && !bMGR_AT_CMD_isParamEnd(*pu8_param))
+		eErr = ERROR_PARAMETER_FORMAT;
+	if (eErr != ERROR_NO) {
+		spUserDataMsg->bIsToBeTransmit = false; /* release reserved element */
+		return bMGR_AT_CMD_logFailedMsg(eErr);
+	}
 
+	eErr = eMGR_AT_CMD_submitTxElt(spUserDataMsg);
+	if (eErr != ERROR_NO)
+		return bMGR_AT_CMD_logFailedMsg(eErr);
+	return true;
+}
 
-		/** Extract USER DATA from pu8_cmdParamString */
-		i16_scan_param_res = sscanf((const char *)pu8_cmdParamString, pcAtCmdPattern,
-					    pu8UserDataBuf,
-					    &u8UserDataAttr.u8_raw);
-		u16UserDataCharNb = strlen((const char *)pu8UserDataBuf);
-		MGR_LOG_VERBOSE("[%s %d] %d %d\r\n", __func__, __LINE__, i16_scan_param_res, u16UserDataCharNb);
+/** @brief Handle a batch of TX data, this is the core function of AT+TXBATCH cmd
+ *
+ * Items are "<HexData>[,0x<Attr>]" separated by ';', same as AT+TX. Compared to as many AT+TX:
+ * * TCXO is requested once for the whole batch, items waiting for its warm-up together,
+ * * USERDATA elements are reserved at once, items beyond free elements are rejected,
+ * * each valid item is then pushed to MAC as APP2MAC queue has some room, the others staying
+ *   pending meanwhile (\ref eMGR_AT_CMD_submitTxElt),
+ * * a single "+TXBATCH=<acceptedNb>,<err1>,...,<errN>" response gives status of each item.
+ *
+ * @param[in] pu8_cmdParamString: string containing AT command
+ *
+ * @return true if at least one item is accepted, false otherwise
+ */
+static bool bMGR_AT_CMD_handleNewTxBatch(uint8_t *pu8_cmdParamString)
+{
+	struct sUserDataTxFifoElt_t *aspUserDataMsg[MGR_AT_CMD_TXBATCH_MAX_ITEM];
+	enum ERROR_RETURN_T aeItemErr[MGR_AT_CMD_TXBATCH_MAX_ITEM];
+	const uint8_t *pu8_param;
+	const uint8_t *pu8_scan;
+	uint8_t u8_itemNb = 1;
+	uint8_t u8_reservedNb;
+	uint8_t u8_acceptedNb = 0;
+	uint8_t u8_item;
+
+	/** Items start right after "AT+TXBATCH=" */
+	pu8_param = pu8_cmdParamString + sizeof("AT+TXBATCH") - 1;
+	if (*pu8_param != '=') {
+		MGR_LOG_VERBOSE("[ERROR] AT+TXBATCH command is badly formatted\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_MISSING_PARAMETERS);
+	}
+	pu8_param++;
+
+	for (pu8_scan = pu8_param; !bMGR_AT_CMD_isParamEnd(*pu8_scan); pu8_scan++)
+		if (*pu8_scan == ';')
+			u8_itemNb++;
+	if (u8_itemNb > MGR_AT_CMD_TXBATCH_MAX_ITEM) {
+		MGR_LOG_VERBOSE("[ERROR] AT+TXBATCH has too many items\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_TOO_MANY_PARAMETERS);
+	}
 
-		/** Assert when the number of characters received from AT command is bigger than
-		 * authorized
-		 */
-		kns_assert(u16UserDataCharNb <= (USERDATA_TX_PAYLOAD_MAX_SIZE -1 ));
+	u8_reservedNb = USERDATA_txFifoReserveElts(aspUserDataMsg, u8_itemNb);
+
+	for (u8_item = 0; u8_item < u8_itemNb; u8_item++) {
+		if (u8_item < u8_reservedNb) {
+			aeItemErr[u8_item] = eMGR_AT_CMD_decodeTxItem(&pu8_param,
+				aspUserDataMsg[u8_item]);
+			if ((aeItemErr[u8_item] == ERROR_NO) && (*pu8_param != ';') &&
+			    !bMGR_AT_CMD_isParamEnd(*pu8_param))
+				aeItemErr[u8_item] = ERROR_PARAMETER_FORMAT;
+			if (aeItemErr[u8_item] == ERROR_NO)
+				aeItemErr[u8_item] = eMGR_AT_CMD_submitTxElt(
+					aspUserDataMsg[u8_item]);
+			else
+				aspUserDataMsg[u8_item]->bIsToBeTransmit = false; /* release */
+		} else
+			aeItemErr[u8_item] = ERROR_DATA_QUEUE_FULL;
+
+		if (aeItemErr[u8_item] == ERROR_NO)
+			u8_acceptedNb++;
+
+		/** Go to next item, whatever the status of this one */
+		while ((*pu8_param != ';') && !bMGR_AT_CMD_isParamEnd(*pu8_param))
+			pu8_param++;
+		if (*pu8_param == ';')
+			pu8_param++;
+	}
 
-		switch (i16_scan_param_res) {
-		case 1:/** Case ARGOS Message with user data only */
-			u8UserDataAttr.u8_raw = 0x0; /* default attribute to data, no service */
-		case 2:/** Case ARGOS Message with user data + optional attribute:
-			 * User data should be converted form string format to Hex format
-			 */
-			u16UserDataBitlen = u16MGR_AT_CMD_convertAsciiBinary(pu8UserDataBuf,
-									     u16UserDataCharNb);
-			if (u16UserDataBitlen <= (USERDATA_TX_DATAFIELD_SIZE * 8)) {
-				spUserDataMsg->u16DataBitLen = u16UserDataBitlen;
-				spUserDataMsg->u8Attr = u8UserDataAttr;
-				kns_assert(USERDATA_txFifoAddElt(spUserDataMsg, true));
-
-				for (idx = 0; idx < sizeof(appEvt.data_ctxt.usrdata); idx++)
-					appEvt.data_ctxt.usrdata[idx] =
-						spUserDataMsg->u8DataBuf[idx];
-				appEvt.data_ctxt.usrdata_bitlen = spUserDataMsg->u16DataBitLen;
-				appEvt.data_ctxt.sf =
-					(enum KNS_serviceFlag_t)(spUserDataMsg->u8Attr.sf);
-
-				/** @note appEvt.send_ctxt already filled-up at declaration */
-				appEvt.id = KNS_MAC_SEND_DATA;
-				status = KNS_Q_push(KNS_Q_DL_APP2MAC, (void *)&appEvt);
-				switch (status) {
-				case KNS_STATUS_QFULL:
-					return bMGR_AT_CMD_logFailedMsg(ERROR_DATA_QUEUE_FULL);
-				break;
-				default:
-					return bMGR_AT_CMD_logFailedMsg(ERROR_UNKNOWN);
-				break;
-				case KNS_STATUS_OK:
-					return true;
-				break;
-				}
-			}
-			MGR_LOG_VERBOSE("[ERROR] User data is badly formatted (check length)\r\n");
-			return bMGR_AT_CMD_logFailedMsg(ERROR_INVALID_USER_DATA_LENGTH);
-		case 0: /* Case ARGOS Message without user data */
-		default:
-			MGR_LOG_VERBOSE("[ERROR] AT+TX command is badly formatted\r\n");
-			return bMGR_AT_CMD_logFailedMsg(ERROR_MISSING_PARAMETERS);
-		}
-	} else {
+	MCU_AT_CONSOLE_send("+TXBATCH=%d", u8_acceptedNb);
+	for (u8_item = 0; u8_item < u8_itemNb; u8_item++)
+		MCU_AT_CONSOLE_send(",%d", aeItemErr[u8_item]);
+	MCU_AT_CONSOLE_send("\r\n");
+
+	return (u8_acceptedNb > 0);
+}
+
+/** @brief Handle new binary TX data, this is the core function of AT+TXB cmd
+ *
+ * The raw block received after the AT cmd line (data then CRC-16, big endian) is checked, then
+ * copied as is into the USERDATA element. No ASCII decoding at all.
+ *
+ * @param[in] pu8_cmdParamString: string containing AT command, followed by its raw block
+ *
+ * @return true if data is correctly processed, else otherwise
+ */
+static bool bMGR_AT_CMD_handleNewTxbData(uint8_t *pu8_cmdParamString)
+{
+	struct sUserDataTxFifoElt_t *spUserDataMsg;
+	union sUserDataAttribute_t u8UserDataAttr;
+	const uint8_t *pu8_param;
+	const uint8_t *pu8_raw;
+	uint16_t u16_rawLen;
+	uint32_t u32_dataLen = 0;
+	uint16_t u16_crc;
+	enum ERROR_RETURN_T eErr;
+
+	/** Data length starts right after "AT+TXB=" */
+	pu8_param = pu8_cmdParamString + sizeof("AT+TXB") - 1;
+	if (*pu8_param != '=') {
+		MGR_LOG_VERBOSE("[ERROR] AT+TXB command is badly formatted\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_MISSING_PARAMETERS);
+	}
+	pu8_param++;
+	if ((*pu8_param < '0') || (*pu8_param > '9')) {
+		MGR_LOG_VERBOSE("[ERROR] AT+TXB data length is badly formatted\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT);
+	}
+	for (; (*pu8_param >= '0') && (*pu8_param <= '9'); pu8_param++)
+		if (u32_dataLen <= UINT16_MAX)
+			u32_dataLen = (u32_dataLen * 10) + (*pu8_param - '0');
+	pu8_param = pu8MGR_AT_CMD_parseTxAttr(pu8_param, &u8UserDataAttr);
+	if ((pu8_param == NULL) || !bMGR_AT_CMD_isParamEnd(*pu8_param)) {
+		MGR_LOG_VERBOSE("[ERROR] AT+TXB attribute is badly formatted\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT);
+	}
+	if ((u32_dataLen == 0) || (u32_dataLen > USERDATA_TX_DATAFIELD_SIZE)) {
+		MGR_LOG_VERBOSE("[ERROR] AT+TXB data length is out of range\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_INVALID_USER_DATA_LENGTH);
+	}
+
+	/** Raw block is shorter than announced when it was aborted on timeout or discarded */
+	pu8_raw = MGR_AT_CMD_getRawBlock(pu8_cmdParamString, &u16_rawLen);
+	if (u16_rawLen != (u32_dataLen + MGR_AT_CMD_TXB_CRC_SIZE)) {
+		MGR_LOG_VERBOSE("[ERROR] AT+TXB raw block is truncated\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_INVALID_USER_DATA_LENGTH);
+	}
+	u16_crc = u16UTIL_crc16(UTIL_CRC16_INIT, pu8_raw, u32_dataLen);
+	if (u16_crc != ((pu8_raw[u32_dataLen] << 8) | pu8_raw[u32_dataLen + 1])) {
+		MGR_LOG_VERBOSE("[ERROR] AT+TXB CRC mismatch\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_USER_DATA_CRC);
+	}
+
+	spUserDataMsg = USERDATA_txFifoReserveElt();
+	if (spUserDataMsg == NULL) {
 		MGR_LOG_VERBOSE("[ERROR] TX FIFO full, cannot get extra data.\r\n");
 		return bMGR_AT_CMD_logFailedMsg(ERROR_DATA_QUEUE_FULL);
 	}
+
+	memcpy(spUserDataMsg->u8DataBuf, pu8_raw, u32_dataLen);
+	spUserDataMsg->u16DataBitLen = u32_dataLen * 8;
+	spUserDataMsg->u8Attr = u8UserDataAttr;
+	spUserDataMsg->bIsCrcRsp = true;
+	spUserDataMsg->u16DataCrc = u16_crc;
+	eErr = eMGR_AT_CMD_submitTxElt(spUserDataMsg);
+	if (eErr != ERROR_NO)
+		return bMGR_AT_CMD_logFailedMsg(eErr);
+	return true;
 }
 
 /* Public functions ----------------------------------------------------------*/
 
 uint16_t u16MGR_AT_CMD_convertAsciiBinary(uint8_t *pu8InputBuffer, uint16_t u16_charNb)
 {
-	uint16_t u16_index = 0;
-	uint8_t u8_high, u8_low;
-
-	for (u16_index = 0; u16_index < (u16_charNb / 2); u16_index++) {
-		u8_high = u8UTIL_convertCharToHex4bits(pu8InputBuffer[2 * u16_index]);
-		u8_low = u8UTIL_convertCharToHex4bits(pu8InputBuffer[2 * u16_index + 1]);
-		if ((u8_high != 0xFF) && (u8_low != 0xFF))
-			pu8InputBuffer[u16_index] = (u8_high << 4) | u8_low;
-		else
-			return 0;
-	}
+	uint16_t u16_index;
 
-	/** Case : characters number is an odd number */
-	if (u16_charNb % 2 != 0) {
-		u8_high = u8UTIL_convertCharToHex4bits(pu8InputBuffer[u16_charNb - 1]);
-		u8_low = 0;
-		if (u8_high != 0xFF)
-			pu8InputBuffer[u16_index++] = (u8_high << 4) | u8_low;
-		else
-			return 0;
-	}
+	if (u16UTIL_convertHexStringToBin(pu8InputBuffer, u16_charNb, pu8InputBuffer) !=
+	    u16_charNb)
+		return 0;
 
 	/** Set other bytes to zero */
-	for (; u16_index < u16_charNb; u16_index++)
+	for (u16_index = (u16_charNb + 1) / 2; u16_index < u16_charNb; u16_index++)
 		pu8InputBuffer[u16_index] = 0;
 
 	/** Return data length in bits */
-	return (((u16_charNb / 2) * 8) + ((u16_charNb % 2) ? 4 : 0));
+	return u16_charNb * 4;
 }
 
 
@@ -286,28 +592,37 @@ uint16_t u16MGR_AT_CMD_convertAsciiToInt32(uint8_t *pu8InputBuffer, uint32_t *u3
 
 bool bMGR_AT_CMD_TX_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode)
 {
-	/** @attention pattern length below shall not be longer than the length defined by
-	 * FRAME_MAX_LEN.
-	 *
-	 * So far, here in LDA2 example; limit size to 48 chars, i.e. 24 bytes
-	 */
-#ifdef USE_HDA4
-	static const char cAtCmdPattern[] = "AT+TX=%1265[0-9A-Fa-f],0x%hX";
-#else
-	static const char cAtCmdPattern[] = "AT+TX=%49[0-9A-Fa-f],0x%hX";
-#endif
-
 	if (e_exec_mode == ATCMD_STATUS_MODE) {
 		MGR_LOG_VERBOSE("[ERROR] Status mode is unauthorized for this AT cmd\r\n");
 		return bMGR_AT_CMD_logFailedMsg(ERROR_UNKNOWN_AT_CMD);
 	}
 
-	if (bMGR_AT_CMD_handleNewTxData(pu8_cmdParamString, cAtCmdPattern))
+	if (bMGR_AT_CMD_handleNewTxData(pu8_cmdParamString))
 		return true;
 	else
 		return false;
 }
 
+bool bMGR_AT_CMD_TXB_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode)
+{
+	if (e_exec_mode == ATCMD_STATUS_MODE) {
+		MGR_LOG_VERBOSE("[ERROR] Status mode is unauthorized for this AT cmd\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_UNKNOWN_AT_CMD);
+	}
+
+	return bMGR_AT_CMD_handleNewTxbData(pu8_cmdParamString);
+}
+
+bool bMGR_AT_CMD_TXBATCH_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode)
+{
+	if (e_exec_mode == ATCMD_STATUS_MODE) {
+		MGR_LOG_VERBOSE("[ERROR] Status mode is unauthorized for this AT cmd\r\n");
+		return bMGR_AT_CMD_logFailedMsg(ERROR_UNKNOWN_AT_CMD);
+	}
+
+	return bMGR_AT_CMD_handleNewTxBatch(pu8_cmdParamString);
+}
+
 #ifdef USE_RX_STACK
 bool bMGR_AT_CMD_RX_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode)
 {
@@ -374,31 +689,32 @@ bool bMGR_AT_CMD_RX_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mo
 enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 {
 	enum KNS_status_t cbStatus;
-	struct KNS_MAC_srvcEvt_t srvcEvt;
+	struct KNS_MAC_srvcEvt_t *srvcEvt;
 	struct sUserDataTxFifoElt_t *spUserDataMsg = USERDATA_txFifoGetFirst();
+	uint8_t u8_eltNb;
 
-	cbStatus = KNS_Q_pop(KNS_Q_UL_MAC2APP, (void *)&srvcEvt);
+	/** Read event in place, slot is released once processed */
+	cbStatus = KNS_Q_peek(KNS_Q_UL_MAC2APP, (void **)&srvcEvt);
 
 	if (cbStatus != KNS_STATUS_OK)
 		return cbStatus;
 
 	/** get pointer to user data FIFO element when possible */
-	switch (srvcEvt.id) {
+	switch (srvcEvt->id) {
 	case (KNS_MAC_TX_DONE):
 	case (KNS_MAC_TXACK_DONE):
 	case (KNS_MAC_TX_TIMEOUT):
 	case (KNS_MAC_TXACK_TIMEOUT):
 	case (KNS_MAC_RX_ERROR):
 	case (KNS_MAC_RX_TIMEOUT):
-		spUserDataMsg = USERDATA_txFifoFindPayload(srvcEvt.tx_ctxt.data,
-			srvcEvt.tx_ctxt.data_bitlen);
+		spUserDataMsg = USERDATA_txFifoFindPayload(srvcEvt->tx_ctxt.data,
+			srvcEvt->tx_ctxt.data_bitlen);
 		kns_assert(spUserDataMsg != NULL);
 	break;
 	case (KNS_MAC_ERROR):
-		if (srvcEvt.app_evt == KNS_MAC_SEND_DATA) {
-			spUserDataMsg = USERDATA_txFifoFindPayload(srvcEvt.tx_ctxt.data,
-				srvcEvt.tx_ctxt.data_bitlen);
-			MCU_MISC_TCXO_Force_State(false);
+		if (srvcEvt->app_evt == KNS_MAC_SEND_DATA) {
+			spUserDataMsg = USERDATA_txFifoFindPayload(srvcEvt->tx_ctxt.data,
+				srvcEvt->tx_ctxt.data_bitlen);
 			kns_assert(spUserDataMsg != NULL);
 		}
 	break;
@@ -407,15 +723,14 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 	}
 
 	/** process event */
-	switch (srvcEvt.id) {
+	switch (srvcEvt->id) {
 	case (KNS_MAC_TX_DONE):
 //		MGR_LOG_DEBUG("MGR_AT_CMD TX_DONE callback reached\r\n");
 //		MGR_LOG_DEBUG("TX DONE for usrdata (%d bits = %d bytes + %d bits): 0x",
-//			srvcEvt.tx_ctxt.data_bitlen,
-//			srvcEvt.tx_ctxt.data_bitlen>>3,
-//			srvcEvt.tx_ctxt.data_bitlen&0x07);
-//		MGR_LOG_array(srvcEvt.tx_ctxt.data, (srvcEvt.tx_ctxt.data_bitlen+7)>>3);
-		MCU_MISC_TCXO_Force_State(false);
+//			srvcEvt->tx_ctxt.data_bitlen,
+//			srvcEvt->tx_ctxt.data_bitlen>>3,
+//			srvcEvt->tx_ctxt.data_bitlen&0x07);
+//		MGR_LOG_array(srvcEvt->tx_ctxt.data, (srvcEvt->tx_ctxt.data_bitlen+7)>>3);
 		kns_assert(spUserDataMsg->bIsToBeTransmit);
 		/** Upon TX done of a mail request message, it means some DL_BC was received
 		 * Thus, UL ACK of DL_BC will transmitted by lower layer internally just
@@ -434,7 +749,7 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 			 * * free element from user data buffer.
 			 */
 			bMGR_AT_CMD_sendResponse(ATCMD_RSP_TXOK, (void *)spUserDataMsg);
-			USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+			MGR_AT_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 			Set_TX_LED(0);
 		}
 		cbStatus = KNS_STATUS_OK;
@@ -452,19 +767,17 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 		else
 			bMGR_AT_CMD_sendResponse(ATCMD_RSP_TXACKOK, NULL);
 
-		MCU_MISC_TCXO_Force_State(false);
-		USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+		MGR_AT_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		Set_TX_LED(0);
 		cbStatus = KNS_STATUS_OK;
 	break;
 	case (KNS_MAC_TX_TIMEOUT):
 //		MGR_LOG_DEBUG("MGR_AT_CMD TX_TIMEOUT callback reached\r\n");
 //		MGR_LOG_DEBUG("TX TIMEOUT for usrdata (%d bits = %d bytes + %d bits): 0X",
-//			srvcEvt.tx_ctxt.data_bitlen,
-//			srvcEvt.tx_ctxt.data_bitlen>>3,
-//			srvcEvt.tx_ctxt.data_bitlen&0x07);
-//		MGR_LOG_array(srvcEvt.tx_ctxt.data, (srvcEvt.tx_ctxt.data_bitlen+7)>>3);
-		MCU_MISC_TCXO_Force_State(false);
+//			srvcEvt->tx_ctxt.data_bitlen,
+//			srvcEvt->tx_ctxt.data_bitlen>>3,
+//			srvcEvt->tx_ctxt.data_bitlen&0x07);
+//		MGR_LOG_array(srvcEvt->tx_ctxt.data, (srvcEvt->tx_ctxt.data_bitlen+7)>>3);
 		kns_assert(spUserDataMsg->bIsToBeTransmit);
 		/** @todo Should check integrity between data reported by event above and
 		 * the one stored in user data buffer
@@ -474,16 +787,15 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 		 * * free element from user data buffer.
 		 */
 		bMGR_AT_CMD_sendResponse(ATCMD_RSP_TXNOTOK, (void *)spUserDataMsg);
-		USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+		MGR_AT_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		Set_TX_LED(0);
 		cbStatus = KNS_STATUS_TIMEOUT;
 	break;
 	case (KNS_MAC_TXACK_TIMEOUT):
 //		MGR_LOG_DEBUG("MGR_AT_CMD TXACK_TIMEOUT callback reached\r\n");
-		MCU_MISC_TCXO_Force_State(false);
 		kns_assert(spUserDataMsg->bIsToBeTransmit);
 		bMGR_AT_CMD_sendResponse(ATCMD_RSP_TXACKNOTOK, NULL);
-		USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+		MGR_AT_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		Set_TX_LED(0);
 		cbStatus = KNS_STATUS_TIMEOUT;
 	break;
@@ -491,11 +803,11 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 //		MGR_LOG_DEBUG("MGR_AT_CMD TX callback reached\r\n");
 		if (spUserDataMsg->bIsToBeTransmit) {
 //			MGR_LOG_DEBUG("RX enable ERROR (%d bits = %d bytes + %d bits): 0x",
-//				srvcEvt.tx_ctxt.data_bitlen,
-//				srvcEvt.tx_ctxt.data_bitlen>>3,
-//				srvcEvt.tx_ctxt.data_bitlen&0x07);
-//			MGR_LOG_array(srvcEvt.tx_ctxt.data,
-//				(srvcEvt.tx_ctxt.data_bitlen+7)>>3);
+//				srvcEvt->tx_ctxt.data_bitlen,
+//				srvcEvt->tx_ctxt.data_bitlen>>3,
+//				srvcEvt->tx_ctxt.data_bitlen&0x07);
+//			MGR_LOG_array(srvcEvt->tx_ctxt.data,
+//				(srvcEvt->tx_ctxt.data_bitlen+7)>>3);
 			/** @todo Should check integrity between data reported by event
 			 * above and the one stored in user data buffer
 			 *
@@ -504,7 +816,7 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 			 * * free element from user data buffer.
 			 */
 			bMGR_AT_CMD_sendResponse(ATCMD_RSP_TXNOTOK, (void *)spUserDataMsg);
-			USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+			MGR_AT_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 			Set_TX_LED(0);
 			cbStatus = KNS_STATUS_TR_ERR;
 		} else {
@@ -521,10 +833,10 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 		 */
 //		MGR_LOG_DEBUG("MGR_AT_CMD RX timeout callback reached\r\n");
 //		MGR_LOG_DEBUG("ERROR: no DL frm for (%d bits = %d bytes + %d bits): 0x",
-//			srvcEvt.tx_ctxt.data_bitlen,
-//			srvcEvt.tx_ctxt.data_bitlen>>3,
-//			srvcEvt.tx_ctxt.data_bitlen&0x07);
-//		MGR_LOG_array(srvcEvt.tx_ctxt.data, (srvcEvt.tx_ctxt.data_bitlen+7)>>3);
+//			srvcEvt->tx_ctxt.data_bitlen,
+//			srvcEvt->tx_ctxt.data_bitlen>>3,
+//			srvcEvt->tx_ctxt.data_bitlen&0x07);
+//		MGR_LOG_array(srvcEvt->tx_ctxt.data, (srvcEvt->tx_ctxt.data_bitlen+7)>>3);
 		/** @todo Should check integrity between data reported by event above and
 		 * the one stored in user data buffer
 		 *
@@ -533,7 +845,7 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 		 * * free element from user data buffer.
 		 */
 		bMGR_AT_CMD_sendResponse(ATCMD_RSP_RXTIMEOUT, (void *)spUserDataMsg);
-		USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+		MGR_AT_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		Set_TX_LED(0);
 		cbStatus = KNS_STATUS_TIMEOUT;
 	break;
@@ -542,10 +854,10 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 	case (KNS_MAC_DL_BC):
 //		MGR_LOG_DEBUG("MGR_AT_CMD DL callback reached\r\n");
 //		MGR_LOG_DEBUG("decoded msg (%d bits = %d bytes + %d bits): 0x",
-//			srvcEvt.rx_ctxt.data_bitlen,
-//			srvcEvt.rx_ctxt.data_bitlen>>3,
-//			srvcEvt.rx_ctxt.data_bitlen&0x07);
-//		MGR_LOG_array(srvcEvt.rx_ctxt.data, (srvcEvt.rx_ctxt.data_bitlen+7)>>3);
+//			srvcEvt->rx_ctxt.data_bitlen,
+//			srvcEvt->rx_ctxt.data_bitlen>>3,
+//			srvcEvt->rx_ctxt.data_bitlen&0x07);
+//		MGR_LOG_array(srvcEvt->rx_ctxt.data, (srvcEvt->rx_ctxt.data_bitlen+7)>>3);
 		/** @todo Should check integrity between data reported by event above and
 		 * the one stored in user data buffer
 		 *
@@ -553,16 +865,16 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 		 * * notify host with AT cmd response then
 		 * * free element from user data buffer.
 		 */
-		bMGR_AT_CMD_sendResponse(ATCMD_RSP_DLOK, (void *)&(srvcEvt.rx_ctxt));
+		bMGR_AT_CMD_sendResponse(ATCMD_RSP_DLOK, (void *)&(srvcEvt->rx_ctxt));
 		cbStatus = KNS_STATUS_OK;
 	break;
 	case (KNS_MAC_RX_RECEIVED):
 //		MGR_LOG_DEBUG("MGR_AT_CMD RX callback reached\r\n");
 //		MGR_LOG_DEBUG("bitstream (%d bits = %d bytes + %d bits): 0x",
-//			srvcEvt.rx_ctxt.data_bitlen,
-//			srvcEvt.rx_ctxt.data_bitlen>>3,
-//			srvcEvt.rx_ctxt.data_bitlen&0x07);
-//		MGR_LOG_array(srvcEvt.rx_ctxt.data, (srvcEvt.rx_ctxt.data_bitlen+7)>>3);
+//			srvcEvt->rx_ctxt.data_bitlen,
+//			srvcEvt->rx_ctxt.data_bitlen>>3,
+//			srvcEvt->rx_ctxt.data_bitlen&0x07);
+//		MGR_LOG_array(srvcEvt->rx_ctxt.data, (srvcEvt->rx_ctxt.data_bitlen+7)>>3);
 		/** @todo Should check integrity between data reported by event above and
 		 * the one stored in user data buffer
 		 *
@@ -570,12 +882,12 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 		 * * notify host with AT cmd response then
 		 * * free element from user data buffer.
 		 */
-		bMGR_AT_CMD_sendResponse(ATCMD_RSP_RXOK, (void *)&(srvcEvt.rx_ctxt));
+		bMGR_AT_CMD_sendResponse(ATCMD_RSP_RXOK, (void *)&(srvcEvt->rx_ctxt));
 		cbStatus = KNS_STATUS_OK;
 	break;
 	case (KNS_MAC_SAT_DETECTED):
 //		MGR_LOG_DEBUG("MGR_AT_CMD SAT detect callback reached\r\n");
-		bMGR_AT_CMD_sendResponse(ATCMD_RSP_SATDET, (void *)&(srvcEvt.satdet_ctxt));
+		bMGR_AT_CMD_sendResponse(ATCMD_RSP_SATDET, (void *)&(srvcEvt->satdet_ctxt));
 		cbStatus = KNS_STATUS_OK;
 	break;
 	case (KNS_MAC_SAT_LOST):
@@ -590,17 +902,21 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 	case (KNS_MAC_OK):
 //		MGR_LOG_DEBUG("MGR_AT_CMD MAC reported OK to previous command.\r\n");
 		bMGR_AT_CMD_logSucceedMsg();
-		if (srvcEvt.app_evt == KNS_MAC_SEND_DATA)
+		if (srvcEvt->app_evt == KNS_MAC_SEND_DATA)
 			Set_TX_LED(1);
-		if (srvcEvt.app_evt == KNS_MAC_STOP_SEND_DATA)
+		if (srvcEvt->app_evt == KNS_MAC_STOP_SEND_DATA) {
+			for (u8_eltNb = USERDATA_txFifoGetCount(); u8_eltNb > 0; u8_eltNb--)
+				MCU_MISC_RF_release();
 			kns_assert(USERDATA_txFifoFlush() == true);
+			MGR_AT_CMD_flushPendingTxElts();
+		}
 		cbStatus = KNS_STATUS_OK;
 	break;
 	case (KNS_MAC_ERROR):
 //		MGR_LOG_DEBUG("MGR_AT_CMD MAC reported ERROR to previous command.\r\n");
-		bMGR_AT_CMD_logFailedMsg(convKnsStatusToAtErr(srvcEvt.status));
-		if (srvcEvt.app_evt == KNS_MAC_SEND_DATA)
-			USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+		bMGR_AT_CMD_logFailedMsg(convKnsStatusToAtErr(srvcEvt->status));
+		if (srvcEvt->app_evt == KNS_MAC_SEND_DATA)
+			MGR_AT_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		cbStatus = KNS_STATUS_ERROR;
 	break;
 	default:
@@ -609,6 +925,11 @@ enum KNS_status_t MGR_AT_CMD_macEvtProcess(void)
 	break;
 	}
 
+	KNS_Q_release(KNS_Q_UL_MAC2APP);
+
+	/** MAC popped some APP2MAC event before reporting it, pending elements may fit now */
+	MGR_AT_CMD_pushPendingTxElts();
+
 	return cbStatus;
 }
 
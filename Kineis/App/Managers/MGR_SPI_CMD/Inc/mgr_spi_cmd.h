@@ -37,10 +37,41 @@ extern "C" {
 #include "kineis_sw_conf.h" // get ERROR_RETURN_T types
 #include "mcu_spi_driver.h"
 #include "mgr_spi_cmd_list.h"
+#include "mgr_spi_cmd_common.h"
 
 /* Defines -------------------------------------------------------------------*/
 #define CMD_IT_TIMEOUT 1000      /**< Timeout in milliseconds for SPI command processing interrupts */
 
+/** @name Attention event classes, raising the attention line to the host when enabled in mask
+ * @{
+ */
+#define MGR_SPI_CMD_ATTN_TX_DONE   0x01 /**< TX or TX with ACK done */
+#define MGR_SPI_CMD_ATTN_MAC_ERROR 0x02 /**< TX/RX timeout or error reported by MAC */
+#define MGR_SPI_CMD_ATTN_MAC_OK    0x04 /**< MAC acknowledged a previous command (e.g. stop TX) */
+#define MGR_SPI_CMD_ATTN_CMD_RSP   0x08 /**< Response to last SPI command ready to be read */
+#define MGR_SPI_CMD_ATTN_MAC_ALL   (MGR_SPI_CMD_ATTN_TX_DONE | MGR_SPI_CMD_ATTN_MAC_ERROR | \
+				    MGR_SPI_CMD_ATTN_MAC_OK) /**< All MAC event classes */
+#define MGR_SPI_CMD_ATTN_ALL       (MGR_SPI_CMD_ATTN_MAC_ALL | MGR_SPI_CMD_ATTN_CMD_RSP)
+/** @} */
+
+/** Number of MAC event records kept until read by the host */
+#ifndef MGR_SPI_CMD_EVT_FIFO_SIZE
+#define MGR_SPI_CMD_EVT_FIFO_SIZE 16
+#endif
+
+/* Types ---------------------------------------------------------------------*/
+
+/**
+ * @struct MGR_SPI_CMD_evtRec_t
+ * @brief Record of one MAC event, as reported to the host
+ */
+struct MGR_SPI_CMD_evtRec_t {
+	uint8_t evtId;      /**< MAC service event, \ref KNS_MAC_srvcEvtId_t */
+	uint8_t status;     /**< MAC status reported for this event, \ref MACStatus */
+	uint16_t msgHandle; /**< handle returned by TX command, 0 if event is not related to a message */
+	uint32_t timeMs;    /**< time of the event, \ref MCU_TIM_getTimeMs */
+};
+
 /* Extern Variables ----------------------------------------------------------*/
 extern CmdValue cmdInProgress;   /**< Current SPI command in progress */
 
@@ -82,6 +113,95 @@ enum KNS_status_t MGR_SPI_CMD_macEvtProcess(void);
  */
 void MGR_SPI_CMD_state_handler(void);
 
+/**
+ * @brief Check the SPI command manager has some more processing to do.
+ *
+ * The state handler needs to be called again as long as a command is being processed or a
+ * multi-byte transfer is in progress (timeout check). Waiting for the next command is not pending,
+ * the SPI ISRs will flag it.
+ *
+ * @retval true if the state handler needs to be called again, false otherwise.
+ */
+bool MGR_SPI_CMD_isPendingCmd(void);
+
+/**
+ * @brief Record a MAC event in the event FIFO and raise its attention class.
+ *
+ * When the FIFO is full, the record is dropped and counted, older records are kept.
+ *
+ * @param[in] evtId MAC service event
+ * @param[in] status MAC status reported for this event
+ * @param[in] msgHandle handle returned by TX command, 0 if event is not related to a message
+ */
+void MGR_SPI_CMD_macEvtRecord(enum KNS_MAC_srvcEvtId_t evtId, MACStatus status,
+	uint16_t msgHandle);
+
+/**
+ * @brief Pop the oldest MAC event record.
+ *
+ * MAC attention classes are acknowledged once the FIFO is empty.
+ *
+ * @param[out] rec record
+ *
+ * @retval true if a record is popped, false if FIFO is empty
+ */
+bool MGR_SPI_CMD_evtPop(struct MGR_SPI_CMD_evtRec_t *rec);
+
+/**
+ * @brief Get the number of MAC event records in FIFO.
+ *
+ * @retval number of records
+ */
+uint8_t MGR_SPI_CMD_evtGetCount(void);
+
+/**
+ * @brief Get and clear the number of MAC event records dropped as FIFO was full.
+ *
+ * @retval number of dropped records since last call, saturated to 255
+ */
+uint8_t MGR_SPI_CMD_evtTakeDropped(void);
+
+/**
+ * @brief Record MAC events to be reported to the host through the attention line.
+ *
+ * Events stay pending until acknowledged by \ref MGR_SPI_CMD_attnAck, typically when the host
+ * reads the MAC status or drains the MAC event FIFO.
+ *
+ * @param[in] evt MGR_SPI_CMD_ATTN_xxx event classes, CMD_RSP is ignored as tracked by SPI driver
+ */
+void MGR_SPI_CMD_attnRaise(uint8_t evt);
+
+/**
+ * @brief Acknowledge pending MAC events, releasing the attention line if nothing else is pending.
+ *
+ * @param[in] evt MGR_SPI_CMD_ATTN_xxx event classes read by the host
+ */
+void MGR_SPI_CMD_attnAck(uint8_t evt);
+
+/**
+ * @brief Select event classes asserting the attention line.
+ *
+ * Pending events are kept whatever the mask, so that enabling a class afterwards reports them.
+ * Default mask is MGR_SPI_CMD_ATTN_ALL.
+ *
+ * @param[in] mask MGR_SPI_CMD_ATTN_xxx event classes
+ */
+void MGR_SPI_CMD_attnSetMask(uint8_t mask);
+
+/**
+ * @brief Get event classes asserting the attention line.
+ *
+ * @retval MGR_SPI_CMD_ATTN_xxx event classes
+ */
+uint8_t MGR_SPI_CMD_attnGetMask(void);
+
+/**
+ * @brief Get event classes pending, including CMD_RSP when a response is waiting for the host.
+ *
+ * @retval MGR_SPI_CMD_ATTN_xxx event classes
+ */
+uint8_t MGR_SPI_CMD_attnGetPending(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,17 +29,26 @@
 #include "mcu_spi_driver.h"
 #include "mcu_aes.h"
 #include "mcu_nvm.h"
+#include "kns_q_conf.h"
 
 /* Defines -------------------------------------------------------------------*/
 #define CMD_VARIABLE_LEN          0xFF   /**< Indicator for variable length command. */
-#define CMD_WRITEID_WAIT_LEN      5      /**< 4 bytes for uint32 size + 1 byte for command. */
-#define CMD_WRITETCXO_WAIT_LEN    5      /**< 4 bytes for uint32 size + 1 byte for command. */
-#define CMD_WRITEADDRESS_WAIT_LEN (DEVICE_ADDR_LENGTH + 1) /**< Device address length + 1 byte for command. */
-#define CMD_WRITESECKEY_WAIT_LEN  (DSK_BYTE_LENGTH + 1)      /**< Secret key length + 1 byte for command. */
+#define CMD_READTCXOSTAT_LEN      12     /**< warm-up, hold and measured warm-up times as uint32. */
 #define CMD_WRITERCONF_WAIT_LEN   33     /**< 32 bytes for configuration size + 1 byte for command. */
-#define CMD_WRITELPM_WAIT_LEN     2      /**< 1 byte for low power mode + 1 byte for command. */
-#define CMD_WRITEKMAC_WAIT_LEN    2      /**< 1 byte for write-only ID (for now) + 1 byte for command. */
 #define CMD_WRITETX_WAIT_LEN      3      /**< 1 byte for write-only ID + 2 bytes for data size (uint16). */
+#define CMD_WRITETXBATCH_WAIT_LEN 3      /**< 1 byte for write-only ID + 2 bytes for batch size (uint16). */
+#define CMD_WRITETX_RSP_LEN       3      /**< 1 byte for success + 2 bytes for message handle (uint16). */
+#define CMD_WRITETXBATCH_ITEM_HDR 2      /**< 1 byte for data length + 1 byte for attribute, per item. */
+#define CMD_WRITETXBATCH_RSP_ITEM 3      /**< 1 byte for error code + 2 bytes for message handle, per item. */
+#define CMD_WRITETXCHUNK_WAIT_LEN 5      /**< 1 byte for write-only ID + 2 bytes offset + 2 bytes length (uint16). */
+#define CMD_READATTN_LEN          2      /**< 1 byte for attention mask + 1 byte for pending events. */
+#define CMD_WRITEATTN_WAIT_LEN    2      /**< 1 byte for attention mask + 1 byte for command. */
+#define CMD_READMACEVT_WAIT_LEN   2      /**< 1 byte for max number of records + 1 byte for command. */
+#define CMD_READMACEVT_HDR_LEN    3      /**< record count, records left and dropped count on 1 byte each. */
+#define CMD_READMACEVT_REC_LEN    8      /**< event id, status, uint16 message handle, uint32 time in ms. */
+#define CMD_REGBURST_WAIT_LEN     3      /**< 1 byte for command + first register address + register count. */
+#define CMD_READQSTAT_ITEM_LEN    19     /**< 3 bytes for capacity/depth/hwm + 4 uint32 counters, per queue. */
+#define CMD_READQSTAT_LEN         (CMD_READQSTAT_ITEM_LEN * KNS_Q_MAX) /**< Statistics of all queues. */
 
 /* Enumerations --------------------------------------------------------------*/
 
@@ -93,7 +102,29 @@ typedef enum {
     CMD_READ_TCXO_WU     = 0x28, /**< Read TCXO wake-up identifier. */
     CMD_WRITE_TCXOWU_REQ = 0x29, /**< Write TCXO wake-up request. */
     CMD_WRITE_TCXOWU     = 0x2A, /**< Write TCXO wake-up value. */
-    SPICMD_MAX_COUNT     = 0x2B  /**< Maximum number of SPI commands. */
+    CMD_READ_QSTAT       = 0x2B, /**< Read queues usage statistics. */
+    CMD_RESET_QSTAT      = 0x2C, /**< Reset queues usage statistics. */
+    CMD_WRITE_TXBATCH_REQ = 0x2D, /**< Batched TX uplink request. */
+    CMD_WRITE_TXBATCH_SIZE = 0x2E, /**< Waiting size request to read batched TX data. */
+    CMD_WRITE_TXBATCH    = 0x2F, /**< Write batched TX uplink values. */
+    CMD_READ_TCXO_STAT   = 0x30, /**< Read TCXO warm-up, hold and measured warm-up times. */
+    CMD_WRITE_TCXOHOLD_REQ = 0x31, /**< Write TCXO idle hold time request. */
+    CMD_WRITE_TCXOHOLD   = 0x32, /**< Write TCXO idle hold time value. */
+    CMD_WRITE_TXCHUNK_REQ = 0x33, /**< Chunked TX uplink request. */
+    CMD_WRITE_TXCHUNK_HDR = 0x34, /**< Waiting offset and length of next TX chunk. */
+    CMD_WRITE_TXCHUNK    = 0x35, /**< Write TX chunk data. */
+    CMD_WRITE_TXCOMMIT   = 0x36, /**< Submit chunked TX uplink. */
+    CMD_READ_ATTN        = 0x37, /**< Read attention line mask and pending events. */
+    CMD_WRITE_ATTN_REQ   = 0x38, /**< Write attention line mask request. */
+    CMD_WRITE_ATTN       = 0x39, /**< Write attention line mask value. */
+    CMD_READ_MACEVT_REQ  = 0x3A, /**< Read MAC event records request. */
+    CMD_READ_MACEVT      = 0x3B, /**< Read up to N MAC event records. */
+    CMD_REG_READ_REQ     = 0x3C, /**< Register burst read request. */
+    CMD_REG_READ         = 0x3D, /**< Read registers from first address and count. */
+    CMD_REG_WRITE_REQ    = 0x3E, /**< Register burst write request. */
+    CMD_REG_WRITE_HDR    = 0x3F, /**< Waiting first address and count of registers to write. */
+    CMD_REG_WRITE        = 0x40, /**< Write register values. */
+    SPICMD_MAX_COUNT     = 0x41  /**< Maximum number of SPI commands. */
 } CmdValue;
 
 /* Types ---------------------------------------------------------------------*/
@@ -365,6 +365,136 @@ bool bMGR_SPI_CMD_WRITETCXOREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
  */
 bool bMGR_SPI_CMD_READTCXO_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
 
+/**
+ * @brief Read TCXO timings.
+ *
+ * This function replies CMD_READTCXOSTAT_LEN bytes: configured warm-up time, idle hold time and
+ * last warm-up time measured from TCXO enabling to ready, in ms as little-endian uint32.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the command.
+ * @param tx Pointer to the SPI transmit buffer where the TCXO timings will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_READTCXOSTAT_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Initiate a request to write the TCXO idle hold time.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the request.
+ * @param tx Pointer to the SPI transmit buffer where the acknowledgment will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITETCXOHOLDREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Write the TCXO idle hold time.
+ *
+ * The hold time is a little-endian uint32 in ms, up to MCU_MISC_TCXO_HOLD_MAX_MS. TCXO is kept
+ * on during this time after last transmission, so that back-to-back transmissions do not pay the
+ * warm-up again. 0 switches it off right away.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the hold time.
+ * @param tx Pointer to the SPI transmit buffer where the result of the write operation will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITETCXOHOLD_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Read attention line configuration.
+ *
+ * This function replies CMD_READATTN_LEN bytes: mask of event classes asserting the attention
+ * line, then MAC event classes pending (MGR_SPI_CMD_ATTN_xxx).
+ *
+ * @param rx Pointer to the SPI receive buffer containing the command.
+ * @param tx Pointer to the SPI transmit buffer where mask and pending events will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_READATTN_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Initiate a request to write the attention line mask.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the request.
+ * @param tx Pointer to the SPI transmit buffer where the acknowledgment will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITEATTNREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Write the attention line mask.
+ *
+ * The mask is one byte of MGR_SPI_CMD_ATTN_xxx event classes asserting the line, 0 keeps it
+ * released. MAC events are acknowledged by reading the MAC status, CMD_RSP by clocking the
+ * response out.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the mask.
+ * @param tx Pointer to the SPI transmit buffer where the result of the write operation will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITEATTN_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Initiate a request to read MAC event records.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the request.
+ * @param tx Pointer to the SPI transmit buffer where the acknowledgment will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_READMACEVTREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Read up to N MAC event records, oldest first.
+ *
+ * N is one byte, from 1 to MGR_SPI_CMD_EVT_FIFO_SIZE. This function always replies
+ * CMD_READMACEVT_HDR_LEN + N * CMD_READMACEVT_REC_LEN bytes: number of records sent, records
+ * left in FIFO and records dropped since last read, then the records, zero padded. Each record is
+ * the MAC event id (\ref KNS_MAC_srvcEvtId_t), the MAC status (\ref MACStatus), the message handle
+ * (as returned by the TX command) and the event time in ms, both little-endian.
+ *
+ * Records sent are removed from the FIFO. Unlike CMD_MACSTATUS, the host gets every TX result
+ * even with several messages in flight.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the max number of records.
+ * @param tx Pointer to the SPI transmit buffer where the records will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_READMACEVT_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Read Kineis OS queues usage statistics.
+ *
+ * This function replies CMD_READQSTAT_ITEM_LEN bytes per queue, sorted by queue handle
+ * (APP2MAC, MAC2APP, INFRA2MAC, SRVC2MAC): capacity, current depth and high-water mark on one
+ * byte each, then push count, pop count, queue-full count and max residence time in ms as
+ * little-endian uint32.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the command.
+ * @param tx Pointer to the SPI transmit buffer where the statistics will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_READQSTAT_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Reset Kineis OS queues usage statistics.
+ *
+ * This function clears counters, high-water marks and residence times of all queues.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the command.
+ * @param tx Pointer to the SPI transmit buffer where the acknowledgment will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_RESETQSTAT_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
 #endif /* __MGR_SPI_CMD_LIST_GENERAL_H */
 
 /** @} */
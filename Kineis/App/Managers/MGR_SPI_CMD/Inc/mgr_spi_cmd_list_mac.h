@@ -28,7 +28,7 @@
  * @brief Read the Kinéis MAC configuration.
  *
  * This function processes the SPI command to read the current MAC configuration.
- * Although implemented as a stub, it is designed to handle requests from the GUI.
+ * Alias of a read of register MGR_SPI_CMD_REG_KMAC_INFO (see mgr_spi_cmd_list_regmap.h).
  *
  * @param[in] rx Pointer to the SPI receive buffer containing the command.
  * @param[out] tx Pointer to the SPI transmit buffer where the MAC configuration data will be sent.
@@ -42,7 +42,7 @@ bool bMGR_SPI_CMD_READKMAC_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
  * @brief Initiate a request to write the Kinéis MAC configuration.
  *
  * This function processes the SPI command that initiates the procedure for updating the MAC configuration.
- * As a stub, this function acknowledges the write request from the GUI.
+ * Alias of a write request of register MGR_SPI_CMD_REG_KMAC (see mgr_spi_cmd_list_regmap.h).
  *
  * @param[in] rx Pointer to the SPI receive buffer containing the request.
  * @param[out] tx Pointer to the SPI transmit buffer where the acknowledgment will be sent.
@@ -56,7 +56,7 @@ bool bMGR_SPI_CMD_WRITEKMACREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
  * @brief Write the new Kinéis MAC configuration.
  *
  * This function processes the SPI command to update the MAC configuration after a valid write request.
- * Although implemented as a stub, it processes the data provided by the GUI.
+ * Alias of a write of register MGR_SPI_CMD_REG_KMAC, which initializes the MAC with the new profile.
  *
  * @param[in] rx Pointer to the SPI receive buffer containing the new MAC configuration data.
  * @param[out] tx Pointer to the SPI transmit buffer where the result of the write operation will be sent.
@@ -0,0 +1,231 @@
+/* SPDX-License-Identifier: no SPDX license */
+/**
+ * @file mgr_spi_cmd_list_regmap.h
+ * @brief Register map of device configuration, accessed by SPI register bursts.
+ *
+ * Each configuration field is a register described by its address, size, access mode and
+ * getter/setter (\ref MGR_SPI_CMD_reg_t). Registers are read or written by bursts of consecutive
+ * addresses, values being concatenated in address order:
+ * - read: CMD_REG_READ_REQ, then [CMD_REG_READ, first address, count], replying the values
+ * - write: CMD_REG_WRITE_REQ, then [CMD_REG_WRITE_HDR, first address, count], then
+ *   [CMD_REG_WRITE, values]
+ *
+ * With DMA framed SPI, each sequence fits in one frame. Typically, factory provisioning writes ID
+ * to radio configuration bloc in one burst, and boot-time checks read back the whole map in two
+ * bursts.
+ *
+ * Legacy READ_x, WRITE_x_REQ and WRITE_x commands are kept as aliases of one register access.
+ *
+ * @author Arribada
+ */
+
+/**
+ * @addtogroup MGR_SPI_CMD
+ * @{
+ */
+
+#ifndef __MGR_SPI_CMD_REGMAP_H
+#define __MGR_SPI_CMD_REGMAP_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "mgr_spi_cmd_common.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** @name Register access modes
+ * @{
+ */
+#define MGR_SPI_CMD_REG_RD 0x01 /**< register can be read */
+#define MGR_SPI_CMD_REG_WR 0x02 /**< register can be written */
+#define MGR_SPI_CMD_REG_RW (MGR_SPI_CMD_REG_RD | MGR_SPI_CMD_REG_WR)
+/** @} */
+
+#define MGR_SPI_CMD_REG_RCONF_ENC_LEN 16 /**< encrypted radio configuration bloc, 128 bits */
+
+/* Enumerations --------------------------------------------------------------*/
+
+/**
+ * @enum MGR_SPI_CMD_regAddr_t
+ * @brief Register addresses. Multi-byte integers are little-endian.
+ */
+enum MGR_SPI_CMD_regAddr_t {
+	MGR_SPI_CMD_REG_ID        = 0x00, /**< RW, device ID, uint32 */
+	MGR_SPI_CMD_REG_ADDR      = 0x01, /**< RW, device address */
+	MGR_SPI_CMD_REG_SECKEY    = 0x02, /**< RW, device secret key */
+	MGR_SPI_CMD_REG_RCONF_ENC = 0x03, /**< WO, encrypted radio configuration bloc from Kineis */
+	MGR_SPI_CMD_REG_LPM       = 0x04, /**< RW, allowed low power modes bitmap */
+	MGR_SPI_CMD_REG_TCXO_WU   = 0x05, /**< RW, TCXO warm-up time in ms, uint32 */
+	MGR_SPI_CMD_REG_TCXO_HOLD = 0x06, /**< RW, TCXO idle hold time in ms, uint32 */
+	MGR_SPI_CMD_REG_KMAC      = 0x07, /**< RW, MAC profile ID, writing it initializes MAC */
+	MGR_SPI_CMD_REG_RCONF     = 0x08, /**< RO, decoded radio configuration */
+	MGR_SPI_CMD_REG_KMAC_INFO = 0x09, /**< RO, MAC profile ID and configuration */
+	MGR_SPI_CMD_REG_SN        = 0x0A, /**< RO, serial number, NUL terminated */
+	MGR_SPI_CMD_REG_FW        = 0x0B, /**< RO, firmware version string */
+	MGR_SPI_CMD_REG_MAX
+};
+
+/* Types ---------------------------------------------------------------------*/
+
+/**
+ * @brief Register getter, copy register value to val
+ *
+ * @param[out] val register value, register size bytes
+ *
+ * @return ERROR_NO on success, SPI cmd error code otherwise
+ */
+typedef enum ERROR_RETURN_T (*pfMGR_SPI_CMD_regGet)(uint8_t *val);
+
+/**
+ * @brief Register setter, check and apply register value
+ *
+ * @param[in] val register value, register size bytes
+ *
+ * @return ERROR_NO on success, SPI cmd error code otherwise
+ */
+typedef enum ERROR_RETURN_T (*pfMGR_SPI_CMD_regSet)(uint8_t *val);
+
+/**
+ * @struct MGR_SPI_CMD_reg_t
+ * @brief Register descriptor
+ */
+struct MGR_SPI_CMD_reg_t {
+	enum MGR_SPI_CMD_regAddr_t addr; /**< register address, also its index in register map */
+	uint8_t size;                    /**< value size in bytes */
+	uint8_t access;                  /**< MGR_SPI_CMD_REG_xx access mode */
+	pfMGR_SPI_CMD_regGet get;        /**< getter, NULL if not readable */
+	pfMGR_SPI_CMD_regSet set;        /**< setter, NULL if not writable */
+};
+
+/* Functions -----------------------------------------------------------------*/
+
+/**
+ * @brief Check a register burst and get the length of its values.
+ *
+ * @param[in] addr first register address
+ * @param[in] count number of registers
+ * @param[in] access MGR_SPI_CMD_REG_RD or MGR_SPI_CMD_REG_WR, needed on all registers
+ * @param[out] len total size of values in bytes
+ *
+ * @return ERROR_NO if burst is valid, SPI cmd error code otherwise
+ */
+enum ERROR_RETURN_T eMGR_SPI_CMD_REG_burstLen(uint8_t addr, uint8_t count, uint8_t access,
+	uint16_t *len);
+
+/**
+ * @brief Read a register burst.
+ *
+ * @param[in] addr first register address
+ * @param[in] count number of registers
+ * @param[out] buf values, concatenated in address order
+ *
+ * @return ERROR_NO on success, SPI cmd error code otherwise
+ */
+enum ERROR_RETURN_T eMGR_SPI_CMD_REG_read(uint8_t addr, uint8_t count, uint8_t *buf);
+
+/**
+ * @brief Write a register burst.
+ *
+ * Registers are written in address order. Writing stops at first failure, previous registers
+ * keep their new value.
+ *
+ * @param[in] addr first register address
+ * @param[in] count number of registers
+ * @param[in] buf values, concatenated in address order
+ *
+ * @return ERROR_NO on success, SPI cmd error code otherwise
+ */
+enum ERROR_RETURN_T eMGR_SPI_CMD_REG_write(uint8_t addr, uint8_t count, uint8_t *buf);
+
+/**
+ * @brief Reply the value of one register, as legacy READ_x commands.
+ *
+ * @param[in] addr register address
+ * @param[in] rx Pointer to the SPI receive buffer containing the command.
+ * @param[out] tx Pointer to the SPI transmit buffer where the value will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_REG_readOne(uint8_t addr, SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Wait for the value of one register, as legacy WRITE_x_REQ commands.
+ *
+ * @param[in] addr register address
+ * @param[in] rx Pointer to the SPI receive buffer containing the request.
+ * @param[out] tx Pointer to the SPI transmit buffer.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_REG_writeOneReq(uint8_t addr, SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Write the value of one register, following the command byte, as legacy WRITE_x commands.
+ *
+ * @param[in] addr register address
+ * @param[in] rx Pointer to the SPI receive buffer containing the value.
+ * @param[out] tx Pointer to the SPI transmit buffer where an error will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_REG_writeOne(uint8_t addr, SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Initiate a register burst read.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the request.
+ * @param tx Pointer to the SPI transmit buffer.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_REGREADREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Read a register burst.
+ *
+ * Receives first register address and number of registers, then replies their values
+ * concatenated in address order. All registers shall be readable.
+ *
+ * @param rx Pointer to the SPI receive buffer containing first address and count.
+ * @param tx Pointer to the SPI transmit buffer where the values will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_REGREAD_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Initiate a register burst write.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the request.
+ * @param tx Pointer to the SPI transmit buffer.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_REGWRITEREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Receive first register address and number of registers of a burst write.
+ *
+ * All registers shall be writable. Then waits for CMD_REG_WRITE with the values.
+ *
+ * @param rx Pointer to the SPI receive buffer containing first address and count.
+ * @param tx Pointer to the SPI transmit buffer where an error will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_REGWRITEHDR_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Write the values of the register burst announced by CMD_REG_WRITE_HDR.
+ *
+ * @param rx Pointer to the SPI receive buffer containing the values.
+ * @param tx Pointer to the SPI transmit buffer where an error will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_REGWRITE_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+#endif /* __MGR_SPI_CMD_REGMAP_H */
+
+/**
+ * @}
+ */
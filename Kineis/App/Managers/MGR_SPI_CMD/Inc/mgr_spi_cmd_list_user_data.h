@@ -65,6 +65,8 @@ bool bMGR_SPI_CMD_WRITETXREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
  * @brief Process the SPI command to set the TX data size.
  *
  * This function handles the SPI command that specifies the size of the TX data to be transmitted.
+ * Command and data shall fit in one SPI read (RXBUF_SIZE), larger payloads are sent through
+ * chunked TX (\ref bMGR_SPI_CMD_WRITETXCHUNKREQ_cmd).
  *
  * @param[in] rx Pointer to the SPI receive buffer containing the TX size command.
  * @param[out] tx Pointer to the SPI transmit buffer where the acknowledgment or response will be sent.
@@ -77,6 +79,8 @@ bool bMGR_SPI_CMD_WRITETXSIZE_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
  * @brief Process the SPI command to write TX data.
  *
  * This function handles the SPI command that writes the actual user data to be transmitted.
+ * Response is [1, message handle (uint16, little-endian)], handle being reported with MAC events of
+ * this message (\ref bMGR_SPI_CMD_READMACEVT_cmd).
  *
  * @param[in] rx Pointer to the SPI receive buffer containing the TX data.
  * @param[out] tx Pointer to the SPI transmit buffer where the result of the TX write operation will be sent.
@@ -85,6 +89,129 @@ bool bMGR_SPI_CMD_WRITETXSIZE_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
  */
 bool bMGR_SPI_CMD_WRITETX_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
 
+/**
+ * @brief Process the SPI command to initiate a batched TX request.
+ *
+ * Same as \ref bMGR_SPI_CMD_WRITETXREQ_cmd, for the batch size.
+ *
+ * @param[in] rx Pointer to the SPI receive buffer containing the batched TX request command.
+ * @param[out] tx Pointer to the SPI transmit buffer where the response will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITETXBATCHREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Process the SPI command to set the batched TX data size.
+ *
+ * Batch size is the total size of all items, up to RXBUF_SIZE - 1 bytes.
+ *
+ * @param[in] rx Pointer to the SPI receive buffer containing the batched TX size command.
+ * @param[out] tx Pointer to the SPI transmit buffer where the acknowledgment or response will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITETXBATCHSIZE_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Process the SPI command to write batched TX data.
+ *
+ * Batch is a sequence of up to USERDATA_TX_FIFO_SIZE items, each one being
+ * [data length (1 byte), attribute (1 byte), data]. TCXO is warmed-up once for the whole batch,
+ * USERDATA elements are reserved at once, items beyond free elements are rejected. Accepted items
+ * are pushed to MAC as MAC queue has room, after TCXO warm-up if it was cold
+ * (\ref MGR_SPI_CMD_pushPendingTxElts).
+ *
+ * Response is [accepted items number, then error code and message handle (uint16, little-endian)
+ * of each item], error code being 0 for an accepted item and handle 0 for a rejected one.
+ *
+ * @param[in] rx Pointer to the SPI receive buffer containing the batched TX data.
+ * @param[out] tx Pointer to the SPI transmit buffer where the per-item status will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITETXBATCH_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Process the SPI command to initiate a chunked TX request.
+ *
+ * Chunked TX sends one uplink payload of any size up to USERDATA_TX_PAYLOAD_MAX_SIZE through
+ * several SPI reads, each chunk being copied at its offset in the USERDATA element reserved by
+ * the first chunk. Thus the SPI RX buffer only needs to hold one chunk. Sequence is:
+ * - CMD_WRITE_TXCHUNK_REQ, then [CMD_WRITE_TXCHUNK_HDR, offset (uint16), length (uint16)],
+ *   then [CMD_WRITE_TXCHUNK, data], for each chunk
+ * - CMD_WRITE_TXCOMMIT to submit the payload, whose size is the end of the furthest chunk
+ *
+ * Upload is aborted and its element released on SPI error (e.g. transfer timeout) and on TX FIFO
+ * flush. A new upload restarting at offset 0 reuses the element of an unfinished one.
+ *
+ * @param[in] rx Pointer to the SPI receive buffer containing the chunked TX request command.
+ * @param[out] tx Pointer to the SPI transmit buffer where the response will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITETXCHUNKREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Process the SPI command giving offset and length of next TX chunk.
+ *
+ * First chunk reserves a USERDATA element, a chunk at offset 0 restarts the payload. Chunk shall
+ * fit in the element and, with its command byte, in one SPI read.
+ *
+ * @param[in] rx Pointer to the SPI receive buffer containing the chunk offset and length.
+ * @param[out] tx Pointer to the SPI transmit buffer where an error will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITETXCHUNKHDR_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Process the SPI command writing TX chunk data into the reserved USERDATA element.
+ *
+ * @param[in] rx Pointer to the SPI receive buffer containing the chunk data.
+ * @param[out] tx Pointer to the SPI transmit buffer where an error will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITETXCHUNK_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Process the SPI command submitting the chunked TX payload.
+ *
+ * Element is pushed to MAC and acknowledged as for \ref bMGR_SPI_CMD_WRITETX_cmd. Committing
+ * without any chunk written releases the reserved element.
+ *
+ * @param[in] rx Pointer to the SPI receive buffer containing the commit command.
+ * @param[out] tx Pointer to the SPI transmit buffer where an error will be sent.
+ *
+ * @return true if the command is correctly received and processed, false otherwise.
+ */
+bool bMGR_SPI_CMD_WRITETXCOMMIT_cmd(SPI_Buffer *rx, SPI_Buffer *tx);
+
+/**
+ * @brief Push pending TX elements to MAC, in order, as long as APP2MAC queue has some room.
+ *
+ * Accepted TX elements stay pending while RF is powering-up or APP2MAC queue is full. This is
+ * called after each MAC event, as MAC pops one APP2MAC event before reporting it.
+ */
+void MGR_SPI_CMD_pushPendingTxElts(void);
+
+/**
+ * @brief Drop pending TX elements, releasing their USERDATA element and RF hold.
+ *
+ * Chunked TX in progress is aborted too (\ref MGR_SPI_CMD_abortTxChunk), and RF ready is no more
+ * waited for. To be called when TX FIFO is flushed.
+ */
+void MGR_SPI_CMD_flushPendingTxElts(void);
+
+/**
+ * @brief Abort chunked TX in progress, releasing the USERDATA element reserved by its first chunk.
+ *
+ * To be called when the upload cannot complete, e.g. on SPI error or driver reset, so that an
+ * abandoned upload does not hold a TX FIFO element.
+ */
+void MGR_SPI_CMD_abortTxChunk(void);
+
 #endif /* __MGR_SPI_CMD_USERDATA_H */
 
 /**
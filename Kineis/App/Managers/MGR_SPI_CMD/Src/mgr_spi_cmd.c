@@ -29,9 +29,15 @@
 #include "mgr_spi_cmd_common.h"
 #include "mgr_spi_cmd_list_general.h"
 #include "mgr_spi_cmd_list.h"
+#include "mgr_spi_cmd_list_user_data.h"
 #include "kns_cfg.h"
 #include "mcu_misc.h"
+#include "kns_os.h"
+#include "mcu_tim.h"
 /* Defines --------------------------------------------------------------------------------------*/
+#if (MGR_SPI_CMD_EVT_FIFO_SIZE > UINT8_MAX)
+#error "MAC event FIFO size does not fit its uint8_t counters"
+#endif
 
 
 /* Structure Declaration ------------------------------------------------------------------------*/
@@ -39,8 +45,56 @@
 SpiState spiState = SPICMD_INIT;
 MACStatus macStatus = MAC_OK;
 CmdValue cmdInProgress = CMD_NONE;
+static uint8_t u8AttnMask = MGR_SPI_CMD_ATTN_ALL;
+static uint8_t u8AttnPending;
+/** MAC event FIFO, records are read from u8EvtRd, u8EvtCnt records are available */
+static struct MGR_SPI_CMD_evtRec_t asEvtFifo[MGR_SPI_CMD_EVT_FIFO_SIZE];
+static uint8_t u8EvtRd;
+static uint8_t u8EvtCnt;
+static uint8_t u8EvtDropped;
 
 /* Private functions ----------------------------------------------------------------------------*/
+/**
+ * @brief Free a user data element notified to the host, and release its RF hold
+ *
+ * TCXO is kept warm for next transmission, see \ref MCU_MISC_RF_release.
+ *
+ * @param[in] spUserDataMsg element to be removed from TX FIFO
+ */
+static void MGR_SPI_CMD_releaseTxElt(struct sUserDataTxFifoElt_t *spUserDataMsg)
+{
+	if (USERDATA_txFifoRemoveElt(spUserDataMsg))
+		MCU_MISC_RF_release();
+}
+
+/**
+ * @brief Drive the attention line from pending events and mask
+ */
+static void MGR_SPI_CMD_attnUpdate(void)
+{
+	MCU_SPI_DRIVER_setAttn((MGR_SPI_CMD_attnGetPending() & u8AttnMask) != 0);
+}
+
+/**
+ * @brief Get attention event class of a MAC status
+ *
+ * @param[in] status MAC status set upon last MAC event
+ *
+ * @retval MGR_SPI_CMD_ATTN_xxx event class
+ */
+static uint8_t MGR_SPI_CMD_attnClass(MACStatus status)
+{
+	switch (status) {
+	case MAC_OK:
+		return MGR_SPI_CMD_ATTN_MAC_OK;
+	case MAC_TX_DONE:
+	case MAC_TXACK_DONE:
+		return MGR_SPI_CMD_ATTN_TX_DONE;
+	default:
+		return MGR_SPI_CMD_ATTN_MAC_ERROR;
+	}
+}
+
 /**
  * @brief
  *
@@ -70,6 +124,7 @@ static int8_t MGR_SPI_CMD_parseStreamCb(SPI_Buffer *rx, SPI_Buffer *tx)
 		cmdInProgress = CMD_NONE;
 		spiState = SPICMD_IDLE;
 	}
+	KNS_OS_setTaskReady(KNS_OS_TASK_APP);
 
 	return cmdInProgress;
 }
@@ -93,8 +148,123 @@ static bool MGR_SPI_CMD_process_cmd(uint8_t cmd)
 	return (ret);
 }
 
+/**
+ * @brief Multi-bytes transfer timeout callback, called from timer ISR
+ */
+static void MGR_SPI_CMD_timeoutCb(void)
+{
+	if (((spiState == SPICMD_WAITING_RX) && (rxBuf.next_req > 1)) ||
+	    ((spiState == SPICMD_WAITING_TX) && (txBuf.next_req > 1))) {
+		MGR_LOG_DEBUG("%s::Transfer timeout occurred!\r\n", __func__);
+		spiState = SPICMD_ERROR;
+		KNS_OS_setTaskReady(KNS_OS_TASK_APP);
+	}
+}
+
+/**
+ * @brief Start transfer timeout if a multi-bytes transfer is waited and timeout is not started yet
+ *
+ * @param[in] buf: SPI buffer of the transfer in progress
+ */
+static void MGR_SPI_CMD_armTimeout(SPI_Buffer *buf)
+{
+	if ((buf->next_req > 1) && !MCU_TIM_swIsRunning(MCU_TIM_SW_SPI_TIMEOUT))
+		MCU_TIM_swStart(MCU_TIM_SW_SPI_TIMEOUT, CMD_IT_TIMEOUT, MGR_SPI_CMD_timeoutCb);
+}
+
 /* Functions ------------------------------------------------------------------------------------*/
 
+void MGR_SPI_CMD_macEvtRecord(enum KNS_MAC_srvcEvtId_t evtId, MACStatus status,
+	uint16_t msgHandle)
+{
+	struct MGR_SPI_CMD_evtRec_t *rec;
+
+	if (u8EvtCnt < MGR_SPI_CMD_EVT_FIFO_SIZE) {
+		rec = &asEvtFifo[(u8EvtRd + u8EvtCnt) % MGR_SPI_CMD_EVT_FIFO_SIZE];
+		rec->evtId = evtId;
+		rec->status = status;
+		rec->msgHandle = msgHandle;
+		rec->timeMs = MCU_TIM_getTimeMs();
+		u8EvtCnt++;
+	} else {
+		MGR_LOG_DEBUG("%s:: event FIFO full, event %u dropped\r\n", __func__, evtId);
+		if (u8EvtDropped < UINT8_MAX)
+			u8EvtDropped++;
+	}
+	MGR_SPI_CMD_attnRaise(MGR_SPI_CMD_attnClass(status));
+}
+
+bool MGR_SPI_CMD_evtPop(struct MGR_SPI_CMD_evtRec_t *rec)
+{
+	if (u8EvtCnt == 0)
+		return false;
+
+	*rec = asEvtFifo[u8EvtRd];
+	u8EvtRd = (u8EvtRd + 1) % MGR_SPI_CMD_EVT_FIFO_SIZE;
+	u8EvtCnt--;
+	if (u8EvtCnt == 0)
+		MGR_SPI_CMD_attnAck(MGR_SPI_CMD_ATTN_MAC_ALL);
+	return true;
+}
+
+uint8_t MGR_SPI_CMD_evtGetCount(void)
+{
+	return u8EvtCnt;
+}
+
+uint8_t MGR_SPI_CMD_evtTakeDropped(void)
+{
+	uint8_t dropped = u8EvtDropped;
+
+	u8EvtDropped = 0;
+	return dropped;
+}
+
+void MGR_SPI_CMD_attnRaise(uint8_t evt)
+{
+	u8AttnPending |= (evt & MGR_SPI_CMD_ATTN_MAC_ALL);
+	MGR_SPI_CMD_attnUpdate();
+}
+
+void MGR_SPI_CMD_attnAck(uint8_t evt)
+{
+	u8AttnPending &= ~evt;
+	MGR_SPI_CMD_attnUpdate();
+}
+
+void MGR_SPI_CMD_attnSetMask(uint8_t mask)
+{
+	u8AttnMask = mask & MGR_SPI_CMD_ATTN_ALL;
+	MGR_SPI_CMD_attnUpdate();
+}
+
+uint8_t MGR_SPI_CMD_attnGetMask(void)
+{
+	return u8AttnMask;
+}
+
+uint8_t MGR_SPI_CMD_attnGetPending(void)
+{
+	if (MCU_SPI_DRIVER_isRspReady())
+		return (u8AttnPending | MGR_SPI_CMD_ATTN_CMD_RSP);
+	return u8AttnPending;
+}
+
+bool MGR_SPI_CMD_isPendingCmd(void)
+{
+	switch (spiState) {
+	case SPICMD_WAITING_RX:
+		/** Waiting for next command is not pending, a transfer in progress only needs its
+		 * timeout to be started
+		 */
+		return ((rxBuf.next_req > 1) && !MCU_TIM_swIsRunning(MCU_TIM_SW_SPI_TIMEOUT));
+	case SPICMD_WAITING_TX:
+		return ((txBuf.next_req > 1) && !MCU_TIM_swIsRunning(MCU_TIM_SW_SPI_TIMEOUT));
+	default:
+		return true;
+	}
+}
+
 bool MGR_SPI_CMD_start(void *context)
 {
 	//spi handler stored and receive interrupt one byte running
@@ -142,39 +312,14 @@ void MGR_SPI_CMD_state_handler() {
            break;
        case SPICMD_WAITING_RX:
     	   //add timeout if req is >1, don't block the driver.
-    	   if(rxBuf.next_req > 1)
-    	   {
-				MGR_LOG_DEBUG("SPI_CMD_WAITING_RX\r\n");
-    		   if (startTickTimeout == 0)
-    		   {
-    			   startTickTimeout = HAL_GetTick();
-    		   }
-
-    		   if ((HAL_GetTick() - startTickTimeout) > CMD_IT_TIMEOUT)
-			   {
-				   MGR_LOG_DEBUG("%s::SPICMD_WAITING_RX::Read timeout occurred!\r\n", __func__);
-				   spiState = SPICMD_ERROR;
-			   }
-    	   }
+    	   MGR_SPI_CMD_armTimeout(&rxBuf);
            break;
        case SPICMD_WAITING_TX:
-    	   if(txBuf.next_req > 1)
-    	   {
-			MGR_LOG_DEBUG("SPI_CMD_WAITING_TX\r\n");
-    		   if (startTickTimeout == 0)
-    		   {
-    			   startTickTimeout = HAL_GetTick();
-    		   }
-
-    		   if ((HAL_GetTick() - startTickTimeout) > CMD_IT_TIMEOUT)
-			   {
-				   MGR_LOG_DEBUG("%s::SPICMD_WAITING_TX::Write timeout occurred!\r\n", __func__);
-				   spiState = SPICMD_ERROR;
-			   }
-    	   }
+    	   MGR_SPI_CMD_armTimeout(&txBuf);
            break;
        case SPICMD_ERROR:
 		    MGR_LOG_DEBUG("%s:: SPI error, resetting...\r\n", __func__);
+		    MGR_SPI_CMD_abortTxChunk();
 		    ret = MCU_SPI_DRIVER_reset(NULL);
 			if (!ret)
 			{
@@ -186,6 +331,8 @@ void MGR_SPI_CMD_state_handler() {
 		   spiState = SPICMD_ERROR;
            break;
    }
+	/** Response armed or clocked out by the host since last call */
+	MGR_SPI_CMD_attnUpdate();
 }
 
 
@@ -193,10 +340,13 @@ enum KNS_status_t MGR_SPI_CMD_macEvtProcess(void)
 {
 	/** Empty weak core, can be overwritten, depending on AT cmd processed */
 	enum KNS_status_t cbStatus;
-	struct KNS_MAC_srvcEvt_t srvcEvt;
+	struct KNS_MAC_srvcEvt_t *srvcEvt;
 	struct sUserDataTxFifoElt_t *spUserDataMsg = USERDATA_txFifoGetFirst();
+	uint16_t u16MsgHandle = 0;
+	uint8_t eltNb;
 
-	cbStatus = KNS_Q_pop(KNS_Q_UL_MAC2APP, (void *)&srvcEvt);
+	/** Read event in place, slot is released once processed */
+	cbStatus = KNS_Q_peek(KNS_Q_UL_MAC2APP, (void **)&srvcEvt);
 
 	if (cbStatus != KNS_STATUS_QEMPTY)
 	{
@@ -208,24 +358,25 @@ enum KNS_status_t MGR_SPI_CMD_macEvtProcess(void)
 
 	//MGR_LOG_DEBUG("macEVT status %u\r\n", cbStatus);
 	/** get pointer to user data FIFO element when possible */
-	switch (srvcEvt.id) {
+	switch (srvcEvt->id) {
 		case (KNS_MAC_TX_DONE):
 		case (KNS_MAC_TXACK_DONE):
 		case (KNS_MAC_TX_TIMEOUT):
 		case (KNS_MAC_TXACK_TIMEOUT):
 		case (KNS_MAC_RX_ERROR):
 		case (KNS_MAC_RX_TIMEOUT):
-			spUserDataMsg = USERDATA_txFifoFindPayload(srvcEvt.tx_ctxt.data,
-				srvcEvt.tx_ctxt.data_bitlen);
+			spUserDataMsg = USERDATA_txFifoFindPayload(srvcEvt->tx_ctxt.data,
+				srvcEvt->tx_ctxt.data_bitlen);
 			kns_assert(spUserDataMsg != NULL);
+			u16MsgHandle = spUserDataMsg->u16MsgHandle;
 			macStatus = MAC_RX_TIMEOUT;
 		break;
 		case (KNS_MAC_ERROR):
-			if (srvcEvt.app_evt == KNS_MAC_SEND_DATA) {
-				spUserDataMsg = USERDATA_txFifoFindPayload(srvcEvt.tx_ctxt.data,
-					srvcEvt.tx_ctxt.data_bitlen);
-				MCU_MISC_TCXO_Force_State(false);
+			if (srvcEvt->app_evt == KNS_MAC_SEND_DATA) {
+				spUserDataMsg = USERDATA_txFifoFindPayload(srvcEvt->tx_ctxt.data,
+					srvcEvt->tx_ctxt.data_bitlen);
 				kns_assert(spUserDataMsg != NULL);
+				u16MsgHandle = spUserDataMsg->u16MsgHandle;
 				macStatus = MAC_ERROR;
 			}
 		break;
@@ -234,7 +385,7 @@ enum KNS_status_t MGR_SPI_CMD_macEvtProcess(void)
 	}
 
 	/** process event */
-	switch (srvcEvt.id) {
+	switch (srvcEvt->id) {
 	case (KNS_MAC_TX_DONE):
 		MGR_LOG_DEBUG("MGR_SPI_CMD TX_DONE callback reached\r\n");
 		kns_assert(spUserDataMsg->bIsToBeTransmit);
@@ -254,9 +405,8 @@ enum KNS_status_t MGR_SPI_CMD_macEvtProcess(void)
 			 * * notify host with AT cmd response then
 			 * * free element from user data buffer.
 			 */
-			USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+			MGR_SPI_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		}
-		MCU_MISC_TCXO_Force_State(false);
 		macStatus = MAC_TX_DONE;
 		cbStatus = KNS_STATUS_OK;
 		break;
@@ -268,8 +418,7 @@ enum KNS_status_t MGR_SPI_CMD_macEvtProcess(void)
 		 * Send +TX= instead of +TACK=, meaning this is the real end of TX data
 		 * transmission
 		 */
-		MCU_MISC_TCXO_Force_State(false);
-		USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+		MGR_SPI_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		macStatus = MAC_TXACK_DONE;
 		cbStatus = KNS_STATUS_OK;
 		break;
@@ -283,16 +432,14 @@ enum KNS_status_t MGR_SPI_CMD_macEvtProcess(void)
 		 * * notify host with AT cmd response then
 		 * * free element from user data buffer.
 		 */
-		MCU_MISC_TCXO_Force_State(false);
-		USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+		MGR_SPI_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		macStatus = MAC_TX_TIMEOUT;
 		cbStatus = KNS_STATUS_TIMEOUT;
 		break;
 	case (KNS_MAC_TXACK_TIMEOUT):
 		MGR_LOG_DEBUG("MGR_SPI_CMD TXACK_TIMEOUT callback reached\r\n");
-		MCU_MISC_TCXO_Force_State(false);
 		kns_assert(spUserDataMsg->bIsToBeTransmit);
-		USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+		MGR_SPI_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		macStatus = MAC_TXACK_TIMEOUT;
 		cbStatus = KNS_STATUS_TIMEOUT;
 		break;
@@ -306,7 +453,7 @@ enum KNS_status_t MGR_SPI_CMD_macEvtProcess(void)
 			 * * notify host with AT cmd response then
 			 * * free element from user data buffer.
 			 */
-			USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+			MGR_SPI_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 			macStatus = MAC_RX_ERROR;
 			cbStatus = KNS_STATUS_TR_ERR;
 		} else {
@@ -330,21 +477,25 @@ enum KNS_status_t MGR_SPI_CMD_macEvtProcess(void)
 		 * * notify host with AT cmd response then
 		 * * free element from user data buffer.
 		 */
-		USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+		MGR_SPI_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		macStatus = MAC_RX_TIMEOUT;
 		cbStatus = KNS_STATUS_TIMEOUT;
 	break;
 	case (KNS_MAC_OK):
 		MGR_LOG_DEBUG("MGR_SPI_CMD MAC reported OK to previous command.\r\n");
-		if (srvcEvt.app_evt == KNS_MAC_STOP_SEND_DATA)
+		if (srvcEvt->app_evt == KNS_MAC_STOP_SEND_DATA) {
+			for (eltNb = USERDATA_txFifoGetCount(); eltNb > 0; eltNb--)
+				MCU_MISC_RF_release();
 			kns_assert(USERDATA_txFifoFlush() == true);
+			MGR_SPI_CMD_flushPendingTxElts();
+		}
 		macStatus = MAC_OK;
 		cbStatus = KNS_STATUS_OK;
 	break;
 	case (KNS_MAC_ERROR):
 		MGR_LOG_DEBUG("MGR_SPI_CMD MAC reported ERROR to previous command.\r\n");
-		if (srvcEvt.app_evt == KNS_MAC_SEND_DATA)
-			USERDATA_txFifoRemoveElt(spUserDataMsg);/* Free as host notified */
+		if (srvcEvt->app_evt == KNS_MAC_SEND_DATA)
+			MGR_SPI_CMD_releaseTxElt(spUserDataMsg);/* Free as host notified */
 		macStatus = MAC_ERROR;
 		cbStatus = KNS_STATUS_ERROR;
 	break;
@@ -355,6 +506,12 @@ enum KNS_status_t MGR_SPI_CMD_macEvtProcess(void)
 	break;
 	}
 
+	MGR_SPI_CMD_macEvtRecord(srvcEvt->id, macStatus, u16MsgHandle);
+	KNS_Q_release(KNS_Q_UL_MAC2APP);
+
+	/** MAC popped some APP2MAC event before reporting it, pending elements may fit now */
+	MGR_SPI_CMD_pushPendingTxElts();
+
 	return cbStatus;
 }
 
@@ -19,8 +19,9 @@
 #include "mgr_spi_cmd_list_user_data.h"
 #include "mgr_spi_cmd_list_previpass.h"
 #include "mgr_spi_cmd_list_certif.h"
+#include "mgr_spi_cmd_list_regmap.h"
 
-const uint8_t spicmd_version = 1;
+const uint8_t spicmd_version = 9;
 
 /** @attention update AT cmd version above if you add or remove commands in this list */
 const struct spicmd_desc_t cas_spicmd_list_array[SPICMD_MAX_COUNT] = {
@@ -68,6 +69,28 @@ const struct spicmd_desc_t cas_spicmd_list_array[SPICMD_MAX_COUNT] = {
 	{ CMD_READ_TCXO_WU, CMD_NONE,         		    bMGR_SPI_CMD_READTCXO_cmd},
 	{ CMD_WRITE_TCXOWU_REQ, CMD_WRITE_TCXOWU, 	    bMGR_SPI_CMD_WRITETCXOREQ_cmd},
 	{ CMD_WRITE_TCXOWU, CMD_NONE,     				bMGR_SPI_CMD_WRITETCXO_cmd},
+	{ CMD_READ_QSTAT, CMD_NONE,     				bMGR_SPI_CMD_READQSTAT_cmd},
+	{ CMD_RESET_QSTAT, CMD_NONE,     				bMGR_SPI_CMD_RESETQSTAT_cmd},
+	{ CMD_WRITE_TXBATCH_REQ, CMD_WRITE_TXBATCH_SIZE, bMGR_SPI_CMD_WRITETXBATCHREQ_cmd},
+	{ CMD_WRITE_TXBATCH_SIZE, CMD_WRITE_TXBATCH,    bMGR_SPI_CMD_WRITETXBATCHSIZE_cmd},
+	{ CMD_WRITE_TXBATCH, CMD_NONE,     				bMGR_SPI_CMD_WRITETXBATCH_cmd},
+	{ CMD_READ_TCXO_STAT, CMD_NONE,     			bMGR_SPI_CMD_READTCXOSTAT_cmd},
+	{ CMD_WRITE_TCXOHOLD_REQ, CMD_WRITE_TCXOHOLD,   bMGR_SPI_CMD_WRITETCXOHOLDREQ_cmd},
+	{ CMD_WRITE_TCXOHOLD, CMD_NONE,     			bMGR_SPI_CMD_WRITETCXOHOLD_cmd},
+	{ CMD_WRITE_TXCHUNK_REQ, CMD_WRITE_TXCHUNK_HDR, bMGR_SPI_CMD_WRITETXCHUNKREQ_cmd},
+	{ CMD_WRITE_TXCHUNK_HDR, CMD_WRITE_TXCHUNK,     bMGR_SPI_CMD_WRITETXCHUNKHDR_cmd},
+	{ CMD_WRITE_TXCHUNK, CMD_NONE,     				bMGR_SPI_CMD_WRITETXCHUNK_cmd},
+	{ CMD_WRITE_TXCOMMIT, CMD_NONE,     			bMGR_SPI_CMD_WRITETXCOMMIT_cmd},
+	{ CMD_READ_ATTN, CMD_NONE,     					bMGR_SPI_CMD_READATTN_cmd},
+	{ CMD_WRITE_ATTN_REQ, CMD_WRITE_ATTN,           bMGR_SPI_CMD_WRITEATTNREQ_cmd},
+	{ CMD_WRITE_ATTN, CMD_NONE,     				bMGR_SPI_CMD_WRITEATTN_cmd},
+	{ CMD_READ_MACEVT_REQ, CMD_READ_MACEVT,         bMGR_SPI_CMD_READMACEVTREQ_cmd},
+	{ CMD_READ_MACEVT, CMD_NONE,     				bMGR_SPI_CMD_READMACEVT_cmd},
+	{ CMD_REG_READ_REQ, CMD_REG_READ,               bMGR_SPI_CMD_REGREADREQ_cmd},
+	{ CMD_REG_READ, CMD_NONE,     					bMGR_SPI_CMD_REGREAD_cmd},
+	{ CMD_REG_WRITE_REQ, CMD_REG_WRITE_HDR,         bMGR_SPI_CMD_REGWRITEREQ_cmd},
+	{ CMD_REG_WRITE_HDR, CMD_REG_WRITE,             bMGR_SPI_CMD_REGWRITEHDR_cmd},
+	{ CMD_REG_WRITE, CMD_NONE,     					bMGR_SPI_CMD_REGWRITE_cmd},
 };
 
 /**
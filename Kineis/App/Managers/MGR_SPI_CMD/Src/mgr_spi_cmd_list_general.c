@@ -18,7 +18,9 @@
 #include "mcu_spi_driver.h"
 #include "mgr_spi_cmd_common.h"
 #include "mgr_spi_cmd_list.h"
+#include "mgr_spi_cmd_list_regmap.h"
 #include "mgr_spi_cmd_list_general.h"
+#include "mgr_spi_cmd.h"
 //#include "mgr_spi_cmd_list_user_data.h"
 /* @todo PRODEV-69: remove specific flag when HW setting check is implemented on all platforms */
 #include "kns_cfg.h"
@@ -29,8 +31,15 @@
 #include "lpm.h"
 #include "mcu_nvm.h"
 #include "mcu_misc.h"
+#include "kns_q.h"
 
 
+/* Defines -------------------------------------------------------------------*/
+
+#if ((CMD_READMACEVT_HDR_LEN + MGR_SPI_CMD_EVT_FIFO_SIZE * CMD_READMACEVT_REC_LEN) > TXBUF_SIZE)
+#error "SPI TX buffer cannot hold the whole MAC event FIFO"
+#endif
+
 /* Functions -----------------------------------------------------------------*/
 
 bool bMGR_SPI_CMD_READ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
@@ -79,6 +88,7 @@ bool bMGR_SPI_CMD_MACSTATUS_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 	{
 		// reset Mac status after read if
 		macStatus = MAC_OK;
+		MGR_SPI_CMD_attnAck(MGR_SPI_CMD_ATTN_MAC_ALL);
 		return true;
 	} else {
 		return false;
@@ -122,142 +132,36 @@ bool bMGR_SPI_CMD_READSPIVERSION_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 
 bool bMGR_SPI_CMD_READFIRMWARE_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-
-	memcpy(&tx->data[0], uc_fw_vers_commit_id, FW_VERSION_LENGTH);  // Copy the entire fixed-length string
-	tx->next_req = FW_VERSION_LENGTH;  // Total bytes to send
-	ret = bMGR_SPI_DRIVER_writeread();
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
+	return bMGR_SPI_CMD_REG_readOne(MGR_SPI_CMD_REG_FW, rx, tx);
 }
 
 bool bMGR_SPI_CMD_READADDRESS_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-
-	uint8_t dev_addr[DEVICE_ADDR_LENGTH];
-	if (KNS_CFG_getAddr(dev_addr) != KNS_STATUS_OK)
-	{
-		return bMGR_SPI_CMD_logFailedMsg(ERROR_INVALID_ID, tx);
-	}
-	memcpy(&tx->data[0], dev_addr, DEVICE_ADDR_LENGTH);
-	tx->next_req = DEVICE_ADDR_LENGTH;
-	ret = bMGR_SPI_DRIVER_writeread();
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
+	return bMGR_SPI_CMD_REG_readOne(MGR_SPI_CMD_REG_ADDR, rx, tx);
 }
 bool bMGR_SPI_CMD_WRITEADDRESSREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
-	// Give size
-	HAL_StatusTypeDef ret = HAL_OK;
-	tx->data[0] = rx->data[0];
-	rx->next_req = CMD_WRITEADDRESS_WAIT_LEN;
-	ret = bMGR_SPI_DRIVER_read();
-
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
+	return bMGR_SPI_CMD_REG_writeOneReq(MGR_SPI_CMD_REG_ADDR, rx, tx);
 }
 
 bool bMGR_SPI_CMD_WRITEADDRESS_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-	if (MCU_NVM_setAddr(&(rx->data[1])) != KNS_STATUS_OK)
-	{
-		MGR_LOG_DEBUG("Faile to write ADDR=%02x%02x%02x%02x\r\n", rx->data[1], rx->data[2],
-								  rx->data[3], rx->data[4]);
-        return bMGR_SPI_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT, tx);
-	} else {
-		MGR_LOG_DEBUG("Set new ADDR=%02x%02x%02x%02x\r\n", rx->data[1], rx->data[2],
-								  rx->data[3], rx->data[4]);
-	}
-	rx->next_req = 1;
-	ret = bMGR_SPI_DRIVER_read();
-
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
+	return bMGR_SPI_CMD_REG_writeOne(MGR_SPI_CMD_REG_ADDR, rx, tx);
 }
 
-bool bMGR_SPI_CMD_READSECKEY_cmd(SPI_Buffer *rx, SPI_Buffer *tx) {
-	HAL_StatusTypeDef ret = HAL_OK;
-
-	uint8_t dev_seckey[DSK_BYTE_LENGTH];
-	if (MCU_AES_get_device_sec_key(dev_seckey) != KNS_STATUS_OK)
-	{
-		return bMGR_SPI_CMD_logFailedMsg(ERROR_UNKNOWN, tx);
-	}
-	memcpy(&tx->data[0], dev_seckey, DSK_BYTE_LENGTH);
-	tx->next_req = DSK_BYTE_LENGTH;
-	ret = bMGR_SPI_DRIVER_writeread();
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
-
+bool bMGR_SPI_CMD_READSECKEY_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_readOne(MGR_SPI_CMD_REG_SECKEY, rx, tx);
 }
 
-bool bMGR_SPI_CMD_WRITESECKEYREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx) {
-	HAL_StatusTypeDef ret = HAL_OK;
-	tx->data[0] = rx->data[0];
-	rx->next_req = CMD_WRITESECKEY_WAIT_LEN;
-	ret = bMGR_SPI_DRIVER_read();
-
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
+bool bMGR_SPI_CMD_WRITESECKEYREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_writeOneReq(MGR_SPI_CMD_REG_SECKEY, rx, tx);
 }
 
-bool bMGR_SPI_CMD_WRITESECKEY_cmd(SPI_Buffer *rx, SPI_Buffer *tx) {
-	HAL_StatusTypeDef ret = HAL_OK;
-	char sec_key_str[33];
-	for (int i = 0; i < 16; i++) {
-		sprintf(&sec_key_str[i * 2], "%02x", rx->data[i+1]);
-	}
-	sec_key_str[32] = '\0';
-	if (MCU_AES_set_device_sec_key(&(rx->data[1])) != KNS_STATUS_OK)
-	{
-		MGR_LOG_DEBUG("Failed to write SECKEY=%s\r\n",sec_key_str);
-        return bMGR_SPI_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT, tx);
-	} else {
-		MGR_LOG_DEBUG("Set new SECKEY=%s\r\n", sec_key_str);
-	}
-	rx->next_req = 1;
-	ret = bMGR_SPI_DRIVER_read();
-
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
-
+bool bMGR_SPI_CMD_WRITESECKEY_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_writeOne(MGR_SPI_CMD_REG_SECKEY, rx, tx);
 }
 
 
@@ -276,6 +180,7 @@ bool bMGR_SPI_CMD_READSPIMACSTATE_cmd(SPI_Buffer *rx, SPI_Buffer *tx){
 	{
 		// reset Mac status after read if
 		macStatus = MAC_OK;
+		MGR_SPI_CMD_attnAck(MGR_SPI_CMD_ATTN_MAC_ALL);
 		return true;
 	} else {
 		return false;
@@ -284,119 +189,27 @@ bool bMGR_SPI_CMD_READSPIMACSTATE_cmd(SPI_Buffer *rx, SPI_Buffer *tx){
 
 bool bMGR_SPI_CMD_READID_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-
-	uint32_t dev_id;
-	if (KNS_CFG_getId(&dev_id) != KNS_STATUS_OK)
-	{
-		return bMGR_SPI_CMD_logFailedMsg(ERROR_INVALID_ID, tx);
-			/* ID is printed as a number, with decimal representation.
-			 * ID is stored in memory in little endian format.
-			 */
-	}
-	tx->next_req = sizeof(dev_id);
-	memcpy(&tx->data[0], &dev_id, tx->next_req);
-
-	ret = bMGR_SPI_DRIVER_writeread();
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
+	return bMGR_SPI_CMD_REG_readOne(MGR_SPI_CMD_REG_ID, rx, tx);
 }
 
 bool bMGR_SPI_CMD_WRITEIDREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
-	// Give size
-	HAL_StatusTypeDef ret = HAL_OK;
-	tx->data[0] = rx->data[0];
-	rx->next_req = CMD_WRITEID_WAIT_LEN;
-	ret = bMGR_SPI_DRIVER_read();
-
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
+	return bMGR_SPI_CMD_REG_writeOneReq(MGR_SPI_CMD_REG_ID, rx, tx);
 }
 
 bool bMGR_SPI_CMD_WRITEID_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-
-//	uint32_t dev_id = (rx->data[1] << 24 ) |
-//					  (rx->data[2] << 16) |
-//					  (rx->data[3] << 8) |
-//					  (rx->data[4] << 0);
-	uint32_t dev_id = 0;
-	memcpy(&dev_id, &(rx->data[1]), sizeof(uint32_t));
-	if (MCU_NVM_setID(&dev_id) != KNS_STATUS_OK)
-	{
-		MGR_LOG_DEBUG("[ERROR] failed to set ID\r\n");
-        return bMGR_SPI_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT, tx);
-	} else {
-		MGR_LOG_DEBUG("New id : %u\r\n", dev_id);
-	}
-	rx->next_req = 1;
-	ret = bMGR_SPI_DRIVER_read();
-
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
+	return bMGR_SPI_CMD_REG_writeOne(MGR_SPI_CMD_REG_ID, rx, tx);
 }
 
 bool bMGR_SPI_CMD_READSN_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-
-	uint8_t dev_sn[DEVICE_SN_LENGTH +1];
-
-	if (KNS_CFG_getSN(dev_sn) != KNS_STATUS_OK)
-		/* TODO: add a new error code ? */
-		return bMGR_SPI_CMD_logFailedMsg(ERROR_INVALID_ID, tx);
-	dev_sn[DEVICE_SN_LENGTH] = '\0';
-	memcpy(&tx->data[0], dev_sn, sizeof(dev_sn));  // Copy the entire fixed-length string
-	tx->next_req = sizeof(dev_sn);  // Total bytes to send
-
-	ret = bMGR_SPI_DRIVER_writeread();
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
+	return bMGR_SPI_CMD_REG_readOne(MGR_SPI_CMD_REG_SN, rx, tx);
 }
 
 bool bMGR_SPI_CMD_READRCONF_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-
-	struct KNS_CFG_radio_t radio_cfg;
-
-	if (KNS_CFG_getRadioInfo(&radio_cfg) != KNS_STATUS_OK)
-		/* TODO: add a new error code ? */
-		return bMGR_SPI_CMD_logFailedMsg(ERROR_INVALID_ID, tx);
-
-	memcpy(&tx->data[0], &radio_cfg, sizeof(radio_cfg));  // Copy the entire fixed-length string
-	tx->next_req = sizeof(radio_cfg);  // Total bytes to send
-
-	ret = bMGR_SPI_DRIVER_writeread();
-	//Reset tx/rx state if MAC_OK
-	if (ret == HAL_OK)
-	{
-		return true;
-	} else {
-		return false;
-	}
+	return bMGR_SPI_CMD_REG_readOne(MGR_SPI_CMD_REG_RCONF, rx, tx);
 }
 
 bool bMGR_SPI_CMD_WRITERCONFREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
@@ -419,14 +232,16 @@ bool bMGR_SPI_CMD_WRITERCONF_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
 	HAL_StatusTypeDef ret = HAL_OK;
 	uint16_t nbBits = u16MGR_AT_CMD_convertAsciiBinary(&(rx->data[1]), CMD_WRITERCONF_WAIT_LEN - 1); // -1 to remove cmd len
+	enum ERROR_RETURN_T err;
 
 	if (nbBits != 128)
 		/* TODO: add a new error code ? */
 		return bMGR_SPI_CMD_logFailedMsg(ERROR_INVALID_ID, tx);
 
-	if (KNS_CFG_setRadioInfo(&(rx->data[1])) != KNS_STATUS_OK)
-		/* TODO: add a new error code ? */
-		return bMGR_AT_CMD_logFailedMsg(ERROR_INVALID_ID);
+	/** Legacy command gets the bloc as hexadecimal string */
+	err = eMGR_SPI_CMD_REG_write(MGR_SPI_CMD_REG_RCONF_ENC, 1, &(rx->data[1]));
+	if (err != ERROR_NO)
+		return bMGR_SPI_CMD_logFailedMsg(err, tx);
 
 	rx->next_req = 1;
 	ret = bMGR_SPI_DRIVER_read();
@@ -461,11 +276,46 @@ bool bMGR_SPI_CMD_SAVERCONF_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 }
 
 bool bMGR_SPI_CMD_READLPM_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_readOne(MGR_SPI_CMD_REG_LPM, rx, tx);
+}
+
+bool bMGR_SPI_CMD_WRITELPMREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_writeOneReq(MGR_SPI_CMD_REG_LPM, rx, tx);
+}
+bool bMGR_SPI_CMD_WRITELPM_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_writeOne(MGR_SPI_CMD_REG_LPM, rx, tx);
+}
+
+bool bMGR_SPI_CMD_READTCXO_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_readOne(MGR_SPI_CMD_REG_TCXO_WU, rx, tx);
+}
+
+bool bMGR_SPI_CMD_WRITETCXOREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_writeOneReq(MGR_SPI_CMD_REG_TCXO_WU, rx, tx);
+}
+
+bool bMGR_SPI_CMD_WRITETCXO_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_writeOne(MGR_SPI_CMD_REG_TCXO_WU, rx, tx);
+}
+
+bool bMGR_SPI_CMD_READTCXOSTAT_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
 	HAL_StatusTypeDef ret = HAL_OK;
+	uint32_t tcxo_ms;
 
-	tx->data[0] = lpm_config.allowedLPMbitmap;
-	tx->next_req = 1;
+	MCU_MISC_TCXO_get_warmup(&tcxo_ms);
+	memcpy(&tx->data[0], &tcxo_ms, sizeof(uint32_t));
+	MCU_MISC_TCXO_get_hold(&tcxo_ms);
+	memcpy(&tx->data[4], &tcxo_ms, sizeof(uint32_t));
+	MCU_MISC_TCXO_get_measured_warmup(&tcxo_ms);
+	memcpy(&tx->data[8], &tcxo_ms, sizeof(uint32_t));
+	tx->next_req = CMD_READTCXOSTAT_LEN;
 	rx->next_req = 1;
 	ret = bMGR_SPI_DRIVER_writeread();
 
@@ -477,13 +327,27 @@ bool bMGR_SPI_CMD_READLPM_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 	}
 }
 
-bool bMGR_SPI_CMD_WRITELPMREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+bool bMGR_SPI_CMD_WRITETCXOHOLDREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_writeOneReq(MGR_SPI_CMD_REG_TCXO_HOLD, rx, tx);
+}
+
+bool bMGR_SPI_CMD_WRITETCXOHOLD_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	return bMGR_SPI_CMD_REG_writeOne(MGR_SPI_CMD_REG_TCXO_HOLD, rx, tx);
+}
+
+bool bMGR_SPI_CMD_READATTN_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
 	HAL_StatusTypeDef ret = HAL_OK;
-	txBuf.data[0] = rx->data[0];
-	rxBuf.next_req = CMD_WRITELPM_WAIT_LEN; // Only waiting profile id for the moment
-	ret = bMGR_SPI_DRIVER_read();
-	//Reset tx/rx state if MAC_OK
+
+	tx->data[0] = MGR_SPI_CMD_attnGetMask();
+	/** This response is not ready yet, do not report it */
+	tx->data[1] = MGR_SPI_CMD_attnGetPending() & ~MGR_SPI_CMD_ATTN_CMD_RSP;
+	tx->next_req = CMD_READATTN_LEN;
+	rx->next_req = 1;
+	ret = bMGR_SPI_DRIVER_writeread();
+
 	if (ret == HAL_OK)
 	{
 		return true;
@@ -491,30 +355,37 @@ bool bMGR_SPI_CMD_WRITELPMREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 		return false;
 	}
 }
-bool bMGR_SPI_CMD_WRITELPM_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+
+bool bMGR_SPI_CMD_WRITEATTNREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
 	HAL_StatusTypeDef ret = HAL_OK;
 
-	uint8_t lpm = rx->data[1];  // Extract LPM value from rxBuf.data[1]
+	tx->data[0] = rx->data[0];
+	rx->next_req = CMD_WRITEATTN_WAIT_LEN;
+	ret = bMGR_SPI_DRIVER_read();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
 
-	// Define allowed low-power modes
-	const uint8_t allowedModes = LOW_POWER_MODE_NONE |
-								 LOW_POWER_MODE_SLEEP |
-								 LOW_POWER_MODE_STOP |
-								 LOW_POWER_MODE_STANDBY |
-								 LOW_POWER_MODE_SHUTDOWN;
+bool bMGR_SPI_CMD_WRITEATTN_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+	uint8_t mask = rx->data[1];
 
-	// Validate the received LPM value
-	if ((lpm & ~allowedModes) != 0) {
-		// Invalid value: contains bits outside the allowed set
+	if ((mask & ~MGR_SPI_CMD_ATTN_ALL) != 0) {
+		MGR_LOG_DEBUG("[ERROR] Attention mask should only contain bits of 0x%02x\r\n",
+			MGR_SPI_CMD_ATTN_ALL);
 		return bMGR_SPI_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT, tx);
 	}
-	lpm_config.allowedLPMbitmap = lpm;
-	tx->data[0] = rx->data[0];
-	rx->next_req = 1; // Only waiting profile id for the moment
+	MGR_SPI_CMD_attnSetMask(mask);
+	rx->next_req = 1;
 	ret = bMGR_SPI_DRIVER_read();
 
-	//Reset tx/rx state if MAC_OK
 	if (ret == HAL_OK)
 	{
 		return true;
@@ -523,17 +394,14 @@ bool bMGR_SPI_CMD_WRITELPM_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 	}
 }
 
-bool bMGR_SPI_CMD_READTCXO_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+bool bMGR_SPI_CMD_READMACEVTREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
 	HAL_StatusTypeDef ret = HAL_OK;
 
-	uint32_t tcxo_ms;
-	MCU_MISC_TCXO_get_warmup(&tcxo_ms);
-	tx->next_req = sizeof(tcxo_ms);
-	memcpy(&tx->data[0], &tcxo_ms, tx->next_req);
+	tx->data[0] = rx->data[0];
+	rx->next_req = CMD_READMACEVT_WAIT_LEN;
+	ret = bMGR_SPI_DRIVER_read();
 
-	ret = bMGR_SPI_DRIVER_writeread();
-	//Reset tx/rx state if MAC_OK
 	if (ret == HAL_OK)
 	{
 		return true;
@@ -542,15 +410,38 @@ bool bMGR_SPI_CMD_READTCXO_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 	}
 }
 
-bool bMGR_SPI_CMD_WRITETCXOREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+bool bMGR_SPI_CMD_READMACEVT_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
-	// Give size
 	HAL_StatusTypeDef ret = HAL_OK;
-	tx->data[0] = rx->data[0];
-	rx->next_req = CMD_WRITETCXO_WAIT_LEN;
-	ret = bMGR_SPI_DRIVER_read();
+	struct MGR_SPI_CMD_evtRec_t rec;
+	uint8_t maxNb = rx->data[1];
+	uint8_t nb = 0;
+	uint8_t *ptr = &tx->data[CMD_READMACEVT_HDR_LEN];
+
+	if ((maxNb == 0) || (maxNb > MGR_SPI_CMD_EVT_FIFO_SIZE)) {
+		MGR_LOG_DEBUG("[ERROR] Number of MAC events should be between 1 to %d\r\n",
+			MGR_SPI_CMD_EVT_FIFO_SIZE);
+		return bMGR_SPI_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT, tx);
+	}
+
+	while ((nb < maxNb) && MGR_SPI_CMD_evtPop(&rec)) {
+		*ptr++ = rec.evtId;
+		*ptr++ = rec.status;
+		memcpy(ptr, &rec.msgHandle, sizeof(uint16_t));
+		ptr += sizeof(uint16_t);
+		memcpy(ptr, &rec.timeMs, sizeof(uint32_t));
+		ptr += sizeof(uint32_t);
+		nb++;
+	}
+	/** Fixed length reply, host knows how many bytes to clock out */
+	memset(ptr, 0, (maxNb - nb) * CMD_READMACEVT_REC_LEN);
+	tx->data[0] = nb;
+	tx->data[1] = MGR_SPI_CMD_evtGetCount();
+	tx->data[2] = MGR_SPI_CMD_evtTakeDropped();
+	tx->next_req = CMD_READMACEVT_HDR_LEN + maxNb * CMD_READMACEVT_REC_LEN;
+	rx->next_req = 1;
+	ret = bMGR_SPI_DRIVER_writeread();
 
-	//Reset tx/rx state if MAC_OK
 	if (ret == HAL_OK)
 	{
 		return true;
@@ -559,23 +450,49 @@ bool bMGR_SPI_CMD_WRITETCXOREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 	}
 }
 
-bool bMGR_SPI_CMD_WRITETCXO_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+bool bMGR_SPI_CMD_READQSTAT_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
 	HAL_StatusTypeDef ret = HAL_OK;
+	struct KNS_Q_stats_t stats;
+	enum KNS_Q_handle_t qHandle;
+	uint8_t *ptr = &tx->data[0];
+
+	for (qHandle = 0; qHandle < KNS_Q_MAX; qHandle++) {
+		KNS_Q_getStats(qHandle, &stats);
+		*ptr++ = stats.capacity;
+		*ptr++ = stats.depth;
+		*ptr++ = stats.hwm;
+		memcpy(ptr, &stats.pushCnt, sizeof(uint32_t));
+		ptr += sizeof(uint32_t);
+		memcpy(ptr, &stats.popCnt, sizeof(uint32_t));
+		ptr += sizeof(uint32_t);
+		memcpy(ptr, &stats.qfullCnt, sizeof(uint32_t));
+		ptr += sizeof(uint32_t);
+		memcpy(ptr, &stats.maxResidenceMs, sizeof(uint32_t));
+		ptr += sizeof(uint32_t);
+	}
+	tx->next_req = CMD_READQSTAT_LEN;
+	rx->next_req = 1;
+	ret = bMGR_SPI_DRIVER_writeread();
 
-	uint32_t tcxo_ms = 0;
-	memcpy(&tcxo_ms, &(rx->data[1]), sizeof(uint32_t));
-	if (tcxo_ms >30000) {
-		// Invalid value: outside the allowed range
-		MGR_LOG_DEBUG("[ERROR] TCXO Warmup time in ms should be between 0 to 30 000\r\n");
-        return bMGR_SPI_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT, tx);
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
 	}
-	MCU_MISC_TCXO_set_warmup(tcxo_ms);
-	MGR_LOG_DEBUG("Set TCXO warmup ms to %u\r\n", tcxo_ms);
+}
+
+bool bMGR_SPI_CMD_RESETQSTAT_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+
+	KNS_Q_resetStats();
+	tx->data[0] = 1;
+	tx->next_req = 1;
 	rx->next_req = 1;
-	ret = bMGR_SPI_DRIVER_read();
+	ret = bMGR_SPI_DRIVER_writeread();
 
-	//Reset tx/rx state if MAC_OK
 	if (ret == HAL_OK)
 	{
 		return true;
@@ -0,0 +1,499 @@
+// SPDX-License-Identifier: no SPDX license
+/**
+ * @file mgr_spi_cmd_list_regmap.c
+ * @author  Arribada
+ * @brief register map of device configuration and SPI register burst commands
+ */
+
+/**
+ * @addtogroup MGR_SPI_CMD
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "kns_types.h"
+#include "mcu_spi_driver.h"
+#include "mgr_spi_cmd_common.h"
+#include "mgr_spi_cmd_list.h"
+#include "mgr_spi_cmd_list_regmap.h"
+#include "kns_cfg.h"
+#include "kns_mac.h"
+#include "kns_q.h"
+#include "lpm.h"
+#include "build_info.h"
+#include "mgr_log.h"
+#include "mcu_nvm.h"
+#include "mcu_aes.h"
+#include "mcu_misc.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define MGR_SPI_CMD_REG_TCXO_WU_MAX_MS 30000 /**< Maximum TCXO warm-up time */
+
+/* Private variables ---------------------------------------------------------*/
+
+/** Burst announced by CMD_REG_WRITE_HDR, count is 0 when no burst is waiting for its values */
+static uint8_t u8RegWrAddr;
+static uint8_t u8RegWrCount;
+
+/* Register getters/setters --------------------------------------------------*/
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getId(uint8_t *val)
+{
+	uint32_t dev_id;
+
+	if (KNS_CFG_getId(&dev_id) != KNS_STATUS_OK)
+		return ERROR_INVALID_ID;
+	memcpy(val, &dev_id, sizeof(dev_id));
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_setId(uint8_t *val)
+{
+	uint32_t dev_id;
+
+	memcpy(&dev_id, val, sizeof(dev_id));
+	if (MCU_NVM_setID(&dev_id) != KNS_STATUS_OK) {
+		MGR_LOG_DEBUG("[ERROR] failed to set ID\r\n");
+		return ERROR_PARAMETER_FORMAT;
+	}
+	MGR_LOG_DEBUG("New id : %u\r\n", dev_id);
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getAddr(uint8_t *val)
+{
+	if (KNS_CFG_getAddr(val) != KNS_STATUS_OK)
+		return ERROR_INVALID_ID;
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_setAddr(uint8_t *val)
+{
+	if (MCU_NVM_setAddr(val) != KNS_STATUS_OK) {
+		MGR_LOG_DEBUG("Faile to write ADDR=%02x%02x%02x%02x\r\n", val[0], val[1], val[2],
+			val[3]);
+		return ERROR_PARAMETER_FORMAT;
+	}
+	MGR_LOG_DEBUG("Set new ADDR=%02x%02x%02x%02x\r\n", val[0], val[1], val[2], val[3]);
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getSecKey(uint8_t *val)
+{
+	if (MCU_AES_get_device_sec_key(val) != KNS_STATUS_OK)
+		return ERROR_UNKNOWN;
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_setSecKey(uint8_t *val)
+{
+	if (MCU_AES_set_device_sec_key(val) != KNS_STATUS_OK) {
+		MGR_LOG_DEBUG("Failed to write SECKEY\r\n");
+		return ERROR_PARAMETER_FORMAT;
+	}
+	MGR_LOG_DEBUG("Set new SECKEY\r\n");
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_setRconfEnc(uint8_t *val)
+{
+	if (KNS_CFG_setRadioInfo(val) != KNS_STATUS_OK)
+		/* TODO: add a new error code ? */
+		return ERROR_INVALID_ID;
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getLpm(uint8_t *val)
+{
+	val[0] = lpm_config.allowedLPMbitmap;
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_setLpm(uint8_t *val)
+{
+	const uint8_t allowedModes = LOW_POWER_MODE_NONE |
+				     LOW_POWER_MODE_SLEEP |
+				     LOW_POWER_MODE_STOP |
+				     LOW_POWER_MODE_STANDBY |
+				     LOW_POWER_MODE_SHUTDOWN;
+
+	/** Invalid value: contains bits outside the allowed set */
+	if ((val[0] & ~allowedModes) != 0)
+		return ERROR_PARAMETER_FORMAT;
+	lpm_config.allowedLPMbitmap = val[0];
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getTcxoWu(uint8_t *val)
+{
+	uint32_t tcxo_ms;
+
+	MCU_MISC_TCXO_get_warmup(&tcxo_ms);
+	memcpy(val, &tcxo_ms, sizeof(tcxo_ms));
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_setTcxoWu(uint8_t *val)
+{
+	uint32_t tcxo_ms;
+
+	memcpy(&tcxo_ms, val, sizeof(tcxo_ms));
+	if (tcxo_ms > MGR_SPI_CMD_REG_TCXO_WU_MAX_MS) {
+		MGR_LOG_DEBUG("[ERROR] TCXO Warmup time in ms should be between 0 to %d\r\n",
+			MGR_SPI_CMD_REG_TCXO_WU_MAX_MS);
+		return ERROR_PARAMETER_FORMAT;
+	}
+	MCU_MISC_TCXO_set_warmup(tcxo_ms);
+	MGR_LOG_DEBUG("Set TCXO warmup ms to %u\r\n", tcxo_ms);
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getTcxoHold(uint8_t *val)
+{
+	uint32_t hold_ms;
+
+	MCU_MISC_TCXO_get_hold(&hold_ms);
+	memcpy(val, &hold_ms, sizeof(hold_ms));
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_setTcxoHold(uint8_t *val)
+{
+	uint32_t hold_ms;
+
+	memcpy(&hold_ms, val, sizeof(hold_ms));
+	if (hold_ms > MCU_MISC_TCXO_HOLD_MAX_MS) {
+		MGR_LOG_DEBUG("[ERROR] TCXO hold time in ms should be between 0 to %d\r\n",
+			MCU_MISC_TCXO_HOLD_MAX_MS);
+		return ERROR_PARAMETER_FORMAT;
+	}
+	MCU_MISC_TCXO_set_hold(hold_ms);
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getKmac(uint8_t *val)
+{
+	struct KNS_MAC_prflInfo_t prfl_info;
+
+	KNS_MAC_getPrflInfo(&prfl_info);
+	val[0] = prfl_info.id;
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_setKmac(uint8_t *val)
+{
+	struct KNS_MAC_appEvt_t appEvt = {
+		.id = KNS_MAC_INIT,
+		.init_prfl_ctxt = {
+			.id =  KNS_MAC_PRFL_NONE,
+			.blindCfg = {0}
+		}
+	};
+
+	appEvt.init_prfl_ctxt.id = val[0];
+	switch (KNS_Q_push(KNS_Q_DL_APP2MAC, (void *)&appEvt)) {
+	case KNS_STATUS_QFULL:
+		return ERROR_DATA_QUEUE_FULL;
+	case KNS_STATUS_OK:
+		return ERROR_NO;
+	default:
+		return ERROR_UNKNOWN;
+	}
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getRconf(uint8_t *val)
+{
+	struct KNS_CFG_radio_t radio_cfg;
+
+	if (KNS_CFG_getRadioInfo(&radio_cfg) != KNS_STATUS_OK)
+		/* TODO: add a new error code ? */
+		return ERROR_INVALID_ID;
+	memcpy(val, &radio_cfg, sizeof(radio_cfg));
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getKmacInfo(uint8_t *val)
+{
+	struct KNS_MAC_prflInfo_t prfl_info;
+
+	KNS_MAC_getPrflInfo(&prfl_info);
+	val[0] = prfl_info.id;
+	memcpy(&val[1], &prfl_info.prflCfgPtr, sizeof(prfl_info) - 1);
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getSn(uint8_t *val)
+{
+	if (KNS_CFG_getSN(val) != KNS_STATUS_OK)
+		/* TODO: add a new error code ? */
+		return ERROR_INVALID_ID;
+	val[DEVICE_SN_LENGTH] = '\0';
+	return ERROR_NO;
+}
+
+static enum ERROR_RETURN_T eMGR_SPI_CMD_REG_getFw(uint8_t *val)
+{
+	memcpy(val, uc_fw_vers_commit_id, FW_VERSION_LENGTH);
+	return ERROR_NO;
+}
+
+/* Register map --------------------------------------------------------------*/
+
+/** @attention entries are indexed by register address, a missing one has no access and is
+ * rejected by \ref eMGR_SPI_CMD_REG_burstLen
+ */
+static const struct MGR_SPI_CMD_reg_t cas_regmap[MGR_SPI_CMD_REG_MAX] = {
+	[MGR_SPI_CMD_REG_ID] = { MGR_SPI_CMD_REG_ID, sizeof(uint32_t),
+		MGR_SPI_CMD_REG_RW, eMGR_SPI_CMD_REG_getId, eMGR_SPI_CMD_REG_setId },
+	[MGR_SPI_CMD_REG_ADDR] = { MGR_SPI_CMD_REG_ADDR, DEVICE_ADDR_LENGTH,
+		MGR_SPI_CMD_REG_RW, eMGR_SPI_CMD_REG_getAddr, eMGR_SPI_CMD_REG_setAddr },
+	[MGR_SPI_CMD_REG_SECKEY] = { MGR_SPI_CMD_REG_SECKEY, DSK_BYTE_LENGTH,
+		MGR_SPI_CMD_REG_RW, eMGR_SPI_CMD_REG_getSecKey, eMGR_SPI_CMD_REG_setSecKey },
+	[MGR_SPI_CMD_REG_RCONF_ENC] = { MGR_SPI_CMD_REG_RCONF_ENC, MGR_SPI_CMD_REG_RCONF_ENC_LEN,
+		MGR_SPI_CMD_REG_WR, NULL, eMGR_SPI_CMD_REG_setRconfEnc },
+	[MGR_SPI_CMD_REG_LPM] = { MGR_SPI_CMD_REG_LPM, sizeof(uint8_t),
+		MGR_SPI_CMD_REG_RW, eMGR_SPI_CMD_REG_getLpm, eMGR_SPI_CMD_REG_setLpm },
+	[MGR_SPI_CMD_REG_TCXO_WU] = { MGR_SPI_CMD_REG_TCXO_WU, sizeof(uint32_t),
+		MGR_SPI_CMD_REG_RW, eMGR_SPI_CMD_REG_getTcxoWu, eMGR_SPI_CMD_REG_setTcxoWu },
+	[MGR_SPI_CMD_REG_TCXO_HOLD] = { MGR_SPI_CMD_REG_TCXO_HOLD, sizeof(uint32_t),
+		MGR_SPI_CMD_REG_RW, eMGR_SPI_CMD_REG_getTcxoHold, eMGR_SPI_CMD_REG_setTcxoHold },
+	[MGR_SPI_CMD_REG_KMAC] = { MGR_SPI_CMD_REG_KMAC, sizeof(uint8_t),
+		MGR_SPI_CMD_REG_RW, eMGR_SPI_CMD_REG_getKmac, eMGR_SPI_CMD_REG_setKmac },
+	[MGR_SPI_CMD_REG_RCONF] = { MGR_SPI_CMD_REG_RCONF, sizeof(struct KNS_CFG_radio_t),
+		MGR_SPI_CMD_REG_RD, eMGR_SPI_CMD_REG_getRconf, NULL },
+	[MGR_SPI_CMD_REG_KMAC_INFO] = { MGR_SPI_CMD_REG_KMAC_INFO,
+		sizeof(struct KNS_MAC_prflInfo_t),
+		MGR_SPI_CMD_REG_RD, eMGR_SPI_CMD_REG_getKmacInfo, NULL },
+	[MGR_SPI_CMD_REG_SN] = { MGR_SPI_CMD_REG_SN, DEVICE_SN_LENGTH + 1,
+		MGR_SPI_CMD_REG_RD, eMGR_SPI_CMD_REG_getSn, NULL },
+	[MGR_SPI_CMD_REG_FW] = { MGR_SPI_CMD_REG_FW, FW_VERSION_LENGTH,
+		MGR_SPI_CMD_REG_RD, eMGR_SPI_CMD_REG_getFw, NULL },
+};
+
+/* Functions -----------------------------------------------------------------*/
+
+enum ERROR_RETURN_T eMGR_SPI_CMD_REG_burstLen(uint8_t addr, uint8_t count, uint8_t access,
+	uint16_t *len)
+{
+	uint8_t idx;
+
+	if ((count == 0) || (addr >= MGR_SPI_CMD_REG_MAX) ||
+	    (count > (MGR_SPI_CMD_REG_MAX - addr)))
+		return ERROR_PARAMETER_FORMAT;
+
+	*len = 0;
+	for (idx = addr; idx < (addr + count); idx++) {
+		if ((cas_regmap[idx].access & access) != access)
+			return ERROR_INCOMPATIBLE_VALUE;
+		*len += cas_regmap[idx].size;
+	}
+	return ERROR_NO;
+}
+
+enum ERROR_RETURN_T eMGR_SPI_CMD_REG_read(uint8_t addr, uint8_t count, uint8_t *buf)
+{
+	enum ERROR_RETURN_T err;
+	uint16_t len;
+	uint8_t idx;
+
+	err = eMGR_SPI_CMD_REG_burstLen(addr, count, MGR_SPI_CMD_REG_RD, &len);
+	for (idx = addr; (err == ERROR_NO) && (idx < (addr + count)); idx++) {
+		err = cas_regmap[idx].get(buf);
+		buf += cas_regmap[idx].size;
+	}
+	return err;
+}
+
+enum ERROR_RETURN_T eMGR_SPI_CMD_REG_write(uint8_t addr, uint8_t count, uint8_t *buf)
+{
+	enum ERROR_RETURN_T err;
+	uint16_t len;
+	uint8_t idx;
+
+	err = eMGR_SPI_CMD_REG_burstLen(addr, count, MGR_SPI_CMD_REG_WR, &len);
+	for (idx = addr; (err == ERROR_NO) && (idx < (addr + count)); idx++) {
+		err = cas_regmap[idx].set(buf);
+		buf += cas_regmap[idx].size;
+	}
+	return err;
+}
+
+bool bMGR_SPI_CMD_REG_readOne(uint8_t addr, SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+	enum ERROR_RETURN_T err;
+
+	err = eMGR_SPI_CMD_REG_read(addr, 1, &tx->data[0]);
+	if (err != ERROR_NO)
+		return bMGR_SPI_CMD_logFailedMsg(err, tx);
+	tx->next_req = cas_regmap[addr].size;
+	rx->next_req = 1;
+	ret = bMGR_SPI_DRIVER_writeread();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool bMGR_SPI_CMD_REG_writeOneReq(uint8_t addr, SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+
+	tx->data[0] = rx->data[0];
+	rx->next_req = cas_regmap[addr].size + 1; // Command + value
+	ret = bMGR_SPI_DRIVER_read();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool bMGR_SPI_CMD_REG_writeOne(uint8_t addr, SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+	enum ERROR_RETURN_T err;
+
+	err = eMGR_SPI_CMD_REG_write(addr, 1, &rx->data[1]);
+	if (err != ERROR_NO)
+		return bMGR_SPI_CMD_logFailedMsg(err, tx);
+	rx->next_req = 1;
+	ret = bMGR_SPI_DRIVER_read();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool bMGR_SPI_CMD_REGREADREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+
+	tx->data[0] = rx->data[0];
+	rx->next_req = CMD_REGBURST_WAIT_LEN;
+	ret = bMGR_SPI_DRIVER_read();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool bMGR_SPI_CMD_REGREAD_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+	enum ERROR_RETURN_T err;
+	uint8_t addr = rx->data[1];
+	uint8_t count = rx->data[2];
+	uint16_t len = 0;
+
+	err = eMGR_SPI_CMD_REG_burstLen(addr, count, MGR_SPI_CMD_REG_RD, &len);
+	if ((err == ERROR_NO) && (len > TXBUF_SIZE))
+		err = ERROR_TOO_MANY_PARAMETERS;
+	if (err == ERROR_NO)
+		err = eMGR_SPI_CMD_REG_read(addr, count, &tx->data[0]);
+	if (err != ERROR_NO) {
+		MGR_LOG_DEBUG("[ERROR] cannot read %u registers from 0x%02x\r\n", count, addr);
+		return bMGR_SPI_CMD_logFailedMsg(err, tx);
+	}
+	tx->next_req = len;
+	rx->next_req = 1;
+	ret = bMGR_SPI_DRIVER_writeread();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool bMGR_SPI_CMD_REGWRITEREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+
+	tx->data[0] = rx->data[0];
+	rx->next_req = CMD_REGBURST_WAIT_LEN; // Waiting REG_WRITE_HDR req
+	ret = bMGR_SPI_DRIVER_read();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool bMGR_SPI_CMD_REGWRITEHDR_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+	enum ERROR_RETURN_T err;
+	uint8_t addr = rx->data[1];
+	uint8_t count = rx->data[2];
+	uint16_t len = 0;
+
+	u8RegWrCount = 0;
+	err = eMGR_SPI_CMD_REG_burstLen(addr, count, MGR_SPI_CMD_REG_WR, &len);
+	/** Command + values shall fit in one SPI read */
+	if ((err == ERROR_NO) && (len >= RXBUF_SIZE))
+		err = ERROR_TOO_MANY_PARAMETERS;
+	if (err != ERROR_NO) {
+		MGR_LOG_DEBUG("[ERROR] cannot write %u registers from 0x%02x\r\n", count, addr);
+		return bMGR_SPI_CMD_logFailedMsg(err, tx);
+	}
+	u8RegWrAddr = addr;
+	u8RegWrCount = count;
+
+	tx->data[0] = rx->data[0];
+	rx->next_req = len + 1; // Command + values
+	ret = bMGR_SPI_DRIVER_read();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool bMGR_SPI_CMD_REGWRITE_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+	enum ERROR_RETURN_T err;
+	uint8_t count = u8RegWrCount;
+
+	/** Values are only expected once, right after their header */
+	u8RegWrCount = 0;
+	if (count == 0)
+		return bMGR_SPI_CMD_logFailedMsg(ERROR_MISSING_PARAMETERS, tx);
+
+	err = eMGR_SPI_CMD_REG_write(u8RegWrAddr, count, &rx->data[1]);
+	if (err != ERROR_NO)
+		return bMGR_SPI_CMD_logFailedMsg(err, tx);
+	rx->next_req = 1;
+	ret = bMGR_SPI_DRIVER_read();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * @}
+ */
@@ -19,18 +19,46 @@
 #include "user_data.h"
 #include "mgr_spi_cmd_list.h"
 #include "mgr_spi_cmd_list_user_data.h"
+#include "mgr_spi_cmd.h"
 #include "kns_q.h"
 #include "kns_mac.h"
 #include "kineis_sw_conf.h"  // for assert include below and ERROR_RETURN_T type
 #include KINEIS_SW_ASSERT_H
 #include "mgr_log.h"
 #include "mcu_misc.h"
+#include "strutil_lib.h"
 #ifdef USE_TX_LED // Light on a GPIO when TX occurs
 #include "main.h"
 #endif
 
 uint16_t userTxPayloadSize;
+/** Total size of the batched TX items, set by CMD_WRITE_TXBATCH_SIZE */
+static uint16_t userTxBatchSize;
+/** User data element filled chunk by chunk, reserved by first chunk, submitted on commit */
+static struct sUserDataTxFifoElt_t *spTxChunkElt;
+/** Offset and length of the chunk announced by CMD_WRITE_TXCHUNK_HDR */
+static uint16_t u16TxChunkOfs;
+static uint16_t u16TxChunkLen;
+/** Payload size of the chunked TX, i.e. end of the furthest chunk written */
+static uint16_t u16TxChunkEnd;
+/** User data elements accepted but not pushed to MAC yet, in submission order. They wait for RF
+ * power-up, or for some room in APP2MAC queue.
+ */
+static struct sUserDataTxFifoElt_t *apPendingElt[USERDATA_TX_FIFO_SIZE];
+static uint8_t u8PendingNb;
+/** RF power-up is on-going, pending elements are pushed once it is over */
+static bool bRfWaiting;
+/** Message handle of the last submitted element, 0 being never used */
+static uint16_t u16LastMsgHandle;
 /* Private macro -------------------------------------------------------------*/
+
+/** Maximum number of items of a batched TX, as many as USERDATA elements */
+#define MGR_SPI_CMD_TXBATCH_MAX_ITEM USERDATA_TX_FIFO_SIZE
+
+#if ((1 + MGR_SPI_CMD_TXBATCH_MAX_ITEM * CMD_WRITETXBATCH_RSP_ITEM) > TXBUF_SIZE)
+#error "SPI TX buffer cannot hold the TX batch response"
+#endif
+
 /* Private functions ----------------------------------------------------------*/
 
 /** @brief  Set/clear a GPIO around transmission
@@ -66,40 +94,143 @@ uint16_t userTxPayloadSize;
 //}
 //#endif
 
+/** @brief Queue a filled-up user data element for transmission
+ *
+ * The APP2MAC slot is reserved first, so that user data element is only added once the MAC event
+ * can be sent. Element is left reserved on failure.
+ *
+ * @param[in] spUserDataMsg: reserved element, with data, bit length and attribute set
+ *
+ * @return ERROR_NO if element is queued, SPI cmd error code otherwise
+ */
+static enum ERROR_RETURN_T eMGR_SPI_CMD_queueTxElt(struct sUserDataTxFifoElt_t *spUserDataMsg)
+{
+	enum KNS_status_t status;
+	struct KNS_MAC_appEvt_t *appEvtTx;
+
+	status = KNS_Q_reserve(KNS_Q_DL_APP2MAC, (void **)&appEvtTx);
+	switch (status) {
+		case KNS_STATUS_QFULL:
+			return ERROR_DATA_QUEUE_FULL;
+			break;
+		case KNS_STATUS_OK:
+			break;
+		default:
+			return ERROR_UNKNOWN;
+			break;
+	}
+
+	kns_assert(USERDATA_txFifoAddElt(spUserDataMsg, true));
+
+	appEvtTx->id = KNS_MAC_SEND_DATA;
+	memcpy(appEvtTx->data_ctxt.usrdata, spUserDataMsg->u8DataBuf,
+	       sizeof(appEvtTx->data_ctxt.usrdata));
+	appEvtTx->data_ctxt.usrdata_bitlen = spUserDataMsg->u16DataBitLen;
+	appEvtTx->data_ctxt.sf = (enum KNS_serviceFlag_t)(spUserDataMsg->u8Attr.sf);
 
+	KNS_Q_commit(KNS_Q_DL_APP2MAC);
+	return ERROR_NO;
+}
+
+/** @brief RF is ready, push user data elements received during its power-up to MAC, in order */
+static void MGR_SPI_CMD_rfReadyCb(void)
+{
+	bRfWaiting = false;
+	MGR_SPI_CMD_pushPendingTxElts();
+}
+
+/** @brief Submit a filled-up user data element for transmission, without waiting for RF
+ *
+ * Each element holds the RF until it leaves the TX FIFO (see MGR_SPI_CMD_macEvtProcess).
+ * Element is pushed to MAC right away if RF is ready (TCXO warm, PA powered) and APP2MAC queue has
+ * some room. Else it stays pending, and is pushed once RF power-up is over
+ * (\ref MGR_SPI_CMD_rfReadyCb) or MAC has consumed some event (\ref MGR_SPI_CMD_macEvtProcess).
+ * Elements submitted during the same power-up share it.
+ *
+ * Element gets a new message handle, one more than the previous submission (0 being skipped on
+ * wrap-around). It is returned in the TX response and reported with MAC events of the element, so
+ * the host can account for each message, even with identical payloads.
+ *
+ * @param[in] spUserDataMsg: reserved element, with data, bit length and attribute set
+ *
+ * @return ERROR_NO, element being queued or pending
+ */
+static enum ERROR_RETURN_T eMGR_SPI_CMD_submitTxElt(struct sUserDataTxFifoElt_t *spUserDataMsg)
+{
+	if (++u16LastMsgHandle == 0)
+		u16LastMsgHandle = 1;
+	spUserDataMsg->u16MsgHandle = u16LastMsgHandle;
+
+	if (!MCU_MISC_RF_acquire(MGR_SPI_CMD_rfReadyCb))
+		bRfWaiting = true;
+
+	/* Each pending element is a reserved one, thus pending list cannot overflow */
+	kns_assert(u8PendingNb < USERDATA_TX_FIFO_SIZE);
+	apPendingElt[u8PendingNb++] = spUserDataMsg;
+	MGR_SPI_CMD_pushPendingTxElts();
+	return ERROR_NO;
+}
 
 /* Public functions ----------------------------------------------------------*/
 
-uint16_t u16MGR_SPI_CMD_convertAsciiBinary(uint8_t *pu8InputBuffer, uint16_t u16_charNb)
+void MGR_SPI_CMD_pushPendingTxElts(void)
 {
-	uint16_t u16_index = 0;
-	uint8_t u8_high, u8_low;
+	while (!bRfWaiting && (u8PendingNb > 0)) {
+		switch (eMGR_SPI_CMD_queueTxElt(apPendingElt[0])) {
+		case ERROR_NO:
+			break;
+		case ERROR_DATA_QUEUE_FULL:
+			return; /* keep it pending, retried on next MAC event */
+		default:
+			/** SPI cmd is already answered, report through MAC status and event FIFO */
+			apPendingElt[0]->bIsToBeTransmit = false; /* release reserved element */
+			MCU_MISC_RF_release();
+			MGR_LOG_VERBOSE("[ERROR] cannot push new data to MAC.\r\n");
+			macStatus = MAC_ERROR;
+			MGR_SPI_CMD_macEvtRecord(KNS_MAC_ERROR, macStatus, apPendingElt[0]->u16MsgHandle);
+			break;
+		}
+		u8PendingNb--;
+		memmove(&apPendingElt[0], &apPendingElt[1], u8PendingNb * sizeof(apPendingElt[0]));
+	}
+}
 
-	for (u16_index = 0; u16_index < (u16_charNb / 2); u16_index++) {
-		u8_high = u8UTIL_convertCharToHex4bits(pu8InputBuffer[2 * u16_index]);
-		u8_low = u8UTIL_convertCharToHex4bits(pu8InputBuffer[2 * u16_index + 1]);
-		if ((u8_high != 0xFF) && (u8_low != 0xFF))
-			pu8InputBuffer[u16_index] = (u8_high << 4) | u8_low;
-		else
-			return 0;
+void MGR_SPI_CMD_flushPendingTxElts(void)
+{
+	for (; u8PendingNb > 0; u8PendingNb--) {
+		apPendingElt[u8PendingNb - 1]->bIsToBeTransmit = false;
+		MCU_MISC_RF_release();
 	}
+	/* RF ready callback may never come once last RF user is gone, next submission acquires RF */
+	bRfWaiting = false;
+	MGR_SPI_CMD_abortTxChunk();
+}
 
-	/** Case : characters number is an odd number */
-	if (u16_charNb % 2 != 0) {
-		u8_high = u8UTIL_convertCharToHex4bits(pu8InputBuffer[u16_charNb - 1]);
-		u8_low = 0;
-		if (u8_high != 0xFF)
-			pu8InputBuffer[u16_index++] = (u8_high << 4) | u8_low;
-		else
-			return 0;
+void MGR_SPI_CMD_abortTxChunk(void)
+{
+	if (spTxChunkElt != NULL) {
+		MGR_LOG_VERBOSE("[ERROR] chunked TX aborted.\r\n");
+		spTxChunkElt->bIsToBeTransmit = false; /* release reserved element */
+		spTxChunkElt = NULL;
 	}
+	u16TxChunkLen = 0;
+	u16TxChunkEnd = 0;
+}
+
+uint16_t u16MGR_SPI_CMD_convertAsciiBinary(uint8_t *pu8InputBuffer, uint16_t u16_charNb)
+{
+	uint16_t u16_index;
+
+	if (u16UTIL_convertHexStringToBin(pu8InputBuffer, u16_charNb, pu8InputBuffer) !=
+	    u16_charNb)
+		return 0;
 
 	/** Set other bytes to zero */
-	for (; u16_index < u16_charNb; u16_index++)
+	for (u16_index = (u16_charNb + 1) / 2; u16_index < u16_charNb; u16_index++)
 		pu8InputBuffer[u16_index] = 0;
 
 	/** Return data length in bits */
-	return (((u16_charNb / 2) * 8) + ((u16_charNb % 2) ? 4 : 0));
+	return u16_charNb * 4;
 }
 
 
@@ -135,7 +266,8 @@ bool bMGR_SPI_CMD_WRITETXSIZE_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 
 	userTxPayloadSize = (rx->data[1] <<8 )| rx->data[2];
 	tx->data[0] = rx->data[0];
-	if(userTxPayloadSize <= (USERDATA_TX_PAYLOAD_MAX_SIZE))
+	/** Command + payload shall fit in one SPI read, use chunked TX otherwise */
+	if ((userTxPayloadSize <= USERDATA_TX_PAYLOAD_MAX_SIZE) && (userTxPayloadSize < RXBUF_SIZE))
 	{
 		rx->next_req = userTxPayloadSize + 1; // Command + user mesage to send
 		ret = bMGR_SPI_DRIVER_read();
@@ -161,27 +293,13 @@ bool bMGR_SPI_CMD_WRITETX_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 {
 
 	HAL_StatusTypeDef ret = HAL_OK;
-	enum KNS_status_t status = KNS_STATUS_OK;
+	enum ERROR_RETURN_T eErr;
 	struct sUserDataTxFifoElt_t *spUserDataMsg;
 	union sUserDataAttribute_t u8UserDataAttr;
 	uint8_t *pu8UserDataBuf;
 	uint16_t u16UserDataBitlen;
 	uint16_t idx;
 
-	//	enum KNS_status_t knsStatus;
-	struct KNS_MAC_appEvt_t appEvtTx = {
-		.id = KNS_MAC_SEND_DATA,
-		.data_ctxt = {
-			.usrdata = {0},
-			.usrdata_bitlen = 0,      /* to be filled-up later below */
-			.sf = KNS_SF_NO_SERVICE,
-		}
-	};
-
-	MCU_MISC_TCXO_Force_State(true);
-	uint32_t tcxo_warmup_ms = 0;
-	MCU_MISC_TCXO_get_warmup(&tcxo_warmup_ms);
-	HAL_Delay(tcxo_warmup_ms);
 	spUserDataMsg = USERDATA_txFifoReserveElt();
 	if (spUserDataMsg != NULL) {
 
@@ -192,10 +310,8 @@ bool bMGR_SPI_CMD_WRITETX_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 		pu8UserDataBuf = spUserDataMsg->u8DataBuf;
 		kns_assert(pu8UserDataBuf != NULL);
 
-		// Copy the raw bytes received via SPI
-		//memcpy(pu8UserDataBuf, &(rx->data[1]), userTxPayloadSize);
-		for (idx = 0; idx < sizeof(spUserDataMsg->u8DataBuf); idx++)
-			pu8UserDataBuf[idx] = rx->data[1 + idx];
+		// Copy the raw bytes received via SPI, buffer may be longer than the transfer
+		memcpy(pu8UserDataBuf, &(rx->data[1]), userTxPayloadSize);
 
 		// Default attribute: raw data, no special service
 		u8UserDataAttr.u8_raw = 0x0;
@@ -205,36 +321,243 @@ bool bMGR_SPI_CMD_WRITETX_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 		spUserDataMsg->u16DataBitLen = u16UserDataBitlen;
 		spUserDataMsg->u8Attr = u8UserDataAttr;
 
-		// Add the message to the FIFO
-		kns_assert(USERDATA_txFifoAddElt(spUserDataMsg, true));
-
-		// Populate the application event structure
-		//memcpy(appEvtTx.data_ctxt.usrdata, spUserDataMsg->u8DataBuf, sizeof(appEvtTx.data_ctxt.usrdata));
-		for (idx = 0; idx < sizeof(appEvtTx.data_ctxt.usrdata); idx++)
-			appEvtTx.data_ctxt.usrdata[idx] = spUserDataMsg->u8DataBuf[idx];
-
-		appEvtTx.data_ctxt.usrdata_bitlen = spUserDataMsg->u16DataBitLen;
-		appEvtTx.data_ctxt.sf = (enum KNS_serviceFlag_t)(spUserDataMsg->u8Attr.sf);
-
-		 // Push the event to the MAC layer
-		status = KNS_Q_push(KNS_Q_DL_APP2MAC, (void *)&appEvtTx);
-		switch (status) {
-			case KNS_STATUS_QFULL:
-				MGR_LOG_VERBOSE("[ERROR] TX FIFO full, cannot push new data.\r\n");
-				return bMGR_SPI_CMD_logFailedMsg(ERROR_DATA_QUEUE_FULL, &txBuf);
-				break;
-			case KNS_STATUS_OK:
-				// Successfully pushed the event
-				break;
-			default:
-				MGR_LOG_VERBOSE("[ERROR] Unknown status when pushing TX data.\r\n");
-				return bMGR_SPI_CMD_logFailedMsg(ERROR_UNKNOWN, &txBuf);
-				break;
+		// Push the message to MAC, now or once RF is ready
+		eErr = eMGR_SPI_CMD_submitTxElt(spUserDataMsg);
+		if (eErr != ERROR_NO) {
+			MGR_LOG_VERBOSE("[ERROR] TX FIFO full, cannot push new data.\r\n");
+			return bMGR_SPI_CMD_logFailedMsg(eErr, &txBuf);
 		}
 	} else {
 		MGR_LOG_VERBOSE("[ERROR] TX FIFO full, cannot get extra data.\r\n");
 		return bMGR_SPI_CMD_logFailedMsg(ERROR_DATA_QUEUE_FULL, &txBuf);
 	}
+	tx->data[0] = 1;
+	memcpy(&tx->data[1], &spUserDataMsg->u16MsgHandle, sizeof(uint16_t));
+	tx->next_req = CMD_WRITETX_RSP_LEN;
+	rx->next_req = 1;
+	ret = bMGR_SPI_DRIVER_writeread();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * @brief
+ *
+ * @return true if command is correctly received and processed, false if error
+ */
+bool bMGR_SPI_CMD_WRITETXBATCHREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+
+	tx->data[0] = rx->data[0];
+	rx->next_req = CMD_WRITETXBATCH_WAIT_LEN; // Waiting TXBATCH_Size req
+	userTxBatchSize = 0;
+	ret = bMGR_SPI_DRIVER_read();
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * @brief
+ *
+ * @return true if command is correctly received and processed, false if error
+ */
+bool bMGR_SPI_CMD_WRITETXBATCHSIZE_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+
+	userTxBatchSize = (rx->data[1] << 8) | rx->data[2];
+	tx->data[0] = rx->data[0];
+	/** Command + batch shall fit in one SPI read */
+	if ((userTxBatchSize > CMD_WRITETXBATCH_ITEM_HDR) && (userTxBatchSize < RXBUF_SIZE))
+	{
+		rx->next_req = userTxBatchSize + 1; // Command + batched items
+		ret = bMGR_SPI_DRIVER_read();
+	} else {
+		macStatus = MAC_TX_SIZE_ERROR;
+		return bMGR_SPI_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT, tx);
+	}
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * @brief
+ *
+ * @return true if command is correctly received and processed, false if error
+ */
+bool bMGR_SPI_CMD_WRITETXBATCH_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+	struct sUserDataTxFifoElt_t *aspUserDataMsg[MGR_SPI_CMD_TXBATCH_MAX_ITEM];
+	const uint8_t *pu8Item = &rx->data[1];
+	const uint8_t *pu8BatchEnd = &rx->data[1 + userTxBatchSize];
+	uint8_t *pu8Rsp = &tx->data[1];
+	uint8_t u8ItemNb = 0;
+	uint8_t u8ReservedNb;
+	uint8_t u8AcceptedNb = 0;
+	uint16_t u16ItemLen;
+	uint8_t idx;
+	enum ERROR_RETURN_T eErr;
+
+	/** Check items are contiguous up to the batch end, before reserving anything. Item count is
+	 * bounded as it goes, a large RX buffer (e.g. HDA4) may hold more empty items than u8ItemNb
+	 * can count.
+	 */
+	while (pu8Item < pu8BatchEnd) {
+		if ((pu8BatchEnd - pu8Item) < (CMD_WRITETXBATCH_ITEM_HDR + pu8Item[0])) {
+			MGR_LOG_VERBOSE("[ERROR] TX batch is badly formatted.\r\n");
+			return bMGR_SPI_CMD_logFailedMsg(ERROR_PARAMETER_FORMAT, tx);
+		}
+		if (u8ItemNb == MGR_SPI_CMD_TXBATCH_MAX_ITEM) {
+			MGR_LOG_VERBOSE("[ERROR] TX batch has too many items.\r\n");
+			return bMGR_SPI_CMD_logFailedMsg(ERROR_TOO_MANY_PARAMETERS, tx);
+		}
+		pu8Item += CMD_WRITETXBATCH_ITEM_HDR + pu8Item[0];
+		u8ItemNb++;
+	}
+
+	u8ReservedNb = USERDATA_txFifoReserveElts(aspUserDataMsg, u8ItemNb);
+
+	pu8Item = &rx->data[1];
+	for (idx = 0; idx < u8ItemNb; idx++) {
+		u16ItemLen = pu8Item[0];
+		if (idx >= u8ReservedNb) {
+			eErr = ERROR_DATA_QUEUE_FULL;
+		} else if ((u16ItemLen == 0) || (u16ItemLen > USERDATA_TX_PAYLOAD_MAX_SIZE)) {
+			aspUserDataMsg[idx]->bIsToBeTransmit = false; /* release reserved element */
+			eErr = ERROR_INVALID_USER_DATA_LENGTH;
+		} else {
+			memset(aspUserDataMsg[idx]->u8DataBuf, 0,
+			       sizeof(aspUserDataMsg[idx]->u8DataBuf));
+			memcpy(aspUserDataMsg[idx]->u8DataBuf, &pu8Item[CMD_WRITETXBATCH_ITEM_HDR],
+			       u16ItemLen);
+			aspUserDataMsg[idx]->u16DataBitLen = u16ItemLen * 8;
+			aspUserDataMsg[idx]->u8Attr.u8_raw = pu8Item[1];
+			eErr = eMGR_SPI_CMD_submitTxElt(aspUserDataMsg[idx]);
+		}
+		pu8Rsp[0] = eErr;
+		if (eErr == ERROR_NO) {
+			memcpy(&pu8Rsp[1], &aspUserDataMsg[idx]->u16MsgHandle, sizeof(uint16_t));
+			u8AcceptedNb++;
+		} else {
+			memset(&pu8Rsp[1], 0, sizeof(uint16_t));
+		}
+		pu8Rsp += CMD_WRITETXBATCH_RSP_ITEM;
+		pu8Item += CMD_WRITETXBATCH_ITEM_HDR + u16ItemLen;
+	}
+
+	tx->data[0] = u8AcceptedNb;
+	tx->next_req = 1 + u8ItemNb * CMD_WRITETXBATCH_RSP_ITEM;
+	rx->next_req = 1;
+	ret = bMGR_SPI_DRIVER_writeread();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * @brief
+ *
+ * @return true if command is correctly received and processed, false if error
+ */
+bool bMGR_SPI_CMD_WRITETXCHUNKREQ_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+
+	tx->data[0] = rx->data[0];
+	rx->next_req = CMD_WRITETXCHUNK_WAIT_LEN; // Waiting TXCHUNK_HDR req
+	ret = bMGR_SPI_DRIVER_read();
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * @brief
+ *
+ * @return true if command is correctly received and processed, false if error
+ */
+bool bMGR_SPI_CMD_WRITETXCHUNKHDR_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+
+	u16TxChunkOfs = (rx->data[1] << 8) | rx->data[2];
+	u16TxChunkLen = (rx->data[3] << 8) | rx->data[4];
+	tx->data[0] = rx->data[0];
+	/** Command + chunk shall fit in one SPI read, chunk shall fit in user data element */
+	if ((u16TxChunkLen == 0) || (u16TxChunkLen >= RXBUF_SIZE) ||
+	    (u16TxChunkOfs > (USERDATA_TX_PAYLOAD_MAX_SIZE - u16TxChunkLen))) {
+		macStatus = MAC_TX_SIZE_ERROR;
+		return bMGR_SPI_CMD_logFailedMsg(ERROR_INVALID_USER_DATA_LENGTH, tx);
+	}
+
+	/** First chunk reserves the element, a chunk at offset 0 restarts the payload */
+	if (spTxChunkElt == NULL) {
+		spTxChunkElt = USERDATA_txFifoReserveElt();
+		if (spTxChunkElt == NULL) {
+			MGR_LOG_VERBOSE("[ERROR] TX FIFO full, cannot get extra data.\r\n");
+			return bMGR_SPI_CMD_logFailedMsg(ERROR_DATA_QUEUE_FULL, tx);
+		}
+		memset(spTxChunkElt->u8DataBuf, 0, sizeof(spTxChunkElt->u8DataBuf));
+		u16TxChunkEnd = 0;
+	} else if (u16TxChunkOfs == 0) {
+		memset(spTxChunkElt->u8DataBuf, 0, sizeof(spTxChunkElt->u8DataBuf));
+		u16TxChunkEnd = 0;
+	}
+
+	rx->next_req = u16TxChunkLen + 1; // Command + chunk data
+	ret = bMGR_SPI_DRIVER_read();
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * @brief
+ *
+ * @return true if command is correctly received and processed, false if error
+ */
+bool bMGR_SPI_CMD_WRITETXCHUNK_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+
+	/** Chunk data without a valid header (e.g. rejected one) is ignored */
+	if ((spTxChunkElt == NULL) || (u16TxChunkLen == 0)) {
+		MGR_LOG_VERBOSE("[ERROR] TX chunk without header.\r\n");
+		return bMGR_SPI_CMD_logFailedMsg(ERROR_INVALID_USER_DATA_LENGTH, tx);
+	}
+
+	/** Chunk goes straight from SPI RX buffer to its place in user data element */
+	memcpy(&spTxChunkElt->u8DataBuf[u16TxChunkOfs], &rx->data[1], u16TxChunkLen);
+	if ((u16TxChunkOfs + u16TxChunkLen) > u16TxChunkEnd)
+		u16TxChunkEnd = u16TxChunkOfs + u16TxChunkLen;
+	u16TxChunkLen = 0;
+
 	tx->data[0] = 1;
 	tx->next_req = 1;
 	rx->next_req = 1;
@@ -248,6 +571,49 @@ bool bMGR_SPI_CMD_WRITETX_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
 	}
 }
 
+/**
+ * @brief
+ *
+ * @return true if command is correctly received and processed, false if error
+ */
+bool bMGR_SPI_CMD_WRITETXCOMMIT_cmd(SPI_Buffer *rx, SPI_Buffer *tx)
+{
+	HAL_StatusTypeDef ret = HAL_OK;
+	struct sUserDataTxFifoElt_t *spUserDataMsg = spTxChunkElt;
+	enum ERROR_RETURN_T eErr;
+
+	spTxChunkElt = NULL;
+	u16TxChunkLen = 0;
+	if ((spUserDataMsg == NULL) || (u16TxChunkEnd == 0)) {
+		MGR_LOG_VERBOSE("[ERROR] No TX chunk to commit.\r\n");
+		if (spUserDataMsg != NULL)
+			spUserDataMsg->bIsToBeTransmit = false; /* release reserved element */
+		return bMGR_SPI_CMD_logFailedMsg(ERROR_INVALID_USER_DATA_LENGTH, tx);
+	}
+
+	spUserDataMsg->u16DataBitLen = u16TxChunkEnd * 8;
+	spUserDataMsg->u8Attr.u8_raw = 0x0;
+
+	// Push the message to MAC, now or once RF is ready
+	eErr = eMGR_SPI_CMD_submitTxElt(spUserDataMsg);
+	if (eErr != ERROR_NO) {
+		MGR_LOG_VERBOSE("[ERROR] TX FIFO full, cannot push new data.\r\n");
+		return bMGR_SPI_CMD_logFailedMsg(eErr, tx);
+	}
+
+	tx->data[0] = 1;
+	memcpy(&tx->data[1], &spUserDataMsg->u16MsgHandle, sizeof(uint16_t));
+	tx->next_req = CMD_WRITETX_RSP_LEN;
+	rx->next_req = 1;
+	ret = bMGR_SPI_DRIVER_writeread();
+
+	if (ret == HAL_OK)
+	{
+		return true;
+	} else {
+		return false;
+	}
+}
 
 /**
  * @}
@@ -17,6 +17,9 @@
  * The client of this wrapper should register a callback which will be invoked each time a new
  * character is received.
  *
+ * Some AT cmds (e.g. AT+TXB) are followed by a binary block. The client can then request the next
+ * characters to be stored as a raw block, without any line parsing.
+ *
  * **Transmission**
  *
  * On transmission side, it is possible to send strings on same base as classic printf fucntion.
@@ -69,6 +72,34 @@ bool (*rx_evt_cb)(uint8_t *pu8_RxBuffer, int16_t *pi16_nbRxValidChar));
 bool MCU_AT_CONSOLE_register(void *context,
 		bool (*rx_evt_cb)(uint8_t *pu8_RxBuffer, int16_t *pi16_nbRxValidChar));
 
+/** @brief Receive next characters as a raw binary block, without line parsing
+ *
+ * This is meant to be called from the RX callback, once it consumed an AT cmd line announcing a
+ * binary block. Characters received after that line are stored into the raw block until
+ * u16_len characters are received. Line parsing then resumes.
+ *
+ * The block is aborted if no character comes within MCU_AT_CONSOLE_RAW_TIMEOUT_MS after the
+ * previous one (or after the start of the block). The timeout runs on a software timer
+ * (MCU_TIM_SW_AT_RAW_GAP), so a truncated block is reported even if the host sends nothing else.
+ * Characters received after that are parsed as AT cmd lines.
+ *
+ * The format of client's callback is:
+ @verbatim
+void (*raw_evt_cb)(uint16_t u16_rxLen);
+ @endverbatim
+ * * [in] u16_rxLen number of raw characters received, lower than requested if block was aborted
+ *
+ * @attention This callback is called before any AT cmd line received after the block is handed to
+ * the RX callback. It may be called under interrupt context as well.
+ *
+ * @param[out] pu8_dst raw block destination, NULL to discard the block
+ * @param[in] u16_len raw block length in bytes
+ * @param[in] raw_evt_cb pointer to callback invoked once the block is complete or aborted
+ * @return true if raw reception is started, false if another raw block is ongoing.
+ */
+bool MCU_AT_CONSOLE_rxRaw(uint8_t *pu8_dst, uint16_t u16_len,
+		void (*raw_evt_cb)(uint16_t u16_rxLen));
+
 /** @brief Send AT CMD response to console
  *
  * This function is used to print AT command's response on AT console.
@@ -77,10 +108,21 @@ bool MCU_AT_CONSOLE_register(void *context,
  *
  * @note This could be redirected to printf if available in your application
  *
+ * @note When built with USE_UART_DMA_TX, the response is appended to a TX ring drained by DMA and
+ *       this function returns immediately. If the ring is full, it waits for DMA to free some room
+ *       up to MCU_AT_CONSOLE_TX_FULL_TIMEOUT_MS. The response is dropped on timeout or if called
+ *       from interrupt context, where waiting is not possible.
+ *
  * @param[in] format refer to printf manual pages
  */
 void MCU_AT_CONSOLE_send(const char *format, ...);
 
+/** @brief Check if some AT CMD response is still being sent on console
+ *
+ * @return true if TX is ongoing (always false when TX is blocking, i.e. without USE_UART_DMA_TX)
+ */
+bool MCU_AT_CONSOLE_isTxOngoing(void);
+
 /** @brief Write content of a binary data buffer as AT cmd response
  *
  * @param[in] pu8_inDataBuff: pointer to data buffer
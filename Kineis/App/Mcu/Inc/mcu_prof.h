@@ -0,0 +1,129 @@
+/* SPDX-License-Identifier: no SPDX license */
+/**
+ * @file    mcu_prof.h
+ * @brief   MCU wrapper for cycle profiling of Kineis OS tasks and main interrupts.
+ *
+ * Profiling is based on the Cortex-M4 DWT cycle counter (CYCCNT). Each profiled slot (one per
+ * Kineis OS task, one per main interrupt handler) records its call count, total and max cycles.
+ *
+ * The whole layer is compiled out when USE_MCU_PROF is not defined: MCU_PROF_START and
+ * MCU_PROF_STOP macros expand to nothing.
+ *
+ * @note Task cycles include the interrupts served while the task is running.
+ * @note The core clock, thus CYCCNT, is stopped in STOP mode: IDLE task cycles only account for
+ * the time the core is running.
+ *
+ * @author Arribada
+ */
+
+/**
+ * @addtogroup MCU_APP_WRAPPERS
+ * @brief MCU wrappers used by the Kineis Application example.
+ *
+ * One must implement these APIs according to the microcontroller and available platform resources.
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __MCU_PROF_H
+#define __MCU_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "kns_os.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#ifdef USE_MCU_PROF
+#include "kns_app_conf.h" // for STM32 HAL include
+#include STM32_HAL_H
+
+/** Start profiling current scope, only one START per scope */
+#define MCU_PROF_START() uint32_t mcuProfStartCyc = DWT->CYCCNT
+/** Stop profiling current scope and account elapsed cycles to the given slot */
+#define MCU_PROF_STOP(slot) MCU_PROF_record((slot), DWT->CYCCNT - mcuProfStartCyc)
+#else
+#define MCU_PROF_START()
+#define MCU_PROF_STOP(slot)
+#endif
+
+/* Types ---------------------------------------------------------------------*/
+
+/**
+ * @enum MCU_PROF_slot_t
+ * @brief Profiled slots, Kineis OS tasks first (same index as \ref KNS_OS_taskHdlr_t), then ISRs
+ */
+enum MCU_PROF_slot_t {
+	MCU_PROF_SLOT_ISR_LPUART = KNS_OS_TASK_MAX, /**< LPUART1 and its RX DMA interrupts (AT cmd RX) */
+	MCU_PROF_SLOT_ISR_SPI,      /**< SPI1 interrupt */
+	MCU_PROF_SLOT_ISR_TIM16,    /**< TIM16 interrupt (TX timeout) */
+	MCU_PROF_SLOT_ISR_RTC_WKUP, /**< RTC wakeup timer interrupt (TX period) */
+	MCU_PROF_SLOT_ISR_SUBGHZ,   /**< SUBGHZ radio interrupt */
+	MCU_PROF_SLOT_MAX
+};
+
+/**
+ * @struct MCU_PROF_stats_t
+ * @brief Profiling statistics of one slot
+ */
+struct MCU_PROF_stats_t {
+	uint32_t callCnt;   /**< number of calls */
+	uint64_t totalCyc;  /**< total cycles spent */
+	uint32_t maxCyc;    /**< longest call, in cycles */
+};
+
+/* Functions -----------------------------------------------------------------*/
+
+#ifdef USE_MCU_PROF
+/**
+ * @brief Enable DWT cycle counter and clear all statistics
+ */
+void MCU_PROF_init(void);
+
+/**
+ * @brief Account one call of a slot
+ *
+ * Called through \ref MCU_PROF_STOP. A slot must not be recorded concurrently from several
+ * contexts.
+ *
+ * @param[in] slot: profiled slot
+ * @param[in] cycles: cycles spent in this call
+ */
+void MCU_PROF_record(enum MCU_PROF_slot_t slot, uint32_t cycles);
+
+/**
+ * @brief Get a consistent copy of statistics of one slot
+ *
+ * @param[in] slot: profiled slot
+ * @param[out] stats: copy of slot statistics
+ */
+void MCU_PROF_getStats(enum MCU_PROF_slot_t slot, struct MCU_PROF_stats_t *stats);
+
+/**
+ * @brief Get printable name of a slot
+ *
+ * @param[in] slot: profiled slot
+ *
+ * @retval name of the slot
+ */
+const char *MCU_PROF_getName(enum MCU_PROF_slot_t slot);
+
+/**
+ * @brief Clear statistics of all slots
+ */
+void MCU_PROF_reset(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MCU_PROF_H */
+
+/**
+ * @}
+ */
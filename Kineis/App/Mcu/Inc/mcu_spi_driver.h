@@ -19,6 +19,27 @@
  *
  * @note The client's callback function will be invoked in interrupt context and must therefore execute quickly.
  *
+ * **DMA framing (USE_SPI_DMA)**
+ *
+ * Instead of one interrupt-driven transfer per command step, the host sends a whole command in one
+ * chip-select window, captured by DMA:
+ * | opcode | seq | len LSB | len MSB | payload (len bytes) |
+ *
+ * The command stream seen by the client is the opcode followed by the payload, i.e. the bytes the
+ * host would have sent through successive transfers without framing. Several commands may be
+ * chained in one frame. The NSS rising edge ends the frame: DMA is re-armed at once on the other
+ * RX buffer while the frame is processed. If both RX buffers are busy, the frame is dropped.
+ *
+ * The response of a frame is clocked out on MISO during a following frame, with the same header
+ * layout: request opcode, request seq, response length, then response bytes. The host may clock
+ * extra bytes to read a response longer than its request, and may send empty frames (len 0) to
+ * poll for a response not ready yet. Only the latest response is kept, the host reads it before
+ * sending the next command. A malformed frame is answered with
+ * \ref MCU_SPI_DRIVER_FRAME_NACK opcode and no payload.
+ *
+ * @attention The host must leave NSS high a few microseconds between frames, time for the driver
+ * to re-arm DMA.
+ *
  * @author Arribada
  */
 
@@ -53,13 +74,20 @@ extern "C" {
 #define RXBUF_SIZE 256
 #endif
 
+#ifdef USE_SPI_DMA
+/** Frame header length: opcode, sequence number, 16-bit little-endian payload length */
+#define MCU_SPI_DRIVER_FRAME_HDR_LEN 4
+/** Response opcode of a malformed frame (short header, length overflow, truncated command) */
+#define MCU_SPI_DRIVER_FRAME_NACK 0xFF
+#endif
+
 /**
  * @brief Structure representing an SPI data buffer.
  */
 typedef struct {
     uint8_t *data;      /**< Pointer to the data buffer */
     uint16_t size;      /**< Current size of valid data in the buffer */
-    uint8_t next_req;   /**< Number of elements expected to be read/sent next */
+    uint16_t next_req;  /**< Number of elements expected to be read/sent next, up to buffer size */
 } SPI_Buffer;
 
 extern SPI_Buffer rxBuf;   /**< Global SPI reception buffer */
@@ -80,7 +108,6 @@ typedef enum {
 } SpiState;
 
 extern SpiState spiState;         /**< Current state of the SPI console */
-extern uint32_t startTickTimeout; /**< Timeout tick value for SPI operations */
 
 /* Functions prototypes ------------------------------------------------------*/
 
@@ -122,18 +149,19 @@ void MCU_SPI_DRIVER_send(const char *format, ...);
 /**
  * @brief Perform an SPI read operation.
  *
- * This function initiates a read operation on the SPI interface.
+ * This function initiates a read operation on the SPI interface, of rxBuf.next_req bytes.
  *
- * @return HAL status of the read operation.
+ * @return HAL status of the read operation, HAL_ERROR if rxBuf.next_req exceeds RXBUF_SIZE.
  */
 HAL_StatusTypeDef MCU_SPI_DRIVER_read();
 
 /**
  * @brief Perform a simultaneous SPI write and read operation.
  *
- * This function initiates a write/read operation on the SPI interface.
+ * This function initiates a write/read operation on the SPI interface, of txBuf.next_req bytes.
  *
- * @return HAL status of the write/read operation.
+ * @return HAL status of the write/read operation, HAL_ERROR if txBuf.next_req exceeds
+ * TXBUF_SIZE.
  */
 HAL_StatusTypeDef MCU_SPI_DRIVER_writeread();
 
@@ -147,6 +175,26 @@ HAL_StatusTypeDef MCU_SPI_DRIVER_writeread();
  */
 void MCU_SPI_DRIVER_send_dataBuf(uint8_t *pu8_inDataBuff, uint16_t u16_dataLenBit);
 
+/**
+ * @brief Check a response is ready and not clocked out by the host yet.
+ *
+ * Without DMA framing, the response is the one armed by \ref MCU_SPI_DRIVER_writeread. With DMA
+ * framing, it is the last published frame response, until the host clocks a frame out of it.
+ *
+ * @return true if a response is waiting for the host, false otherwise.
+ */
+bool MCU_SPI_DRIVER_isRspReady(void);
+
+/**
+ * @brief Drive the attention line to the host.
+ *
+ * The line is an open-drain output, active low, so that the host may share it with other
+ * devices. It is only driven when compiled with USE_SPI_ATTN, this function does nothing otherwise.
+ *
+ * @param[in] active true to pull the line low, false to release it.
+ */
+void MCU_SPI_DRIVER_setAttn(bool active);
+
 /**
  * @brief Reset the SPI interface.
  *
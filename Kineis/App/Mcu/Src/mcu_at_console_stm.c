@@ -25,6 +25,9 @@
 #include STM32_HAL_H
 #include "kineis_sw_conf.h" // for assert include below
 #include KINEIS_SW_ASSERT_H
+#include "kns_os.h"
+#include "kns_cs.h"
+#include "mcu_tim.h"
 
 /* Defines -------------------------------------------------------------------*/
 #if defined(STM32WLE5xx) || defined(STM32WL55xx)
@@ -39,6 +42,25 @@
 #define RXBUF_SIZE 256
 #endif
 
+#ifdef USE_UART_DMA_RX
+/** DMA circular RX buffer size. It is drained at each half/full transfer or idle line event */
+#define RXDMA_BUF_SIZE 256
+#endif
+
+#ifdef USE_UART_DMA_TX
+/** TX ring size, drained by DMA. Must be able to hold at least one full formatted response */
+#define TXRING_SIZE (2 * TXBUF_SIZE)
+/** Max time to wait for DMA to free some room in a full TX ring, as the former blocking TX */
+#ifndef MCU_AT_CONSOLE_TX_FULL_TIMEOUT_MS
+#define MCU_AT_CONSOLE_TX_FULL_TIMEOUT_MS 500
+#endif
+#endif
+
+/** Max time between two characters of a raw block before it is aborted (see MCU_AT_CONSOLE_rxRaw) */
+#ifndef MCU_AT_CONSOLE_RAW_TIMEOUT_MS
+#define MCU_AT_CONSOLE_RAW_TIMEOUT_MS 100
+#endif
+
 /* Variables -----------------------------------------------------------------*/
 
 static UART_HandleTypeDef *huart_handle; /** This AT console needs some UART link */
@@ -46,9 +68,33 @@ static char uartTxBuf[TXBUF_SIZE];
 static uint8_t uartRxBuf[RXBUF_SIZE];
 
 static bool (*rxEvtCb)(uint8_t *pu8_RxBuffer, int16_t *pi16_nbRxValidChar);
+static const char hexDigits[] = "0123456789ABCDEF"; /** Nibble to ASCII hex char table */
+static volatile bool rxParsePending; /** RX parsing work already posted to Kineis OS */
+static void (*rxRawCb)(uint16_t u16_rxLen); /** Raw block client callback, NULL in line mode */
+static uint8_t *rxRawBuf;            /** Raw block destination, NULL to discard the block */
+static uint16_t rxRawLen;            /** Expected raw block length */
+static volatile uint16_t rxRawCnt;   /** Raw characters received so far */
+static volatile uint32_t rxRawTick;  /** Time of last raw character (MCU_TIM_getTimeMs) */
+static volatile bool rxRawActive;    /** Incoming characters are stored in raw block */
+#ifndef USE_UART_DMA_RX
+static bool rxRawArmed;              /** Raw block requested, activated once line is consumed */
+#endif
+#ifdef USE_UART_DMA_RX
+static uint8_t uartRxDmaBuf[RXDMA_BUF_SIZE];
+static uint16_t rxDmaRIdx;  /** Next character to read from DMA RX buffer */
+static int16_t rxLineLen;   /** Number of valid characters in line buffer uartRxBuf */
+#endif
+#ifdef USE_UART_DMA_TX
+static uint8_t uartTxRing[TXRING_SIZE];
+static volatile uint16_t txHead;   /** Next free position in TX ring */
+static volatile uint16_t txTail;   /** First position not yet sent in TX ring */
+static volatile uint16_t txDmaLen; /** Length of the chunk being sent by DMA, 0 if DMA is idle */
+#endif
 
 /* Private function prototypes -----------------------------------------------*/
 
+static void MCU_AT_CONSOLE_rawTimeoutCb(void);
+
 // Functions that could be used to (potentially) remove string.h :
 //unsigned int strlen(const char *str)
 //{
@@ -69,13 +115,163 @@ static bool (*rxEvtCb)(uint8_t *pu8_RxBuffer, int16_t *pi16_nbRxValidChar);
 //    return str;
 //}
 
+/** @brief Start receiving the raw block, its inter-character timeout starts now
+ *
+ * @attention To be called under critical section
+ */
+static void MCU_AT_CONSOLE_rawStart(void)
+{
+	rxRawActive = true;
+	rxRawTick = MCU_TIM_getTimeMs();
+	MCU_TIM_swStart(MCU_TIM_SW_AT_RAW_GAP, MCU_AT_CONSOLE_RAW_TIMEOUT_MS,
+		MCU_AT_CONSOLE_rawTimeoutCb);
+}
+
+/** @brief Store one incoming character into the raw block being received
+ *
+ * The raw block ends once complete, rxRawActive being cleared. The character only refreshes the
+ * time of last raw character, checked by the inter-character timer (\ref
+ * MCU_AT_CONSOLE_rawTimeoutCb), so that RTC wakeup timer is not reprogrammed at each character.
+ *
+ * @param[in] u8_c received character
+ *
+ * @return true if character is part of the raw block, false if it belongs to the line stream,
+ * i.e. block was just aborted on timeout
+ */
+static bool MCU_AT_CONSOLE_rawPutc(uint8_t u8_c)
+{
+	KNS_CS_enter();
+	if (!rxRawActive) {
+		KNS_CS_exit();
+		return false;
+	}
+	rxRawTick = MCU_TIM_getTimeMs();
+
+	if (rxRawBuf != NULL)
+		rxRawBuf[rxRawCnt] = u8_c;
+	rxRawCnt++;
+	if (rxRawCnt >= rxRawLen) {
+		rxRawActive = false;
+		MCU_TIM_swStop(MCU_TIM_SW_AT_RAW_GAP);
+	}
+	KNS_CS_exit();
+	return true;
+}
+
+/** @brief Notify client that raw block is over (complete or aborted) and go back to line mode
+ */
+static void MCU_AT_CONSOLE_rawDone(void)
+{
+	void (*raw_evt_cb)(uint16_t u16_rxLen) = rxRawCb;
+
+	rxRawCb = NULL;
+	if (raw_evt_cb != NULL)
+		raw_evt_cb(rxRawCnt);
+}
+
+#ifndef USE_UART_DMA_RX
+/** @brief Parse RX characters received from UART, run from Kineis OS deferred work
+ *
+ * RX buffer is handed to the callback line by line, i.e. up to each end-of-line character
+ * ('\r'). The callback is said to consume data, it updates the number-of-valid-char reduced by
+ * what was consummed. Characters received after the end-of-line, possibly while parsing, are then
+ * moved just after the remaining valid ones.
+ *
+ * As the RX interrupt keeps on filling the buffer while parsing, UART RX pointers are only read
+ * and realigned within critical sections.
+ *
+ * @note If the RX buffer overflowed while parsing, the whole buffer is lost as the ISR already
+ *       restarted writing from its beginning.
+ *
+ * @param[in] ctx UART handle.
+ */
+static void KINEIS_RxParseWork(void *ctx)
+{
+	UART_HandleTypeDef *huart = (UART_HandleTypeDef *)ctx;
+	uint8_t *pu8_RxBuffer;
+	int16_t i16_nbRxChar;
+	int16_t i16_nbRxValidChar;
+	int16_t i16_eolLen;
+	int16_t i16_scanIdx = 0;
+	int16_t i16_rawNb;
+	bool isRawEnd;
+
+	rxParsePending = false;
+
+	/** Lines received after an ongoing raw block are parsed once it is over */
+	while ((rxEvtCb != NULL) && (rxRawCb == NULL)) {
+		KNS_CS_enter();
+		i16_nbRxChar = huart->RxXferSize - huart->RxXferCount;
+		pu8_RxBuffer = huart->pRxBuffPtr - i16_nbRxChar;
+		//< pu8_RxBuffer points to the 1st element of the RX array
+		KNS_CS_exit();
+
+		/* Find next end-of-line not yet handed to the callback */
+		for (i16_eolLen = i16_scanIdx; i16_eolLen < i16_nbRxChar; i16_eolLen++)
+			if (pu8_RxBuffer[i16_eolLen] == '\r')
+				break;
+		if (i16_eolLen >= i16_nbRxChar)
+			break;
+		i16_eolLen++;
+
+		i16_nbRxValidChar = i16_eolLen;
+		while (rxEvtCb(pu8_RxBuffer, &i16_nbRxValidChar) == true) {
+			// empty loop
+		};
+
+		KNS_CS_enter();
+		i16_nbRxChar = huart->RxXferSize - huart->RxXferCount;
+		i16_rawNb = 0;
+		isRawEnd = false;
+		if (rxRawArmed) {
+			//< from now on, RX interrupt stores incoming characters in raw block
+			rxRawArmed = false;
+			MCU_AT_CONSOLE_rawStart();
+			//< characters already received after the end-of-line start the raw block
+			while (rxRawActive && ((i16_eolLen + i16_rawNb) < i16_nbRxChar))
+				MCU_AT_CONSOLE_rawPutc(pu8_RxBuffer[i16_eolLen + i16_rawNb++]);
+			isRawEnd = !rxRawActive;
+		}
+		if (i16_nbRxChar >= i16_eolLen) {
+			//< keep characters received after the end-of-line behind remaining valid ones
+			memmove(&pu8_RxBuffer[i16_nbRxValidChar], &pu8_RxBuffer[i16_eolLen + i16_rawNb],
+				i16_nbRxChar - i16_eolLen - i16_rawNb);
+			i16_scanIdx = i16_nbRxValidChar;
+			i16_nbRxValidChar += i16_nbRxChar - i16_eolLen - i16_rawNb;
+			//< realign huart to the beginning of found AT cmd
+			huart->pRxBuffPtr = pu8_RxBuffer + i16_nbRxValidChar;
+			huart->RxXferCount = huart->RxXferSize - i16_nbRxValidChar;
+		} else
+			i16_scanIdx = 0;
+		KNS_CS_exit();
+
+		if (isRawEnd)
+			MCU_AT_CONSOLE_rawDone();
+	}
+}
+
+/** @brief Notify end of raw block detected by RX interrupt, then parse lines received after it
+ *
+ * @param[in] ctx UART handle.
+ */
+static void KINEIS_RxRawDoneWork(void *ctx)
+{
+	MCU_AT_CONSOLE_rawDone();
+	KINEIS_RxParseWork(ctx);
+}
+
 /** @brief RX interrupt handler for 7 or 8 bits data word length .
  *
- * This function is highly based on STM32HAL_UART expect callback is called at each received
- * character. This allow to treat RX received characters as a continuous stream.
+ * This function is highly based on STM32HAL_UART expect received characters are treated as a
+ * continuous stream.
  *
- * At each received character, the callback is said to consume data, it updates the buffer pointer
- * and the number-of-valid-char reduced by what was consummed.
+ * Characters are only stored here. Once an end-of-line character is received, parsing is posted
+ * to Kineis OS deferred work queue (\ref KINEIS_RxParseWork) so that this interrupt stays short.
+ * If the work queue is full, parsing is done in place.
+ *
+ * While a raw block is being received (\ref MCU_AT_CONSOLE_rxRaw), characters are stored in the
+ * raw block instead. Its end is notified through the work queue as well, lines received after the
+ * block being parsed only then.
  *
  * @note In case of overflow on RX buffer, force write from the beginning of the buffer pRxBuffPtr.
  *       thus, the entire buffer may be lost. Actually, such case may only happen in case:
@@ -97,12 +293,8 @@ static void KINEIS_RxISR_8BIT(UART_HandleTypeDef *huart)
 {
 	uint16_t uhMask = huart->Mask;
 	uint16_t  uhdata;
-	uint8_t *pu8_RxBuffer = NULL;
-	int16_t i16_nbRxValidChar = 0;
-
-	i16_nbRxValidChar = huart->RxXferSize - huart->RxXferCount;
-	pu8_RxBuffer = huart->pRxBuffPtr - i16_nbRxValidChar;
-	//< pu8_RxBuffer points to the 1st element of the RX array
+	bool isEolRx = false;
+	bool isRawEnd = false;
 
 	/* Check that a Rx process is ongoing */
 	if (huart->RxState == HAL_UART_STATE_BUSY_RX) {
@@ -111,7 +303,16 @@ static void KINEIS_RxISR_8BIT(UART_HandleTypeDef *huart)
 		 */
 		while ((READ_REG(huart->Instance->ISR) & USART_ISR_RXNE) != 0U) {
 			uhdata = (uint16_t) READ_REG(huart->Instance->RDR);
+			if (rxRawActive) {
+				bool isRawChar = MCU_AT_CONSOLE_rawPutc((uint8_t)(uhdata & uhMask));
+
+				isRawEnd |= !rxRawActive;
+				if (isRawChar)
+					continue;
+			}
 			*huart->pRxBuffPtr = (uint8_t)(uhdata & (uint8_t)uhMask);
+			if (*huart->pRxBuffPtr == '\r')
+				isEolRx = true;
 
 			/* In case of overflow, force writing from the beginning of the buffer
 			 */
@@ -125,21 +326,14 @@ static void KINEIS_RxISR_8BIT(UART_HandleTypeDef *huart)
 			}
 		}
 
-		/* Should raise an os_event to main task/function */
-		/* \todo implement call back mechanism to raise os event instead of using
-		 * global variables directly.
-		 */
-
-		if (rxEvtCb != NULL) {
-			i16_nbRxValidChar = huart->RxXferSize - huart->RxXferCount;
-			pu8_RxBuffer = huart->pRxBuffPtr - i16_nbRxValidChar;
-			//< pu8_RxBuffer points to the 1st element of the RX array
-			while (rxEvtCb(pu8_RxBuffer, &i16_nbRxValidChar) == true) {
-				// empty loop
-			};
-			//< realign huart to the beginning of found AT cmd
-			huart->pRxBuffPtr = pu8_RxBuffer + i16_nbRxValidChar;
-			huart->RxXferCount = huart->RxXferSize - i16_nbRxValidChar;
+		if (isRawEnd) {
+			if (KNS_OS_postWork(KINEIS_RxRawDoneWork, huart) != KNS_STATUS_OK)
+				KINEIS_RxRawDoneWork(huart);
+		}
+		if (isEolRx && (rxEvtCb != NULL) && !rxParsePending) {
+			rxParsePending = true;
+			if (KNS_OS_postWork(KINEIS_RxParseWork, huart) != KNS_STATUS_OK)
+				KINEIS_RxParseWork(huart);
 		}
 	} else {
 		/* Clear RXNE interrupt flag */
@@ -208,6 +402,252 @@ static HAL_StatusTypeDef KINEIS_UART_StartRx_IT(UART_HandleTypeDef *huart, uint8
 	}
 }
 
+#else /* USE_UART_DMA_RX */
+
+/** @brief Parse RX characters received by DMA, run from Kineis OS deferred work
+ *
+ * Characters written by DMA since last call are appended to the line buffer (uartRxBuf). At each
+ * end-of-line character ('\r'), the line buffer is handed to the callback which consumes AT cmds
+ * and updates the number-of-valid-char reduced by what was consummed.
+ *
+ * While a raw block is being received (\ref MCU_AT_CONSOLE_rxRaw), characters are stored in the
+ * raw block instead of the line buffer.
+ *
+ * @note In case of overflow on line buffer, force write from its beginning, thus the entire
+ *       buffer is lost (same behaviour as interrupt mode).
+ * @note DMA buffer must be drained before DMA wraps over unread characters, i.e. within
+ *       RXDMA_BUF_SIZE/2 character times as half transfer event posts this work.
+ *
+ * @param[in] ctx UART handle.
+ */
+static void KINEIS_RxDmaWork(void *ctx)
+{
+	UART_HandleTypeDef *huart = (UART_HandleTypeDef *)ctx;
+	uint16_t u16_wIdx;
+	uint8_t u8_c;
+
+	rxParsePending = false;
+
+	/* Raw block aborted on timeout (\ref MCU_AT_CONSOLE_rawTimeoutCb), notified before next lines */
+	if ((rxRawCb != NULL) && !rxRawActive)
+		MCU_AT_CONSOLE_rawDone();
+
+	u16_wIdx = (RXDMA_BUF_SIZE - __HAL_DMA_GET_COUNTER(huart->hdmarx)) % RXDMA_BUF_SIZE;
+	while (rxDmaRIdx != u16_wIdx) {
+		u8_c = uartRxDmaBuf[rxDmaRIdx];
+		rxDmaRIdx = (rxDmaRIdx + 1) % RXDMA_BUF_SIZE;
+
+		if (rxRawActive) {
+			bool isRawChar = MCU_AT_CONSOLE_rawPutc(u8_c);
+
+			if (!rxRawActive)
+				MCU_AT_CONSOLE_rawDone();
+			if (isRawChar)
+				continue;
+		}
+
+		if (rxLineLen >= RXBUF_SIZE)
+			rxLineLen = 0;
+		uartRxBuf[rxLineLen++] = u8_c;
+
+		if ((u8_c == '\r') && (rxEvtCb != NULL)) {
+			while (rxEvtCb(uartRxBuf, &rxLineLen) == true) {
+				// empty loop
+			};
+		}
+	}
+}
+
+/** @brief Restart DMA reception after an error, run from Kineis OS deferred work
+ *
+ * @param[in] ctx UART handle.
+ */
+static void KINEIS_RxDmaRestartWork(void *ctx)
+{
+	UART_HandleTypeDef *huart = (UART_HandleTypeDef *)ctx;
+
+	rxDmaRIdx = 0;
+	if (HAL_UARTEx_ReceiveToIdle_DMA(huart, uartRxDmaBuf, sizeof(uartRxDmaBuf)) != HAL_OK)
+		kns_assert(0);
+}
+
+/** @brief UART RX event callback, called by HAL at DMA half/full transfer or at idle line
+ *
+ * It overrides the generic defined weak callback. Parsing is posted to Kineis OS deferred work
+ * queue (\ref KINEIS_RxDmaWork), or done in place if the work queue is full.
+ *
+ * @param huart UART handle.
+ * @param Size  position of DMA in RX buffer (unused, DMA counter is read by the work)
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+	if ((huart != huart_handle) || rxParsePending)
+		return;
+
+	rxParsePending = true;
+	if (KNS_OS_postWork(KINEIS_RxDmaWork, huart) != KNS_STATUS_OK)
+		KINEIS_RxDmaWork(huart);
+}
+
+#endif /* USE_UART_DMA_RX */
+
+/** @brief Raw block inter-character timer expiry, called from ISR context
+ *
+ * If some character came since the timer was started, it is restarted for the time left after
+ * the last one. Otherwise the block is aborted. As at block end, the client is notified from
+ * Kineis OS deferred work, before lines received after the block are parsed.
+ */
+static void MCU_AT_CONSOLE_rawTimeoutCb(void)
+{
+	uint32_t u32_elapsed;
+
+	KNS_CS_enter();
+	if (!rxRawActive) {
+		KNS_CS_exit();
+		return;
+	}
+	u32_elapsed = MCU_TIM_getTimeMs() - rxRawTick;
+	if (u32_elapsed < MCU_AT_CONSOLE_RAW_TIMEOUT_MS) {
+		MCU_TIM_swStart(MCU_TIM_SW_AT_RAW_GAP, MCU_AT_CONSOLE_RAW_TIMEOUT_MS - u32_elapsed,
+			MCU_AT_CONSOLE_rawTimeoutCb);
+		KNS_CS_exit();
+		return;
+	}
+	rxRawActive = false;
+	KNS_CS_exit();
+
+#ifdef USE_UART_DMA_RX
+	if (rxParsePending)
+		return;
+	rxParsePending = true;
+	if (KNS_OS_postWork(KINEIS_RxDmaWork, huart_handle) != KNS_STATUS_OK)
+		KINEIS_RxDmaWork(huart_handle);
+#else
+	if (KNS_OS_postWork(KINEIS_RxRawDoneWork, huart_handle) != KNS_STATUS_OK)
+		KINEIS_RxRawDoneWork(huart_handle);
+#endif
+}
+
+#ifdef USE_UART_DMA_TX
+/** @brief Start DMA on next chunk of TX ring if DMA is idle
+ *
+ * A chunk goes up to the TX ring head, or up to the end of the ring if data wraps.
+ */
+static void MCU_AT_CONSOLE_txKick(void)
+{
+	KNS_CS_enter();
+	if ((txDmaLen == 0U) && (txHead != txTail)) {
+		txDmaLen = (txHead > txTail) ? (txHead - txTail) : (TXRING_SIZE - txTail);
+		/** UART may be busy with some blocking TX (e.g. logs), retried at next send */
+		if (HAL_UART_Transmit_DMA(huart_handle, &uartTxRing[txTail], txDmaLen) != HAL_OK)
+			txDmaLen = 0;
+	}
+	KNS_CS_exit();
+}
+
+/** @brief Append data to TX ring and start DMA
+ *
+ * If the ring is full, wait for DMA to free some room up to MCU_AT_CONSOLE_TX_FULL_TIMEOUT_MS.
+ * Data are dropped on timeout, or immediately if called from interrupt context.
+ *
+ * @param[in] pu8_data data to send
+ * @param[in] u16_len length of data in bytes
+ */
+static void MCU_AT_CONSOLE_txPush(const uint8_t *pu8_data, uint16_t u16_len)
+{
+	uint32_t u32_tickStart = HAL_GetTick();
+	uint16_t u16_chunkLen;
+
+	KNS_CS_enter();
+	while (((txTail + TXRING_SIZE - txHead - 1U) % TXRING_SIZE) < u16_len) {
+		KNS_CS_exit();
+		if ((__get_IPSR() != 0U) ||
+		    ((HAL_GetTick() - u32_tickStart) > MCU_AT_CONSOLE_TX_FULL_TIMEOUT_MS))
+			return;
+		MCU_AT_CONSOLE_txKick();
+		KNS_CS_enter();
+	}
+	u16_chunkLen = TXRING_SIZE - txHead;
+	if (u16_chunkLen > u16_len)
+		u16_chunkLen = u16_len;
+	memcpy(&uartTxRing[txHead], pu8_data, u16_chunkLen);
+	memcpy(uartTxRing, &pu8_data[u16_chunkLen], u16_len - u16_chunkLen);
+	txHead = (txHead + u16_len) % TXRING_SIZE;
+	KNS_CS_exit();
+
+	MCU_AT_CONSOLE_txKick();
+}
+
+/** @brief UART TX complete callback, called by HAL once DMA chunk is sent on the wire
+ *
+ * It overrides the generic defined weak callback. It releases the chunk and starts next one.
+ *
+ * @param huart UART handle.
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	if (huart != huart_handle)
+		return;
+
+	txTail = (txTail + txDmaLen) % TXRING_SIZE;
+	txDmaLen = 0;
+	MCU_AT_CONSOLE_txKick();
+}
+#endif /* USE_UART_DMA_TX */
+
+/** @brief Write raw characters to console
+ *
+ * @param[in] pu8_data characters to send
+ * @param[in] u16_len number of characters
+ */
+static void MCU_AT_CONSOLE_write(const uint8_t *pu8_data, uint16_t u16_len)
+{
+	/* Send log message via UART */
+	if (huart_handle != NULL)
+#ifdef USE_UART_DMA_TX
+		MCU_AT_CONSOLE_txPush(pu8_data, u16_len);
+#else
+		HAL_UART_Transmit(huart_handle, (uint8_t *)pu8_data, u16_len, 500);
+#endif
+	else {
+		/** Console is said to be correctly initialized before use
+		 *
+		 */
+		kns_assert(0);
+	}
+}
+
+#if defined(USE_UART_DMA_RX) || defined(USE_UART_DMA_TX)
+/** @brief UART error callback. HAL aborted a DMA transfer on error (framing, noise, DMA, ...)
+ *
+ * It overrides the generic defined weak callback.
+ * * RX: reception is restarted from main loop so that DMA read index is not reset while RX
+ *   parsing work is running.
+ * * TX: the chunk being sent is dropped and next one is started.
+ *
+ * @param huart UART handle.
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+	if (huart != huart_handle)
+		return;
+
+#ifdef USE_UART_DMA_TX
+	if ((huart->gState == HAL_UART_STATE_READY) && (txDmaLen != 0U)) {
+		txTail = (txTail + txDmaLen) % TXRING_SIZE;
+		txDmaLen = 0;
+		MCU_AT_CONSOLE_txKick();
+	}
+#endif
+#ifdef USE_UART_DMA_RX
+	if (huart->RxState == HAL_UART_STATE_READY) {
+		if (KNS_OS_postWork(KINEIS_RxDmaRestartWork, huart) != KNS_STATUS_OK)
+			KINEIS_RxDmaRestartWork(huart);
+	}
+#endif
+}
+#endif
+
 /* Functions -----------------------------------------------------------------*/
 
 bool MCU_AT_CONSOLE_register(void *handle, bool (*rx_evt_cb)(uint8_t *pu8_RxBuffer,
@@ -215,7 +655,12 @@ bool MCU_AT_CONSOLE_register(void *handle, bool (*rx_evt_cb)(uint8_t *pu8_RxBuff
 {
 	huart_handle = (UART_HandleTypeDef *)handle;
 
+#ifdef USE_UART_DMA_RX
+	if (HAL_UARTEx_ReceiveToIdle_DMA(huart_handle, uartRxDmaBuf, sizeof(uartRxDmaBuf))
+			== HAL_OK) {
+#else
 	if (KINEIS_UART_StartRx_IT(huart_handle, uartRxBuf, sizeof(uartRxBuf)) == HAL_OK) {
+#endif
 		rxEvtCb = rx_evt_cb;
 		return true;
 	} else
@@ -225,56 +670,96 @@ bool MCU_AT_CONSOLE_register(void *handle, bool (*rx_evt_cb)(uint8_t *pu8_RxBuff
 void MCU_AT_CONSOLE_send(const char *format, ...)
 {
 	va_list args;
-
-	/* Reset output buffer */
-	memset(uartTxBuf, 0x00, sizeof(uartTxBuf));
+	int i_len;
 
 	va_start(args, format);
-	vsprintf(uartTxBuf, format, args);
+	i_len = vsnprintf(uartTxBuf, sizeof(uartTxBuf), format, args);
 	va_end(args);
 	/** Check buffer is not overflowed, meaning console is not well dimensionned regarding
 	 * AT cmd responses length
 	 */
-	kns_assert(strlen(uartTxBuf) < sizeof(uartTxBuf));
+	kns_assert((i_len >= 0) && (i_len < (int)sizeof(uartTxBuf)));
+	if (i_len <= 0)
+		return;
+	if (i_len >= (int)sizeof(uartTxBuf))
+		i_len = sizeof(uartTxBuf) - 1;
 
-	/* Send log message via UART */
-	if (huart_handle != NULL)
-		HAL_UART_Transmit(huart_handle, (uint8_t *)uartTxBuf, strlen(uartTxBuf), 500);
-	else {
-		/** Console is said to be correctly initialized before use
-		 *
-		 */
-		kns_assert(0);
-	}
+	MCU_AT_CONSOLE_write((uint8_t *)uartTxBuf, (uint16_t)i_len);
+}
+
+bool MCU_AT_CONSOLE_rxRaw(uint8_t *pu8_dst, uint16_t u16_len,
+	void (*raw_evt_cb)(uint16_t u16_rxLen))
+{
+	if ((rxRawCb != NULL) || (raw_evt_cb == NULL) || (u16_len == 0))
+		return false;
+
+	rxRawCb = raw_evt_cb;
+	rxRawBuf = pu8_dst;
+	rxRawLen = u16_len;
+	rxRawCnt = 0;
+#ifdef USE_UART_DMA_RX
+	KNS_CS_enter();
+	MCU_AT_CONSOLE_rawStart();
+	KNS_CS_exit();
+#else
+	rxRawArmed = true;
+#endif
+	return true;
+}
+
+bool MCU_AT_CONSOLE_isTxOngoing(void)
+{
+#ifdef USE_UART_DMA_TX
+	return (txHead != txTail);
+#else
+	return false;
+#endif
 }
 
 void MCU_AT_CONSOLE_send_dataBuf(uint8_t *pu8_inDataBuff, uint16_t u16_dataLenBit)
 {
 	uint16_t u16_remainingBits;
 	const uint16_t u16_dataLenByte_trunc = u16_dataLenBit >> 3;
+	uint16_t u16_outLen = 0;
 	uint8_t *pu8_hex;
 
 	/*
-	 * Convert data hex to ascii per byte then last byte is
-	 * treated per nibble
+	 * Convert data hex to ascii per byte then last byte is treated per nibble. ASCII chars are
+	 * accumulated in TX buffer and sent once it is full.
 	 */
-
 	for (pu8_hex = pu8_inDataBuff;
 			(pu8_hex < (pu8_inDataBuff + u16_dataLenByte_trunc));
-			pu8_hex++)
-		MCU_AT_CONSOLE_send("%02X", *pu8_hex);
+			pu8_hex++) {
+		if (u16_outLen > (sizeof(uartTxBuf) - 2)) {
+			MCU_AT_CONSOLE_write((uint8_t *)uartTxBuf, u16_outLen);
+			u16_outLen = 0;
+		}
+		uartTxBuf[u16_outLen++] = hexDigits[*pu8_hex >> 4];
+		uartTxBuf[u16_outLen++] = hexDigits[*pu8_hex & 0x0F];
+	}
 
+	/* Last bits are MSB aligned in last byte, a single nibble is its high part */
 	u16_remainingBits = u16_dataLenBit - (u16_dataLenByte_trunc << 3);
-	if (u16_remainingBits > 4)
-		MCU_AT_CONSOLE_send("%02X", *pu8_hex);
-	else if (u16_remainingBits > 0)
-		MCU_AT_CONSOLE_send("%01X", *pu8_hex);
+	if (u16_remainingBits > 0) {
+		if (u16_outLen > (sizeof(uartTxBuf) - 2)) {
+			MCU_AT_CONSOLE_write((uint8_t *)uartTxBuf, u16_outLen);
+			u16_outLen = 0;
+		}
+		uartTxBuf[u16_outLen++] = hexDigits[*pu8_hex >> 4];
+		if (u16_remainingBits > 4)
+			uartTxBuf[u16_outLen++] = hexDigits[*pu8_hex & 0x0F];
+	}
 	/* else no additional bits */
+
+	if (u16_outLen > 0)
+		MCU_AT_CONSOLE_write((uint8_t *)uartTxBuf, u16_outLen);
 }
 
 /**
   * @brief  UART error callback. Can raise in case of UART OVERFLOW, DMA RX ERROR, ...
  *
+ * @note Implemented above when USE_UART_DMA_RX or USE_UART_DMA_TX is defined
+ *
  * This function is highly based on STM32HAL_UART. It overrides the generic defined error callback
  *
  * @note So far, this callback is emptied
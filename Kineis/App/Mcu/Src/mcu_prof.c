@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: no SPDX license
+/**
+ * @file    mcu_prof.c
+ * @author  Arribada
+ * @brief   MCU wrapper for cycle profiling based on DWT cycle counter
+ */
+
+/**
+ * @addtogroup MCU_APP_WRAPPERS
+ * @brief MCU wrapper used by Kineis Application example.
+ *
+ * One has to implement API as per its microcontroller and its platform ressources.
+ * This version is for STM32 uC such as STM32WLE5xx, STM32WL55xx.
+ * @{
+ */
+
+#ifdef USE_MCU_PROF
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "mcu_prof.h"
+#include "kns_cs.h"
+
+/* Variables -----------------------------------------------------------------*/
+
+static struct MCU_PROF_stats_t profStats[MCU_PROF_SLOT_MAX];
+
+static const char *const profName[MCU_PROF_SLOT_MAX] = {
+	[KNS_OS_TASK_APP]            = "APP",
+	[KNS_OS_TASK_MAC]            = "MAC",
+	[KNS_OS_TASK_IDLE]           = "IDLE",
+	[MCU_PROF_SLOT_ISR_LPUART]   = "LPUART",
+	[MCU_PROF_SLOT_ISR_SPI]      = "SPI",
+	[MCU_PROF_SLOT_ISR_TIM16]    = "TIM16",
+	[MCU_PROF_SLOT_ISR_RTC_WKUP] = "RTC_WKUP",
+	[MCU_PROF_SLOT_ISR_SUBGHZ]   = "SUBGHZ",
+};
+
+/* Functions -----------------------------------------------------------------*/
+
+void MCU_PROF_init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	MCU_PROF_reset();
+}
+
+void MCU_PROF_record(enum MCU_PROF_slot_t slot, uint32_t cycles)
+{
+	struct MCU_PROF_stats_t *stats = &profStats[slot];
+
+	stats->callCnt++;
+	stats->totalCyc += cycles;
+	if (cycles > stats->maxCyc)
+		stats->maxCyc = cycles;
+}
+
+void MCU_PROF_getStats(enum MCU_PROF_slot_t slot, struct MCU_PROF_stats_t *stats)
+{
+	/** ISR slots may be updated while copying, 64-bit total is not read atomically */
+	KNS_CS_enter();
+	*stats = profStats[slot];
+	KNS_CS_exit();
+}
+
+const char *MCU_PROF_getName(enum MCU_PROF_slot_t slot)
+{
+	if ((slot >= MCU_PROF_SLOT_MAX) || (profName[slot] == NULL))
+		return "?";
+	return profName[slot];
+}
+
+void MCU_PROF_reset(void)
+{
+	KNS_CS_enter();
+	memset(profStats, 0, sizeof(profStats));
+	KNS_CS_exit();
+}
+
+#endif /* USE_MCU_PROF */
+
+/**
+ * @}
+ */
@@ -26,38 +26,324 @@
 #include KINEIS_SW_ASSERT_H
 #include "mgr_log.h"
 #include "mcu_spi_driver.h"
+#include "kns_os.h"
+#include "kns_cs.h"
+#include "mcu_tim.h"
+#ifdef USE_SPI_ATTN
+#include "main.h" // for attention GPIO
+#endif
 
 /* Defines -------------------------------------------------------------------*/
 
+#ifdef USE_SPI_DMA
+/** Frame buffer size: header followed by the longest command stream or response */
+#define SPI_FRAME_BUF_SIZE (MCU_SPI_DRIVER_FRAME_HDR_LEN + RXBUF_SIZE)
+/** Command stream offset in RX frame, opcode is copied over length MSB once header is parsed */
+#define SPI_FRAME_STREAM_OFS (MCU_SPI_DRIVER_FRAME_HDR_LEN - 1)
+/** NSS pin of SPI1, its rising edge ends the frame */
+#define SPI_NSS_GPIO_PORT GPIOA
+#define SPI_NSS_GPIO_PIN GPIO_PIN_15
+#endif
 
 /* Variables -----------------------------------------------------------------*/
 static SPI_HandleTypeDef *hspi_handle = NULL;
 
 static uint8_t spiTxBuf[TXBUF_SIZE];
+#ifdef USE_SPI_DMA
+/** Command stream is read in place from RX frames */
+SPI_Buffer rxBuf = { .data = NULL, .size = 0, .next_req = 1};
+#else
 static uint8_t spiRxBuf[RXBUF_SIZE];
 SPI_Buffer rxBuf = { .data = spiRxBuf, .size = RXBUF_SIZE, .next_req = 1};
+#endif
 SPI_Buffer txBuf = { .data = spiTxBuf, .size = TXBUF_SIZE, .next_req = 0};
 
+/** A response is ready and not clocked out by the host yet */
+static volatile bool rspReady;
+
+#ifdef USE_SPI_DMA
+/** Double buffered frames: DMA captures one while the other one is consumed/filled */
+static uint8_t spiRxFrame[2][SPI_FRAME_BUF_SIZE];
+static uint8_t spiTxFrame[2][SPI_FRAME_BUF_SIZE];
+static volatile uint8_t rxFrameDmaIdx;    /**< RX frame armed on DMA, other one may be ready */
+static volatile bool rxFrameReady;        /**< other RX frame is captured, not consumed yet */
+static volatile uint16_t rxFrameLen;      /**< number of bytes clocked in ready RX frame */
+static uint8_t txFrameDmaIdx;             /**< TX frame armed on DMA, other one is being filled */
+static uint16_t txFrameFillLen;           /**< response bytes queued in filled TX frame */
+static bool rxStreamValid;                /**< ready RX frame header is parsed */
+static bool rxStreamWait;                 /**< a read is pending until next frame is parsed */
+static uint16_t rxStreamPos;              /**< read cursor in command stream of ready RX frame */
+static uint16_t rxStreamEnd;              /**< end of command stream of ready RX frame */
+static uint8_t rxFrameOpcode;             /**< opcode of ready RX frame */
+static uint8_t rxFrameSeq;                /**< sequence number of ready RX frame */
+static bool rxFrameNack;                  /**< ready RX frame is malformed or response overflowed */
+static volatile bool rspOnWire;           /**< TX frame armed on DMA is the ready response */
+#endif
 
-static int8_t (*rxSpiEvtCb)(SPI_Buffer *rx, SPI_Buffer *tx) = NULL;
 
-uint32_t startTickTimeout = 0;
+static int8_t (*rxSpiEvtCb)(SPI_Buffer *rx, SPI_Buffer *tx) = NULL;
 /* Private function prototypes -----------------------------------------------*/
 
+/**
+ * @brief Process received SPI data out of ISR context (deferred work)
+ *
+ * @param[in] ctx: unused
+ */
+static void MCU_SPI_DRIVER_rxWork(void *ctx)
+{
+	MGR_LOG_DEBUG("RX completed\r\n");
+	rxSpiEvtCb(&rxBuf, &txBuf);
+}
+
+#ifdef USE_SPI_DMA
+/**
+ * @brief Restart DMA full-duplex transfer for next frame on current RX/TX frame buffers
+ *
+ * HAL_SPI_Abort is not used as it waits for TX FIFO to drain, which never happens in slave mode
+ * between frames. SPI is reset instead, which also flushes the TX bytes prefetched from previous
+ * frame.
+ *
+ * @note Called from NSS EXTI ISR or under critical section
+ */
+static void MCU_SPI_DRIVER_dmaArm(void)
+{
+	CLEAR_BIT(hspi_handle->Instance->CR2, SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+	__HAL_SPI_DISABLE(hspi_handle);
+	/** Channels may be already stopped on full buffer, errors are meaningless here */
+	(void)HAL_DMA_Abort(hspi_handle->hdmarx);
+	(void)HAL_DMA_Abort(hspi_handle->hdmatx);
+	__HAL_RCC_SPI1_FORCE_RESET();
+	__HAL_RCC_SPI1_RELEASE_RESET();
+	hspi_handle->State = HAL_SPI_STATE_READY;
+	hspi_handle->ErrorCode = HAL_SPI_ERROR_NONE;
+	rspOnWire = rspReady;
+	if ((HAL_SPI_Init(hspi_handle) != HAL_OK) ||
+	    (HAL_SPI_TransmitReceive_DMA(hspi_handle, spiTxFrame[txFrameDmaIdx],
+			spiRxFrame[rxFrameDmaIdx], SPI_FRAME_BUF_SIZE) != HAL_OK)) {
+		spiState = SPICMD_ERROR;
+		KNS_OS_setTaskReady(KNS_OS_TASK_APP);
+	}
+}
+
+/**
+ * @brief Publish response of consumed frame, it is clocked out during next frame
+ *
+ * Nothing is published when frame produced no response (e.g. polling frame), so that previous
+ * response stays available.
+ */
+static void MCU_SPI_DRIVER_framePublish(void)
+{
+	uint8_t fillIdx = txFrameDmaIdx ^ 1;
+	uint8_t *hdr = spiTxFrame[fillIdx];
+
+	if (!rxFrameNack && (txFrameFillLen == 0))
+		return;
+
+	if (rxFrameNack)
+		txFrameFillLen = 0;
+	hdr[0] = rxFrameNack ? MCU_SPI_DRIVER_FRAME_NACK : rxFrameOpcode;
+	hdr[1] = rxFrameSeq;
+	hdr[2] = (uint8_t)(txFrameFillLen & 0xFF);
+	hdr[3] = (uint8_t)(txFrameFillLen >> 8);
+	txFrameFillLen = 0;
+	rxFrameNack = false;
+
+	KNS_CS_enter();
+	txFrameDmaIdx = fillIdx;
+	rspReady = true;
+	rspOnWire = false;
+	/** Re-arm now if no frame is in progress nor waiting for its NSS ISR, else NSS ISR does it */
+	if ((HAL_GPIO_ReadPin(SPI_NSS_GPIO_PORT, SPI_NSS_GPIO_PIN) == GPIO_PIN_SET) &&
+	    (__HAL_DMA_GET_COUNTER(hspi_handle->hdmarx) == SPI_FRAME_BUF_SIZE))
+		MCU_SPI_DRIVER_dmaArm();
+	KNS_CS_exit();
+}
+
+/**
+ * @brief Serve pending read from command stream of ready RX frame
+ *
+ * When the stream is exhausted, frame response is published and RX frame is released. A command
+ * split across the end of a frame is dropped and NACKed, next frame restarts with an opcode.
+ */
+static void MCU_SPI_DRIVER_streamRead(void)
+{
+	uint16_t avail;
+
+	if (!rxStreamValid) {
+		rxStreamWait = true;
+		return;
+	}
+
+	avail = rxStreamEnd - rxStreamPos;
+	if (avail >= rxBuf.next_req) {
+		rxStreamWait = false;
+		rxBuf.data = &spiRxFrame[rxFrameDmaIdx ^ 1][rxStreamPos];
+		rxBuf.size = rxBuf.next_req;
+		rxStreamPos += rxBuf.next_req;
+		MCU_TIM_swStop(MCU_TIM_SW_SPI_TIMEOUT);
+		if (KNS_OS_postWork(MCU_SPI_DRIVER_rxWork, NULL) != KNS_STATUS_OK)
+			MCU_SPI_DRIVER_rxWork(NULL);
+		return;
+	}
+
+	if (avail > 0) {
+		MGR_LOG_DEBUG("%s:: command truncated by end of frame\r\n", __func__);
+		rxFrameNack = true;
+		rxBuf.next_req = 1;
+	}
+	/** Release RX frame first, so that a frame ending meanwhile is not dropped */
+	rxStreamValid = false;
+	rxStreamWait = true;
+	rxFrameReady = false;
+	MCU_SPI_DRIVER_framePublish();
+}
+
+/**
+ * @brief Parse header of ready RX frame out of ISR context (deferred work)
+ *
+ * @param[in] ctx: unused
+ */
+static void MCU_SPI_DRIVER_frameWork(void *ctx)
+{
+	uint8_t *frame = spiRxFrame[rxFrameDmaIdx ^ 1];
+	uint16_t payloadLen;
+
+	(void)ctx;
+	rxFrameOpcode = frame[0];
+	rxFrameSeq = frame[1];
+	rxStreamPos = SPI_FRAME_STREAM_OFS;
+	rxStreamEnd = SPI_FRAME_STREAM_OFS;
+	if (rxFrameLen < MCU_SPI_DRIVER_FRAME_HDR_LEN) {
+		rxFrameNack = true;
+	} else {
+		payloadLen = (uint16_t)frame[2] | ((uint16_t)frame[3] << 8);
+		/** Extra bytes are allowed, host clocks them to read a response longer than request */
+		if ((MCU_SPI_DRIVER_FRAME_HDR_LEN + payloadLen) > rxFrameLen) {
+			rxFrameNack = true;
+		} else {
+			frame[SPI_FRAME_STREAM_OFS] = rxFrameOpcode;
+			rxStreamEnd = MCU_SPI_DRIVER_FRAME_HDR_LEN + payloadLen;
+		}
+	}
+	if (rxFrameNack)
+		MGR_LOG_DEBUG("%s:: malformed frame (%u bytes)\r\n", __func__, rxFrameLen);
+	rxStreamValid = true;
+	if (rxStreamWait)
+		MCU_SPI_DRIVER_streamRead();
+}
+
+/**
+ * @brief End of frame, called from NSS rising edge ISR
+ *
+ * Captured frame is handed over to main loop and DMA is re-armed on the other RX frame at once,
+ * so that host can chain frames while previous one is processed.
+ */
+static void MCU_SPI_DRIVER_frameEndIsr(void)
+{
+	uint16_t len;
+
+	if (hspi_handle == NULL)
+		return;
+
+	len = SPI_FRAME_BUF_SIZE - __HAL_DMA_GET_COUNTER(hspi_handle->hdmarx);
+	/** NSS toggled without any clock, keep current transfer armed */
+	if (len == 0)
+		return;
+
+	/** Host got the ready response with this frame */
+	if (rspOnWire && (len >= MCU_SPI_DRIVER_FRAME_HDR_LEN)) {
+		rspReady = false;
+		KNS_OS_setTaskReady(KNS_OS_TASK_APP);
+	}
+
+	/** Frame is dropped when both RX frames are busy, host gets no response for its sequence */
+	if (!rxFrameReady) {
+		rxFrameLen = len;
+		rxFrameReady = true;
+		rxFrameDmaIdx ^= 1;
+		if (KNS_OS_postWork(MCU_SPI_DRIVER_frameWork, NULL) != KNS_STATUS_OK)
+			MCU_SPI_DRIVER_frameWork(NULL);
+	}
+	MCU_SPI_DRIVER_dmaArm();
+}
+
+/**
+ * @brief Drop frames in progress and start capturing the first frame
+ */
+static void MCU_SPI_DRIVER_frameStart(void)
+{
+	KNS_CS_enter();
+	rxFrameReady = false;
+	rxStreamValid = false;
+	rxStreamWait = false;
+	rxFrameNack = false;
+	txFrameFillLen = 0;
+	rspReady = false;
+	memset(spiTxFrame, 0, sizeof(spiTxFrame));
+	MCU_SPI_DRIVER_dmaArm();
+	KNS_CS_exit();
+}
+#endif
 
 // /* Functions -----------------------------------------------------------------*/
+#ifdef USE_SPI_DMA
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+	if (GPIO_Pin == SPI_NSS_GPIO_PIN)
+		MCU_SPI_DRIVER_frameEndIsr();
+}
+
+HAL_StatusTypeDef MCU_SPI_DRIVER_writeread()
+{
+	uint8_t *payload = &spiTxFrame[txFrameDmaIdx ^ 1][MCU_SPI_DRIVER_FRAME_HDR_LEN];
+
+	if (txBuf.next_req > TXBUF_SIZE) {
+		spiState = SPICMD_ERROR;
+		return HAL_ERROR;
+	}
+	if ((txFrameFillLen + txBuf.next_req) > (SPI_FRAME_BUF_SIZE - MCU_SPI_DRIVER_FRAME_HDR_LEN)) {
+		MGR_LOG_DEBUG("%s:: response overflows frame\r\n", __func__);
+		rxFrameNack = true;
+	} else {
+		memcpy(&payload[txFrameFillLen], txBuf.data, txBuf.next_req);
+		txFrameFillLen += txBuf.next_req;
+	}
+	/** Response goes out with next frame, transfer is over from command handler point of view */
+	spiState = SPICMD_IDLE;
+	KNS_OS_setTaskReady(KNS_OS_TASK_APP);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef MCU_SPI_DRIVER_read()
+{
+	if(rxBuf.next_req < 1) {
+		MGR_LOG_DEBUG("%s:: Waiting RX is %u should be greater than 0\r\n",__func__, rxBuf.next_req);
+		rxBuf.next_req = 1; // next request forced to 1
+	}
+	/** Command stream of a frame cannot be longer than RX buffer, such read never completes */
+	if (rxBuf.next_req > RXBUF_SIZE) {
+		spiState = SPICMD_ERROR;
+		return HAL_ERROR;
+	}
+	spiState = SPICMD_WAITING_RX;
+	MCU_SPI_DRIVER_streamRead();
+	return HAL_OK;
+}
+#else
 // Callback when a command is received
 void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi) {
     if (hspi->Instance == SPI1) {
-        MGR_LOG_DEBUG("RX completed\r\n");
         if (rxSpiEvtCb != NULL)
         {
         	//rxBuf.size = 1;
-        	rxSpiEvtCb(&rxBuf, &txBuf);
-			startTickTimeout = 0;
+			MCU_TIM_swStop(MCU_TIM_SW_SPI_TIMEOUT);
+			/** Parse received data from main loop, process it in place if not possible */
+			if (KNS_OS_postWork(MCU_SPI_DRIVER_rxWork, NULL) != KNS_STATUS_OK)
+				MCU_SPI_DRIVER_rxWork(NULL);
         } else {
 			MGR_LOG_DEBUG("%s:: rxSpiEvtCb not defined\r\n", __func__);
             spiState = SPICMD_ERROR;
+			KNS_OS_setTaskReady(KNS_OS_TASK_APP);
         }
     } else {
 		MGR_LOG_DEBUG("%s::ERROR SPI interrupt from other SPI instance\r\n", __func__);
@@ -69,8 +355,10 @@ void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi) {
 void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
     if (hspi->Instance == SPI1) {
         MGR_LOG_DEBUG("TX-RX completed\r\n");
+		rspReady = false;
 		spiState = SPICMD_IDLE;
-		startTickTimeout = 0;
+		MCU_TIM_swStop(MCU_TIM_SW_SPI_TIMEOUT);
+		KNS_OS_setTaskReady(KNS_OS_TASK_APP);
     } else {
 		MGR_LOG_DEBUG("%s::ERROR SPI interrupt from other SPI instance\r\n", __func__);
     	kns_assert(0);
@@ -81,8 +369,7 @@ void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
 void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) {
     if (hspi->Instance == SPI1) {
         MGR_LOG_DEBUG("TX completed\r\n");
-		startTickTimeout = 0;
-		startTickTimeout = 0;
+		MCU_TIM_swStop(MCU_TIM_SW_SPI_TIMEOUT);
     } else {
 		MGR_LOG_DEBUG("%s::ERROR SPI interrupt from other SPI instance\r\n", __func__);
     	kns_assert(0);
@@ -93,8 +380,13 @@ HAL_StatusTypeDef MCU_SPI_DRIVER_writeread()
 {
 	HAL_StatusTypeDef ret = HAL_OK;
 	// waiting Read request
+	if (txBuf.next_req > TXBUF_SIZE) {
+		spiState = SPICMD_ERROR;
+		return HAL_ERROR;
+	}
 	ret = HAL_SPI_TransmitReceive_IT(hspi_handle, txBuf.data, rxBuf.data, txBuf.next_req);
 	if (ret == HAL_OK){
+		rspReady = true;
 		spiState = SPICMD_WAITING_TX;
 	} else {
 		spiState = SPICMD_ERROR;
@@ -108,6 +400,10 @@ HAL_StatusTypeDef MCU_SPI_DRIVER_read()
 		MGR_LOG_DEBUG("%s:: Waiting RX is %u should be greater than 0\r\n",__func__, rxBuf.next_req);
 		rxBuf.next_req = 1; // next request forced to 1
 	}
+	if (rxBuf.next_req > RXBUF_SIZE) {
+		spiState = SPICMD_ERROR;
+		return HAL_ERROR;
+	}
 	HAL_StatusTypeDef ret = HAL_SPI_Receive_IT(hspi_handle, rxBuf.data, rxBuf.next_req);
 	if (ret == HAL_OK) {
 		spiState = SPICMD_WAITING_RX;
@@ -116,8 +412,24 @@ HAL_StatusTypeDef MCU_SPI_DRIVER_read()
 	}
 	return ret;
 }
+#endif
+
 
 
+bool MCU_SPI_DRIVER_isRspReady(void)
+{
+	return rspReady;
+}
+
+void MCU_SPI_DRIVER_setAttn(bool active)
+{
+#ifdef USE_SPI_ATTN
+	/** Open-drain active low line, released when nothing to report */
+	HAL_GPIO_WritePin(SPI_ATTN_GPIO_Port, SPI_ATTN_Pin, active ? GPIO_PIN_RESET : GPIO_PIN_SET);
+#else
+	(void)active;
+#endif
+}
 
 bool MCU_SPI_DRIVER_register(void *handle, int8_t (*rx_spi_evt_cb)(SPI_Buffer *rx, SPI_Buffer *tx))
 {
@@ -146,6 +458,9 @@ bool MCU_SPI_DRIVER_register(void *handle, int8_t (*rx_spi_evt_cb)(SPI_Buffer *r
 	// Set SPI OK and TX WAITING flags
 	txBuf.next_req = 0;
 	rxBuf.next_req = 1;
+#ifdef USE_SPI_DMA
+	MCU_SPI_DRIVER_frameStart();
+#endif
     ret = MCU_SPI_DRIVER_read();
 	// Start receiving the command
     if (ret == HAL_OK) // Want to read the command received
@@ -161,6 +476,8 @@ bool MCU_SPI_DRIVER_reset(SPI_HandleTypeDef *hspi)
 {
 	// Set SPI OK and TX WAITING flags
 	MGR_LOG_DEBUG("%s:: called\r\n", __func__);
+	MCU_TIM_swStop(MCU_TIM_SW_SPI_TIMEOUT);
+	rspReady = false;
 
 	if (hspi != NULL && hspi_handle == NULL) // Handle is not set yet
 	{
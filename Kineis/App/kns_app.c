@@ -25,6 +25,7 @@
 #include "kineis_sw_conf.h"
 #include KINEIS_SW_ASSERT_H
 #include "mgr_log.h"
+#include "kns_os.h"
 
 #ifdef USE_TX_LED // Light on a GPIO when TX occurs
 #include "main.h"
@@ -176,8 +177,6 @@ void KNS_APP_stdln_loop(void)
 	uint32_t seed;
 
 	uint16_t idx;
-	struct KNS_MAC_appEvt_t appEvt;
-	uint8_t buffer_tx[KNS_MAC_USRDATA_MAXLEN];
 
 	switch (state) {
 	case 0: { /** Init MAC profile */
@@ -199,6 +198,8 @@ void KNS_APP_stdln_loop(void)
 				case (KNS_MAC_OK):
 					MGR_LOG_DEBUG("[%s] MAC profile init OK\r\n", __func__);
 					state++;
+					/** next state does not wait for any event */
+					KNS_OS_setTaskReady(KNS_OS_TASK_APP);
 					break;
 				case (KNS_MAC_ERROR):
 					MGR_LOG_DEBUG("[%s] MAC profile error\r\n", __func__);
@@ -214,32 +215,37 @@ void KNS_APP_stdln_loop(void)
 	}
 	case 2: { /** Send data event */
 		struct KNS_CFG_radio_t device_radio_cfg;
+		struct KNS_MAC_appEvt_t *appEvt;
+
+		/** Build event directly in APP2MAC queue slot, retry at next loop if full */
+		if (KNS_Q_reserve(KNS_Q_DL_APP2MAC, (void **)&appEvt) != KNS_STATUS_OK) {
+			KNS_OS_setTaskReady(KNS_OS_TASK_APP);
+			return;
+		}
 
 		/** Initialize buffer with random data */
-		for (idx = 0; idx < sizeof(buffer_tx); idx++)
-			buffer_tx[idx] = rand_r(((unsigned int *)&seed));
+		for (idx = 0; idx < sizeof(appEvt->data_ctxt.usrdata); idx++)
+			appEvt->data_ctxt.usrdata[idx] = rand_r(((unsigned int *)&seed));
 
 		/** ---- OPTIONAL BLOCK ---- START -- needed if radio conf not hardcoded -----   */
 		kns_assert(KNS_CFG_getRadioInfo(&device_radio_cfg) == KNS_STATUS_OK);
 
-		appEvt.id =  KNS_MAC_SEND_DATA;
-		for (idx = 0; idx < sizeof(buffer_tx); idx++)
-			appEvt.data_ctxt.usrdata[idx] = buffer_tx[idx];
-		appEvt.data_ctxt.sf = KNS_SF_NO_SERVICE;
+		appEvt->id =  KNS_MAC_SEND_DATA;
+		appEvt->data_ctxt.sf = KNS_SF_NO_SERVICE;
 
 		switch (device_radio_cfg.modulation) {
 		case (KNS_TX_MOD_LDA2):
 			/** max payload size in this  example, cf spec for smaller packets */
-			appEvt.data_ctxt.usrdata_bitlen = 192;
+			appEvt->data_ctxt.usrdata_bitlen = 192;
 			break;
 		case (KNS_TX_MOD_LDA2L):
-			appEvt.data_ctxt.usrdata_bitlen = 196;
+			appEvt->data_ctxt.usrdata_bitlen = 196;
 			break;
 		case (KNS_TX_MOD_VLDA4):
-			appEvt.data_ctxt.usrdata_bitlen = 24;
+			appEvt->data_ctxt.usrdata_bitlen = 24;
 			break;
 		case (KNS_TX_MOD_LDK):
-			appEvt.data_ctxt.usrdata_bitlen = 152;
+			appEvt->data_ctxt.usrdata_bitlen = 152;
 			break;
 		default:
 			kns_assert(0); // wrong modulation flashed into device
@@ -248,9 +254,9 @@ void KNS_APP_stdln_loop(void)
 		/** ---- OPTIONAL BLOCK ---- END ---------------------------------------------   */
 
 		MGR_LOG_DEBUG("[%s] request to send 0x", __func__);
-		MGR_LOG_array(appEvt.data_ctxt.usrdata, (appEvt.data_ctxt.usrdata_bitlen+7)>>3);
+		MGR_LOG_array(appEvt->data_ctxt.usrdata, (appEvt->data_ctxt.usrdata_bitlen+7)>>3);
 
-		TEST_ASSERT(KNS_Q_push(KNS_Q_DL_APP2MAC, (void *)&appEvt) == KNS_STATUS_OK);
+		TEST_ASSERT(KNS_Q_commit(KNS_Q_DL_APP2MAC) == KNS_STATUS_OK);
 
 		state++; /* go to next state, and return to let higher task to process event */
 		return;
@@ -391,6 +397,8 @@ void KNS_APP_gui_loop(void)
 #if defined(USE_SPI_DRIVER)
 	MGR_SPI_CMD_state_handler();
 	MGR_SPI_CMD_macEvtProcess();
+	if (MGR_SPI_CMD_isPendingCmd())
+		KNS_OS_setTaskReady(KNS_OS_TASK_APP);
 #endif
 #if defined(USE_UART_DRIVER)
 	uint8_t *pu8_atcmd = NULL;
@@ -398,6 +406,8 @@ void KNS_APP_gui_loop(void)
 	if (pu8_atcmd != NULL)
 		MGR_AT_CMD_decodeAt(pu8_atcmd);  // @todo: return code is not used ?
 	MGR_AT_CMD_macEvtProcess();
+	if (MGR_AT_CMD_isPendingAt())
+		KNS_OS_setTaskReady(KNS_OS_TASK_APP);
 #endif
 }
 
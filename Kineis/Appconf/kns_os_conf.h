@@ -20,6 +20,9 @@
  * no notion of priorities on tasks. Priorities are rather handled at queue level. Before popping
  * an event from a queue the baremetal OS checks ther is no event present in higher-priority queues
  * before. Refer to \ref kns_q_page for extra details on this.
+ *
+ * With USE_KNS_OS_EVT_DRIVEN compilation flag, the queues consumed by each task shall also be
+ * listed (\ref KNS_OS_TASK_QUEUES) so that a task is run as soon as some event is pushed in.
  */
 
 /**
@@ -47,6 +50,30 @@ enum KNS_OS_taskHdlr_t {
 	KNS_OS_TASK_MAX   /**< number of tasks */
 };
 
+/* Defines ------------------------------------------------------------------------------------- */
+
+/**
+ * @brief Queues consumed by each task, as a mask of KNS_Q_EVT_MASK(), used by the event-driven
+ * scheduler
+ * @attention align it with the queues popped by each task
+ */
+#define KNS_OS_TASK_QUEUES { \
+	[KNS_OS_TASK_APP]  = KNS_Q_EVT_MASK(KNS_Q_UL_MAC2APP), \
+	[KNS_OS_TASK_MAC]  = KNS_Q_EVT_MASK(KNS_Q_DL_APP2MAC) | \
+			     KNS_Q_EVT_MASK(KNS_Q_UL_INFRA2MAC) | \
+			     KNS_Q_EVT_MASK(KNS_Q_UL_SRVC2MAC), \
+	[KNS_OS_TASK_IDLE] = 0 \
+}
+
+/**
+ * @brief Maximum number of deferred works posted from ISRs and not yet run (\ref KNS_OS_postWork)
+ *
+ * Power of 2, at least the number of distinct works posted from ISRs (11 so far: RF/TCXO in
+ * MCU_MISC, console RX, SPI RX, certification AT cmds). Works which must not fail to be posted
+ * (MCU_MISC ones) are posted at most once until run, and assert there is room.
+ */
+#define KNS_OS_WORK_MAX 16
+
 #pragma GCC visibility pop
 
 #endif /* KNS_OS_CONF_H */
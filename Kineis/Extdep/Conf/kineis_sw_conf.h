@@ -58,11 +58,13 @@ enum ERROR_RETURN_T {
 	ERROR_UNKNOWN_AT_CMD            = 6,
 	ERROR_INVALID_ID                = 7,
 	ERROR_UNKNOWN_ID                = 8,
+	ERROR_AT_CMD_FIFO_FULL          = 9,
 
 	// user data errors
 	ERROR_INVALID_USER_DATA_LENGTH  = 20,
 	ERROR_DATA_QUEUE_FULL           = 21,
 	ERROR_DATA_QUEUE_EMPTY          = 22,
+	ERROR_USER_DATA_CRC             = 23,
 
 	// protocol errors
 	ERROR_RX_TIMEOUT                = 30,
@@ -16,8 +16,11 @@
 
 /* Includes ------------------------------------------------------------------------------------ */
 
+#include <stddef.h>
+#include <string.h>
 #include "kns_q_conf.h"
 #include "kns_q.h"
+#include "mcu_tim.h"
 
 #pragma GCC visibility push(default)
 
@@ -25,44 +28,184 @@
 
 #ifdef USE_BAREMETAL
 
+#ifdef USE_HDA4
+/** Bytes of MAC2APP events placed before the context union */
+#define SRVC_EVT_HDR_LEN offsetof(struct KNS_MAC_srvcEvt_t, tx_ctxt)
+
+/**
+ * @brief Check some MAC2APP event carries TX user data in its context
+ * @param[in] evtId: MAC event ID
+ * @retval true if tx_ctxt is used
+ */
+static bool KNS_Q_CONF_isTxCtxt(enum KNS_MAC_srvcEvtId_t evtId)
+{
+	switch (evtId) {
+	case KNS_MAC_TX_DONE:
+	case KNS_MAC_TX_TIMEOUT:
+	case KNS_MAC_TXACK_DONE:
+	case KNS_MAC_TXACK_TIMEOUT:
+	case KNS_MAC_OK:
+	case KNS_MAC_ERROR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * @brief Get number of bytes of TX user data really used
+ * @param[in] bitlen: user data length in bits
+ * @retval length in bytes
+ */
+static uint16_t KNS_Q_CONF_txDataLen(uint16_t bitlen)
+{
+	uint16_t len = (bitlen + 7) / 8;
+
+	return (len > KNS_MAC_USRDATA_MAXLEN) ? KNS_MAC_USRDATA_MAXLEN : len;
+}
+
+/**
+ * @brief Get packed length of MAC2APP event context, other than tx_ctxt
+ * @param[in] evtId: MAC event ID
+ * @retval length in bytes
+ */
+static uint16_t KNS_Q_CONF_srvcEvtCtxtLen(enum KNS_MAC_srvcEvtId_t evtId)
+{
+	switch (evtId) {
+	case KNS_MAC_SAT_DETECTED:
+	case KNS_MAC_SAT_DETECT_TIMEOUT:
+		return sizeof(struct KNS_MAC_SATDET_ctxt_t);
+	case KNS_MAC_DL_BC:
+	case KNS_MAC_DL_ACK:
+		return sizeof(struct KNS_MAC_RX_dl_msg_ctxt_t);
+	case KNS_MAC_SAT_LOST:
+	case KNS_MAC_RF_ABORTED:
+		return 0;
+	default:
+		/** Context is unknown, keep the whole union */
+		return sizeof(struct KNS_MAC_srvcEvt_t) - SRVC_EVT_HDR_LEN;
+	}
+}
+
+static uint16_t KNS_Q_CONF_srvcEvtLen(const void *qItem)
+{
+	const struct KNS_MAC_srvcEvt_t *evt = qItem;
+
+	if (KNS_Q_CONF_isTxCtxt(evt->id))
+		return SRVC_EVT_HDR_LEN + sizeof(uint16_t) +
+			KNS_Q_CONF_txDataLen(evt->tx_ctxt.data_bitlen);
+	return SRVC_EVT_HDR_LEN + KNS_Q_CONF_srvcEvtCtxtLen(evt->id);
+}
+
+static void KNS_Q_CONF_srvcEvtPack(uint8_t *dst, const void *qItem)
+{
+	const struct KNS_MAC_srvcEvt_t *evt = qItem;
+
+	memcpy(dst, evt, SRVC_EVT_HDR_LEN);
+	dst += SRVC_EVT_HDR_LEN;
+	if (KNS_Q_CONF_isTxCtxt(evt->id)) {
+		memcpy(dst, &evt->tx_ctxt.data_bitlen, sizeof(uint16_t));
+		memcpy(dst + sizeof(uint16_t), evt->tx_ctxt.data,
+			KNS_Q_CONF_txDataLen(evt->tx_ctxt.data_bitlen));
+	} else {
+		memcpy(dst, (const uint8_t *)evt + SRVC_EVT_HDR_LEN,
+			KNS_Q_CONF_srvcEvtCtxtLen(evt->id));
+	}
+}
+
+static void KNS_Q_CONF_srvcEvtUnpack(void *qItem, const uint8_t *src)
+{
+	struct KNS_MAC_srvcEvt_t *evt = qItem;
+
+	memcpy(evt, src, SRVC_EVT_HDR_LEN);
+	src += SRVC_EVT_HDR_LEN;
+	if (KNS_Q_CONF_isTxCtxt(evt->id)) {
+		memcpy(&evt->tx_ctxt.data_bitlen, src, sizeof(uint16_t));
+		memcpy(evt->tx_ctxt.data, src + sizeof(uint16_t),
+			KNS_Q_CONF_txDataLen(evt->tx_ctxt.data_bitlen));
+	} else {
+		memcpy((uint8_t *)evt + SRVC_EVT_HDR_LEN, src, KNS_Q_CONF_srvcEvtCtxtLen(evt->id));
+	}
+}
+
+static const struct q_codec_t qCodecSrvcEvt = {
+	.eltLen = KNS_Q_CONF_srvcEvtLen,
+	.eltPack = KNS_Q_CONF_srvcEvtPack,
+	.eltUnpack = KNS_Q_CONF_srvcEvtUnpack
+};
+#endif /* USE_HDA4 */
+
+/** @note APP2MAC and MAC2APP queues are only used from the main loop (APP and MAC tasks), thus
+ * they are lock-free single-producer/single-consumer queues. SRVC2MAC and INFRA2MAC are pushed
+ * from several ISRs (RF driver, timers), they keep the critical section.
+ */
 static uint8_t qDataApp2Mac[KNS_Q_DL_APP2MAC_LEN][KNS_Q_DL_APP2MAC_ITEM_BYTESIZE];
+static uint32_t qTickApp2Mac[KNS_Q_DL_APP2MAC_LEN];
 static struct q_desc_t qApp2Mac = {
 	.mutex = false,
+	.isSpsc = true,
 	.rIdx = 0,
 	.wIdx = 0,
 	.nbElt = KNS_Q_DL_APP2MAC_LEN,
 	.eltSize = KNS_Q_DL_APP2MAC_ITEM_BYTESIZE,
-	.data = (uint8_t *)qDataApp2Mac
+	.data = (uint8_t *)qDataApp2Mac,
+	.eltTick = qTickApp2Mac
 };
 
+#ifdef USE_HDA4
+/** @note in HDA4, MAC2APP elements are stored packed as most of them are far shorter than the
+ * 633-byte user data they could carry.
+ */
+static uint8_t qDataMac2App[KNS_Q_UL_MAC2APP_RING_BYTESIZE];
+static struct KNS_MAC_srvcEvt_t qWScratchMac2App;
+static struct KNS_MAC_srvcEvt_t qRScratchMac2App;
+#else
 static uint8_t qDataMac2App[KNS_Q_UL_MAC2APP_LEN][KNS_Q_UL_MAC2APP_ITEM_BYTESIZE];
+#endif
+static uint32_t qTickMac2App[KNS_Q_UL_MAC2APP_LEN];
 static struct q_desc_t qMac2App = {
 	.mutex = false,
+	.isSpsc = true,
 	.rIdx = 0,
 	.wIdx = 0,
 	.nbElt = KNS_Q_UL_MAC2APP_LEN,
 	.eltSize = KNS_Q_UL_MAC2APP_ITEM_BYTESIZE,
-	.data = (uint8_t *)qDataMac2App
+	.data = (uint8_t *)qDataMac2App,
+	.eltTick = qTickMac2App,
+#ifdef USE_HDA4
+	.codec = &qCodecSrvcEvt,
+	.ringSize = KNS_Q_UL_MAC2APP_RING_BYTESIZE,
+	.rOff = 0,
+	.wOff = 0,
+	.wScratch = (uint8_t *)&qWScratchMac2App,
+	.rScratch = (uint8_t *)&qRScratchMac2App
+#endif
 };
 
 static uint8_t qDataSrvc2Mac[KNS_Q_UL_SRVC2MAC_LEN][KNS_Q_UL_SRVC2MAC_ITEM_BYTESIZE];
+static uint32_t qTickSrvc2Mac[KNS_Q_UL_SRVC2MAC_LEN];
 static struct q_desc_t qSrvc2Mac = {
 	.mutex = false,
+	.isSpsc = false,
 	.rIdx = 0,
 	.wIdx = 0,
 	.nbElt = KNS_Q_UL_SRVC2MAC_LEN,
 	.eltSize = KNS_Q_UL_SRVC2MAC_ITEM_BYTESIZE,
-	.data = (uint8_t *)qDataSrvc2Mac
+	.data = (uint8_t *)qDataSrvc2Mac,
+	.eltTick = qTickSrvc2Mac
 };
 
 static uint8_t qDataInfra2Mac[KNS_Q_UL_INFRA2MAC_LEN][KNS_Q_UL_INFRA2MAC_ITEM_BYTESIZE];
+static uint32_t qTickInfra2Mac[KNS_Q_UL_INFRA2MAC_LEN];
 static struct q_desc_t qInfra2Mac = {
 	.mutex = false,
+	.isSpsc = false,
 	.rIdx = 0,
 	.wIdx = 0,
 	.nbElt = KNS_Q_UL_INFRA2MAC_LEN,
 	.eltSize = KNS_Q_UL_INFRA2MAC_ITEM_BYTESIZE,
-	.data = (uint8_t *)qDataInfra2Mac
+	.data = (uint8_t *)qDataInfra2Mac,
+	.eltTick = qTickInfra2Mac
 };
 
 struct q_desc_t *qPool[KNS_Q_MAX] = {
@@ -91,6 +234,14 @@ const char *qIdx2Str[KNS_Q_MAX] = {
 };
 #endif /* (defined (DEBUG) || defined (VERBOSE)) */
 
+/* Functions ----------------------------------------------------------------------------------- */
+
+uint32_t KNS_Q_getTickMs(void)
+{
+	/** RTC based, HAL tick stops in STOP mode while elements wait in queues */
+	return MCU_TIM_getTimeMs();
+}
+
 #endif /* USE_BAREMETAL */
 
 #pragma GCC visibility pop
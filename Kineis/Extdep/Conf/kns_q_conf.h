@@ -56,6 +56,14 @@
 #define KNS_Q_UL_MAC2APP_LEN           5
 #endif // end of USE_BAREMETAL
 #define KNS_Q_UL_MAC2APP_ITEM_BYTESIZE sizeof(struct KNS_MAC_srvcEvt_t)
+#if (defined(USE_BAREMETAL) && defined(USE_HDA4))
+/**< In HDA4, MAC2APP is a variable-length queue. Most events only carry a few bytes, only TX
+ * related ones carry user data. Byte ring is sized to hold at least 3 TX events with maximum user
+ * data length, whatever the number of short events around.
+ * @attention keep it even and at least twice the largest packed event (refer to \ref q_desc_t)
+ */
+#define KNS_Q_UL_MAC2APP_RING_BYTESIZE  (3 * (KNS_Q_UL_MAC2APP_ITEM_BYTESIZE + sizeof(uint16_t)))
+#endif
 
 /**< @attention queue length should be one more than expected in case of baremetal KNS OS */
 #ifdef USE_BAREMETAL
@@ -103,20 +111,51 @@ enum KNS_Q_handle_t {
 
 /* Structures ---------------------------------------------------------------------------------- */
 
+/**
+ * @struct q_codec_t
+ * @brief packing routines of a variable-length queue
+ *
+ * Elements are pushed/popped as full structures, but only the bytes really used by the event are
+ * stored in the queue. The packed length of an element shall never exceed its structure size.
+ */
+struct q_codec_t {
+	uint16_t (*eltLen)(const void *qItem);               /**< packed length of an element */
+	void (*eltPack)(uint8_t *dst, const void *qItem);    /**< pack element into queue storage */
+	void (*eltUnpack)(void *qItem, const uint8_t *src);  /**< unpack element from queue storage */
+};
+
 /**
  * @struct KNS_Q_desc_t
  * @brief queue description queue
  * @attention keep below struct descriptio, as is, in case of Kineis's baremetal OS
  *
  * All useful parameters needed to use a queue
+ *
+ * When isSpsc is set, the queue is said to have one single producer context and one single
+ * consumer context. Push/pop are then lock-free: no critical section is entered and the mutex is
+ * not used. Keep isSpsc cleared for queues which can be pushed from several ISR/task contexts.
+ *
+ * When codec is set, data is a byte ring of ringSize bytes where each element is stored packed,
+ * behind a 16-bit length tag. nbElt still bounds the number of elements. KNS_Q_reserve and
+ * KNS_Q_peek then give access to a scratch element instead of the queue storage, one for the
+ * producer and one for the consumer, so that a reserved element never overwrites a peeked one.
+ * @attention variable-length mode is only supported on single-producer/single-consumer queues.
  */
 struct q_desc_t {
 	bool mutex;
-	uint8_t rIdx;
-	uint8_t wIdx;
+	bool isSpsc;       /**< single-producer/single-consumer lock-free queue */
+	uint8_t rIdx;      /**< read index, only written by the consumer */
+	uint8_t wIdx;      /**< write index, only written by the producer */
 	uint8_t nbElt;
-	uint8_t eltSize;
+	uint16_t eltSize;  /**< HDA4 events are longer than 255 bytes */
 	uint8_t *data;
+	uint32_t *eltTick; /**< push time of each element in ms, nbElt entries, for statistics */
+	const struct q_codec_t *codec; /**< NULL for fixed-size slots, packing routines otherwise */
+	uint16_t ringSize; /**< variable-length queue only: byte size of data */
+	uint16_t rOff;     /**< variable-length queue only: byte offset of oldest element */
+	uint16_t wOff;     /**< variable-length queue only: byte offset of next element */
+	uint8_t *wScratch; /**< variable-length queue only: one element, used by reserve/commit */
+	uint8_t *rScratch; /**< variable-length queue only: one element, used by peek/release */
 };
 
 /* Extern -------------------------------------------------------------------------------------- */
@@ -127,6 +166,17 @@ extern struct q_desc_t *qPool[KNS_Q_MAX];
 extern const char *qIdx2Str[KNS_Q_MAX];
 #endif /* (defined (DEBUG) || defined (VERBOSE)) */
 
+/* Function prototypes ------------------------------------------------------------------------- */
+
+/**
+ * @brief Get a millisecond time reference, used to compute queue element residence time
+ *
+ * It shall keep counting in low power modes, as elements may wait in queues while device sleeps.
+ *
+ * @retval current time in ms
+ */
+uint32_t KNS_Q_getTickMs(void);
+
 #endif /* USE_BAREMETAL */
 
 #pragma GCC visibility pop
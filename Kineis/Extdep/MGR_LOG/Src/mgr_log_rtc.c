@@ -44,7 +44,7 @@ void MGR_LOG_RtcDateTime(void)
 	uint8_t aShowTime[15] = {0};
 	uint8_t aShowDate[15] = {0};
 
-	HAL_RTC_WaitForSynchro(&hrtc);
+	/* No synchro to wait for, shadow registers are bypassed (see MX_RTC_Init) */
 	/* Get the RTC current Time */
 	HAL_RTC_GetTime(&hrtc, &stimestructureget, RTC_FORMAT_BIN);
 	/* Get the RTC current Date */
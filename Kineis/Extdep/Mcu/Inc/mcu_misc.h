@@ -14,6 +14,11 @@
  * So far, the RF DRIVER needs some miscellaneous utilies such as:
  * * turn the externam PA ON/OFF
  * * get RF HW settings to configure the output power properly
+ *
+ * The application powers the RF up ahead of transmissions (\ref MCU_MISC_RF_acquire): TCXO
+ * warm-up and external PA power-up run in parallel, each step ending on a software timer, and
+ * the client is called back once the slowest one is over. Turning the PA ON from the RF DRIVER
+ * then only waits for the remaining steps, if any, sleeping instead of spinning.
  */
 
 /**
@@ -30,6 +35,7 @@
 #include "kns_types.h"
 
 #define MCU_PA_BOOTDELAY_MS 100 
+#define MCU_MISC_TCXO_HOLD_MAX_MS 600000 /**< Maximum TCXO idle hold time */
 /* Structures ----------------------------------------------------------------------------------- */
 
 /** @attention Structure below is platform specific, it may not fit your needs
@@ -42,6 +48,12 @@ struct rfSettings_t {
 	int8_t externalPaGain; // output gain of the external PA in dB
 };
 
+/** TCXO ready callback, called from main loop context once TCXO warm-up is over */
+typedef void (*MCU_MISC_TCXO_readyCb_t)(void);
+
+/** RF ready callback, called from main loop context once TCXO is warm and PA is powered */
+typedef void (*MCU_MISC_RF_readyCb_t)(void);
+
 /* Function declaration -------------------------------------------------------------*/
 
 /**
@@ -49,6 +61,10 @@ struct rfSettings_t {
  *
  * In case the HW design contains some external PA, this API is called by Kineis stack to
  * power it ON during transmit process
+ *
+ * If PA power-up was started in advance (\ref MCU_MISC_RF_acquire), only the remaining steps are
+ * waited for. Out of ISR context, CPU sleeps until the end of PA power-up. Under ISR or with
+ * interrupts masked, it busy-waits as timer interrupts may not be served.
  */
 void MCU_MISC_turn_on_pa();
 
@@ -57,6 +73,8 @@ void MCU_MISC_turn_on_pa();
  *
  * In case the HW design contains some external PA, this API is called by Kineis stack to
  * power it OFF during transmit process
+ *
+ * It is ignored as long as some client waits for RF ready (\ref MCU_MISC_RF_acquire).
  */
 void MCU_MISC_turn_off_pa();
 
@@ -98,10 +116,59 @@ enum KNS_status_t MCU_MISC_getSettingsHwRf(int8_t rf_level_dBm, void* rfSettings
  * When the TCXO is forced to be enabled, it will be activated; when forced to be disabled,
  * it will be turned off regardless of automatic control.
  *
+ * Enabling the TCXO starts its warm-up delay on software timer \ref MCU_TIM_SW_TCXO_WARMUP, unless
+ * it is already enabled. Disabling it is ignored as long as some user holds it
+ * (\ref MCU_MISC_TCXO_acquire).
+ *
  * @param[in] enable Set to true to force-enable the TCXO, or false to force-disable it.
  */
 void MCU_MISC_TCXO_Force_State(bool enable);
 
+/**
+ * @brief Acquire the TCXO without waiting for its warm-up.
+ *
+ * TCXO users are reference-counted. TCXO is enabled if needed and kept on until its last user
+ * releases it (\ref MCU_MISC_TCXO_release), plus some idle hold time. If it is already warm,
+ * nothing else is done. Otherwise, ready_cb is called from main loop context (Kineis OS deferred
+ * work) once warm-up timer expires. A client acquiring several times during the same warm-up is
+ * called back once.
+ *
+ * @param[in] ready_cb callback to be called once TCXO is warm
+ *
+ * @retval true if TCXO is already warm (ready_cb not called), false if ready_cb will be called
+ */
+bool MCU_MISC_TCXO_acquire(MCU_MISC_TCXO_readyCb_t ready_cb);
+
+/**
+ * @brief Release the TCXO, once per \ref MCU_MISC_TCXO_acquire
+ *
+ * Once last user is gone, TCXO is switched off at the end of the idle hold time
+ * (\ref MCU_MISC_TCXO_set_hold), unless it is acquired again meanwhile.
+ */
+void MCU_MISC_TCXO_release(void);
+
+/**
+ * @brief Power the RF up for a transmission, without waiting for it.
+ *
+ * TCXO is acquired (\ref MCU_MISC_TCXO_acquire) and external PA power-up is started at the same
+ * time, each one ending on its own software timer. If both are ready, nothing else is done.
+ * Otherwise, ready_cb is called from main loop context once the slowest one is over. A client
+ * acquiring several times during the same power-up is called back once.
+ *
+ * @param[in] ready_cb callback to be called once RF is ready
+ *
+ * @retval true if RF is already ready (ready_cb not called), false if ready_cb will be called
+ */
+bool MCU_MISC_RF_acquire(MCU_MISC_RF_readyCb_t ready_cb);
+
+/**
+ * @brief Release the RF, once per \ref MCU_MISC_RF_acquire
+ *
+ * TCXO is released (\ref MCU_MISC_TCXO_release). PA is turned OFF once last user is gone, and
+ * ready callbacks of clients still waiting for RF are dropped, never called.
+ */
+void MCU_MISC_RF_release(void);
+
 /**
  * @brief Set the warmup time for the TCXO.
  *
@@ -121,6 +188,31 @@ void MCU_MISC_TCXO_set_warmup(uint32_t time_ms);
  */
 void MCU_MISC_TCXO_get_warmup(uint32_t *time_ms);
 
+/**
+ * @brief Set the TCXO idle hold time.
+ *
+ * TCXO is kept on during this time after its last user is gone, so that back-to-back
+ * transmissions do not pay the warm-up again. 0 switches it off as soon as it is released.
+ *
+ * @param[in] time_ms Hold time in milliseconds, up to \ref MCU_MISC_TCXO_HOLD_MAX_MS.
+ */
+void MCU_MISC_TCXO_set_hold(uint32_t time_ms);
+
+/**
+ * @brief Retrieve the TCXO idle hold time.
+ *
+ * @param[out] time_ms Pointer to a variable where the hold time (in milliseconds) will be stored.
+ */
+void MCU_MISC_TCXO_get_hold(uint32_t *time_ms);
+
+/**
+ * @brief Retrieve the last measured TCXO warm-up time, from its enabling to ready.
+ *
+ * @param[out] time_ms Pointer to a variable where the measured time (in milliseconds) will be
+ * stored, 0 if TCXO never warmed-up yet.
+ */
+void MCU_MISC_TCXO_get_measured_warmup(uint32_t *time_ms);
+
 #endif /* MCU_MISC_H_ */
 
 /**
@@ -24,6 +24,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdint.h>
+#include <stdbool.h>
 #include "kns_types.h"
 
 /* Types -----------------------------------------------------------*/
@@ -52,6 +53,32 @@ enum mcu_tim_hdlr {
 	MCU_TIM_HDLR_MAX
 };
 
+/**
+ * @brief software timers multiplexed on one low-power HW timebase (RTC wakeup timer)
+ *
+ * Any number of one-shot or periodic software timers can run at the same time. The RTC wakeup
+ * timer is always programmed for the nearest deadline, thus it keeps running in STOP mode.
+ * Resolution is around 4ms (RTC sub-second counter).
+ *
+ * @note \ref MCU_TIM_HDLR_TX_PERIOD of the Kineis stack is itself run as one of those software
+ * timers.
+ *
+ * @attention Callbacks are called from RTC wakeup ISR context.
+ */
+enum mcu_tim_sw_id {
+	MCU_TIM_SW_TX_PERIOD,   /**< Kineis stack TX period, see \ref MCU_TIM_HDLR_TX_PERIOD */
+	MCU_TIM_SW_SPI_TIMEOUT, /**< SPI command multi-bytes transfer timeout */
+	MCU_TIM_SW_TCXO_WARMUP, /**< TCXO warm-up delay */
+	MCU_TIM_SW_TCXO_HOLD,   /**< TCXO idle hold time after its last user */
+	MCU_TIM_SW_PA_SEQ,      /**< External PA power-up step */
+	MCU_TIM_SW_CERTIF_REP,  /**< Certification modulated wave repetition period */
+	MCU_TIM_SW_AT_RAW_GAP,  /**< AT console raw block inter-character timeout */
+	MCU_TIM_SW_MAX
+};
+
+/** Software timer expiry callback, called from ISR context */
+typedef void (*mcu_tim_sw_cb_t)(void);
+
 /* Function declaration ------------------------------------------------------------*/
 
 /**
@@ -115,6 +142,68 @@ enum mcu_tim_status_t MCU_TIM_getCount(enum mcu_tim_hdlr hdlr, uint32_t *elapsed
  */
 enum mcu_tim_status_t MCU_TIM_stop(enum mcu_tim_hdlr hdlr);
 
+/**
+ * @brief Start (or restart) a one-shot software timer
+ *
+ * @param[in] id software timer identifier
+ * @param[in] timeout_ms delay before expiry, in milliseconds
+ * @param[in] cb callback function called at expiry, can be NULL
+ *
+ * @return  MCU_TIM_STATUS_OK if success. Error status otherwise.
+ */
+enum mcu_tim_status_t MCU_TIM_swStart(enum mcu_tim_sw_id id, uint32_t timeout_ms,
+	mcu_tim_sw_cb_t cb);
+
+/**
+ * @brief Start (or restart) a periodic software timer
+ *
+ * @param[in] id software timer identifier
+ * @param[in] period_ms period, in milliseconds
+ * @param[in] cb callback function called at each period, can be NULL
+ *
+ * @return  MCU_TIM_STATUS_OK if success. Error status otherwise.
+ */
+enum mcu_tim_status_t MCU_TIM_swStartPeriodic(enum mcu_tim_sw_id id, uint32_t period_ms,
+	mcu_tim_sw_cb_t cb);
+
+/**
+ * @brief Stop a software timer. Nothing is done if timer is not running.
+ *
+ * @param[in] id software timer identifier
+ *
+ * @return  MCU_TIM_STATUS_OK if success. Error status otherwise.
+ */
+enum mcu_tim_status_t MCU_TIM_swStop(enum mcu_tim_sw_id id);
+
+/**
+ * @brief Check a software timer is running (started and not expired yet if one-shot)
+ *
+ * @param[in] id software timer identifier
+ *
+ * @retval true if running, false otherwise
+ */
+bool MCU_TIM_swIsRunning(enum mcu_tim_sw_id id);
+
+/**
+ * @brief Get the time left before the nearest software timer deadline
+ *
+ * Typically used by low power manager to decide how deep it can sleep.
+ *
+ * @param[out] remaining_ms time left before next deadline, in milliseconds
+ *
+ * @retval true if some software timer is running, false otherwise (remaining_ms not updated)
+ */
+bool MCU_TIM_swGetNextDeadline(uint32_t *remaining_ms);
+
+/**
+ * @brief Get the monotonic time base used by software timers
+ *
+ * This time is based on RTC calendar, thus it keeps counting in low power modes.
+ *
+ * @return time in milliseconds, wrapping around 2^32
+ */
+uint32_t MCU_TIM_getTimeMs(void);
+
 #endif /* MCU_TIM_H_ */
 
 /**
@@ -14,9 +14,15 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 #include "mcu_misc.h"
 #include "main.h"
 #include "mgr_log.h"
+#include "mcu_tim.h"
+#include "kns_os.h"
+#include "kns_cs.h"
+#include "kineis_sw_conf.h"
+#include KINEIS_SW_ASSERT_H
 
 /* Defines -------------------------------------------------------------------------------------- */
 
@@ -33,6 +39,34 @@
  */
 //#define DELAY_MS(time_ms) HAL_Delay(time_ms)
 static uint32_t tcxo_warmup_time_ms = 2000;
+/** Maximum number of clients waiting for the end of TCXO warm-up at the same time */
+#define TCXO_READY_CB_MAX 4
+static MCU_MISC_TCXO_readyCb_t tcxo_ready_cb[TCXO_READY_CB_MAX];
+/** TCXO is kept on during this time after last user is gone, to save next warm-up */
+static uint32_t tcxo_hold_time_ms = 5000;
+static uint8_t tcxo_user_nb;            /**< number of TCXO users, see MCU_MISC_TCXO_acquire */
+static uint32_t tcxo_on_time_ms;        /**< time base when TCXO was last enabled */
+static uint32_t tcxo_measured_warmup_ms; /**< last measured TCXO enable to ready delay */
+/** Maximum number of clients waiting for RF ready (TCXO warm and PA powered) at the same time */
+#define RF_READY_CB_MAX 4
+static MCU_MISC_RF_readyCb_t rf_ready_cb[RF_READY_CB_MAX];
+/** Deferred works of this file, set when posted, cleared when run, see MCU_MISC_postWorkOnce */
+static volatile bool rf_ready_work_posted;
+static volatile bool tcxo_ready_work_posted;
+static volatile bool tcxo_hold_work_posted;
+#ifdef KRD_FW_MP
+/** Delay between PA supply selection and PA supply enabling */
+#define MCU_PA_PSU_SEL_TO_EN_MS 10
+/** External PA power-up steps, each one ending at pa_step_deadline_ms */
+enum pa_state_t {
+	PA_OFF,     /**< PA not powered */
+	PA_PSU_SEL, /**< PA supply selected, waiting before enabling it */
+	PA_BOOT,    /**< PA supply enabled, waiting for PA boot */
+	PA_ON       /**< PA powered and booted */
+};
+static volatile enum pa_state_t pa_state = PA_OFF;
+static uint32_t pa_step_deadline_ms;
+#endif
 extern uint32_t SystemCoreClock;
 #define FOR_LOOP_CYCLE_NB 4
 #define DELAY_MS(time_ms) \
@@ -45,12 +79,84 @@ extern uint32_t SystemCoreClock;
 
 /* Functions ------------------------------------------------------------------------------------ */
 
-void MCU_MISC_turn_on_pa()
+static void MCU_MISC_RF_readyWork(void *ctx);
+
+/**
+ * @brief Defer a work from timer ISR context to main loop context, once until it is run
+ *
+ * These works call clients back, which push events to APP2MAC queue, lock-free for main loop
+ * tasks only. They shall never run in ISR context. Each one being posted at most once,
+ * KNS_OS_WORK_MAX is sized so that posting cannot fail.
+ *
+ * @param[in,out] posted flag of the work, cleared by the work when it starts
+ * @param[in] work work to be posted
+ */
+static void MCU_MISC_postWorkOnce(volatile bool *posted, KNS_OS_work_t work)
 {
-	/** @attention this code may run under ISR, especially during continuous modulated wave */
+	/* Timer ISRs may have different priorities */
+	KNS_CS_enter();
+	if (!*posted) {
+		*posted = true;
+		kns_assert(KNS_OS_postWork(work, NULL) == KNS_STATUS_OK);
+	}
+	KNS_CS_exit();
+}
+
+/**
+ * @brief Register a client callback once in a ready callback table, under critical section
+ *
+ * @param[in,out] cb_tab table of TCXO_READY_CB_MAX or RF_READY_CB_MAX callbacks
+ * @param[in] cb_nb number of callbacks in the table
+ * @param[in] ready_cb callback to be registered
+ */
+static void MCU_MISC_readyCbAdd(void (*cb_tab[])(void), uint8_t cb_nb, void (*ready_cb)(void))
+{
+	uint8_t i;
+	uint8_t free_idx = cb_nb;
+
+	/* Register client once, whatever the number of requests during the same warm-up */
+	for (i = 0; i < cb_nb; i++) {
+		if (cb_tab[i] == ready_cb)
+			return;
+		if ((cb_tab[i] == NULL) && (free_idx == cb_nb))
+			free_idx = i;
+	}
+	kns_assert(free_idx < cb_nb);
+	cb_tab[free_idx] = ready_cb;
+}
+
 #ifdef KRD_FW_MP
+/**
+ * @brief Go to next PA power-up step, called from ISR context at the end of current one
+ */
+static void MCU_MISC_PA_seqStepCb(void)
+{
+	switch (pa_state) {
+	case PA_PSU_SEL:
+		HAL_GPIO_WritePin(PA_PSU_EN_GPIO_Port, PA_PSU_EN_Pin, GPIO_PIN_SET);
+		pa_state = PA_BOOT;
+		pa_step_deadline_ms = MCU_TIM_getTimeMs() + MCU_PA_BOOTDELAY_MS;
+		MCU_TIM_swStart(MCU_TIM_SW_PA_SEQ, MCU_PA_BOOTDELAY_MS, MCU_MISC_PA_seqStepCb);
+	break;
+	case PA_BOOT:
+		pa_state = PA_ON;
+		MCU_MISC_postWorkOnce(&rf_ready_work_posted, MCU_MISC_RF_readyWork);
+	break;
+	default:
+	break;
+	}
+}
+
+/**
+ * @brief Start PA power-up if not done yet, steps are then run by the timer service
+ */
+static void MCU_MISC_PA_seqStart(void)
+{
 	GPIO_InitTypeDef GPIO_InitStruct = {0};
 
+	if (pa_state != PA_OFF)
+		return;
+
 
 	/* GPIO Ports Clock Enable */
 	__HAL_RCC_GPIOC_CLK_ENABLE();
@@ -76,9 +182,56 @@ void MCU_MISC_turn_on_pa()
 	HAL_GPIO_Init(PA_PSU_SEL_GPIO_Port, &GPIO_InitStruct);
 
 	HAL_GPIO_WritePin(PA_PSU_SEL_GPIO_Port, PA_PSU_SEL_Pin, GPIO_PIN_SET);
-	DELAY_MS(10);
-	HAL_GPIO_WritePin(PA_PSU_EN_GPIO_Port, PA_PSU_EN_Pin, GPIO_PIN_SET);
-	DELAY_MS(MCU_PA_BOOTDELAY_MS);
+	pa_state = PA_PSU_SEL;
+	pa_step_deadline_ms = MCU_TIM_getTimeMs() + MCU_PA_PSU_SEL_TO_EN_MS;
+	MCU_TIM_swStart(MCU_TIM_SW_PA_SEQ, MCU_PA_PSU_SEL_TO_EN_MS, MCU_MISC_PA_seqStepCb);
+}
+
+/**
+ * @brief Run remaining PA power-up steps right now, busy-waiting the end of each of them
+ *
+ * Used when timer interrupts cannot be relied on (ISR context or interrupts masked).
+ */
+static void MCU_MISC_PA_seqFinishBlocking(void)
+{
+	int32_t remaining_ms;
+
+	MCU_MISC_PA_seqStart();
+	while (1) {
+		/* Steps are run here from now on, timer could only preempt us between 2 steps */
+		MCU_TIM_swStop(MCU_TIM_SW_PA_SEQ);
+		if (pa_state == PA_ON)
+			break;
+		remaining_ms = (int32_t)(pa_step_deadline_ms - MCU_TIM_getTimeMs());
+		if (remaining_ms > 0)
+			DELAY_MS((uint32_t)remaining_ms);
+		MCU_MISC_PA_seqStepCb();
+	}
+}
+#endif
+
+void MCU_MISC_turn_on_pa()
+{
+	/** @attention this code may run under ISR, especially during continuous modulated wave */
+#ifdef KRD_FW_MP
+	/** PA may already be powering-up since RF was acquired (\ref MCU_MISC_RF_acquire), only
+	 * wait for the remaining steps
+	 */
+	if ((__get_IPSR() != 0U) || (__get_PRIMASK() != 0U)) {
+		MCU_MISC_PA_seqFinishBlocking();
+		return;
+	}
+	MCU_MISC_PA_seqStart();
+	/** Sleep until PA is on, masking interrupts between state check and WFI so that the end of
+	 * last step cannot be missed
+	 */
+	__disable_irq();
+	while (pa_state != PA_ON) {
+		__WFI();
+		__enable_irq();
+		__disable_irq();
+	}
+	__enable_irq();
 #endif
 }
 
@@ -87,6 +240,14 @@ void MCU_MISC_turn_off_pa()
 	/** @attention this code may run under ISR, especially during continuous modulated wave */
 #ifdef KRD_FW_MP
 	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	uint8_t i;
+
+	/* Some client waits for RF ready, keep PA powering-up for its transmission */
+	for (i = 0; i < RF_READY_CB_MAX; i++)
+		if (rf_ready_cb[i] != NULL)
+			return;
+	MCU_TIM_swStop(MCU_TIM_SW_PA_SEQ);
+	pa_state = PA_OFF;
 
 	HAL_GPIO_WritePin(PA_PSU_EN_GPIO_Port, PA_PSU_EN_Pin, GPIO_PIN_RESET);
 	HAL_GPIO_WritePin(PA_PSU_SEL_GPIO_Port, PA_PSU_SEL_Pin, GPIO_PIN_RESET);
@@ -142,6 +303,36 @@ enum KNS_status_t MCU_MISC_getSettingsHwRf(int8_t rf_level_dBm, void* rfSettings
 	return KNS_STATUS_OK;
 }
 
+/**
+ * @brief Call clients waiting for the end of TCXO warm-up, from main loop context
+ *
+ * @param[in] ctx unused
+ */
+static void MCU_MISC_TCXO_readyWork(void *ctx)
+{
+	MCU_MISC_TCXO_readyCb_t ready_cb[TCXO_READY_CB_MAX];
+	uint8_t i;
+
+	KNS_CS_enter();
+	tcxo_ready_work_posted = false;
+	memcpy(ready_cb, tcxo_ready_cb, sizeof(ready_cb));
+	memset(tcxo_ready_cb, 0, sizeof(tcxo_ready_cb));
+	KNS_CS_exit();
+
+	for (i = 0; i < TCXO_READY_CB_MAX; i++)
+		if (ready_cb[i] != NULL)
+			ready_cb[i]();
+}
+
+/**
+ * @brief TCXO warm-up timer expiry, called from ISR context
+ */
+static void MCU_MISC_TCXO_warmupDoneCb(void)
+{
+	tcxo_measured_warmup_ms = MCU_TIM_getTimeMs() - tcxo_on_time_ms;
+	MCU_MISC_postWorkOnce(&tcxo_ready_work_posted, MCU_MISC_TCXO_readyWork);
+}
+
 void MCU_MISC_TCXO_Force_State(bool enable)
 {
     RCC_OscInitTypeDef RCC_OscInitStruct = {0};
@@ -151,17 +342,80 @@ void MCU_MISC_TCXO_Force_State(bool enable)
     RCC_OscInitStruct.OscillatorType |= RCC_OSCILLATORTYPE_HSE;
 
     if (enable) {
+        /* Already ON, keep it warm */
+        if (RCC_OscInitStruct.HSEState == RCC_HSE_BYPASS_PWR)
+            return;
         RCC_OscInitStruct.HSEState = RCC_HSE_BYPASS_PWR;
+        tcxo_on_time_ms = MCU_TIM_getTimeMs();
     }
     else {
+        /* Some user still needs it, keep it running */
+        if (tcxo_user_nb > 0)
+            return;
         RCC_OscInitStruct.HSEState = RCC_HSE_OFF;
+        MCU_TIM_swStop(MCU_TIM_SW_TCXO_WARMUP);
+        MCU_TIM_swStop(MCU_TIM_SW_TCXO_HOLD);
     }
 
     if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)  {
             Error_Handler();
     }
+
+    if (enable)
+        MCU_TIM_swStart(MCU_TIM_SW_TCXO_WARMUP, tcxo_warmup_time_ms,
+                        MCU_MISC_TCXO_warmupDoneCb);
     return;
 }
+
+/**
+ * @brief Switch TCXO off at the end of idle hold time, from main loop context
+ *
+ * @param[in] ctx unused
+ */
+static void MCU_MISC_TCXO_holdWork(void *ctx)
+{
+	tcxo_hold_work_posted = false;
+	MCU_MISC_TCXO_Force_State(false);
+}
+
+/**
+ * @brief TCXO idle hold timer expiry, called from ISR context
+ */
+static void MCU_MISC_TCXO_holdDoneCb(void)
+{
+	MCU_MISC_postWorkOnce(&tcxo_hold_work_posted, MCU_MISC_TCXO_holdWork);
+}
+
+bool MCU_MISC_TCXO_acquire(MCU_MISC_TCXO_readyCb_t ready_cb)
+{
+	kns_assert(tcxo_user_nb < UINT8_MAX);
+	tcxo_user_nb++;
+	MCU_TIM_swStop(MCU_TIM_SW_TCXO_HOLD);
+	MCU_MISC_TCXO_Force_State(true);
+
+	KNS_CS_enter();
+	if (!MCU_TIM_swIsRunning(MCU_TIM_SW_TCXO_WARMUP)) {
+		KNS_CS_exit();
+		return true;
+	}
+	MCU_MISC_readyCbAdd(tcxo_ready_cb, TCXO_READY_CB_MAX, ready_cb);
+	KNS_CS_exit();
+
+	return false;
+}
+
+void MCU_MISC_TCXO_release(void)
+{
+	kns_assert(tcxo_user_nb > 0);
+	if (--tcxo_user_nb > 0)
+		return;
+
+	if (tcxo_hold_time_ms == 0)
+		MCU_MISC_TCXO_Force_State(false);
+	else
+		MCU_TIM_swStart(MCU_TIM_SW_TCXO_HOLD, tcxo_hold_time_ms, MCU_MISC_TCXO_holdDoneCb);
+}
+
 void MCU_MISC_TCXO_set_warmup(uint32_t time_ms) {
 	tcxo_warmup_time_ms = time_ms;
     return;
@@ -170,6 +424,101 @@ void MCU_MISC_TCXO_get_warmup(uint32_t *time_ms) {
 	*time_ms = tcxo_warmup_time_ms;
 	return;
 }
+void MCU_MISC_TCXO_set_hold(uint32_t time_ms)
+{
+	tcxo_hold_time_ms = time_ms;
+}
+void MCU_MISC_TCXO_get_hold(uint32_t *time_ms)
+{
+	*time_ms = tcxo_hold_time_ms;
+}
+void MCU_MISC_TCXO_get_measured_warmup(uint32_t *time_ms)
+{
+	*time_ms = tcxo_measured_warmup_ms;
+}
+
+/**
+ * @brief Check RF is ready to transmit: TCXO warm and PA powered
+ *
+ * @retval true if RF is ready
+ */
+static bool MCU_MISC_RF_isReady(void)
+{
+	if ((tcxo_user_nb == 0) || MCU_TIM_swIsRunning(MCU_TIM_SW_TCXO_WARMUP))
+		return false;
+#ifdef KRD_FW_MP
+	return (pa_state == PA_ON);
+#else
+	return true;
+#endif
+}
+
+/**
+ * @brief Call clients waiting for RF ready once the slowest of TCXO and PA is, from main loop
+ * context
+ *
+ * @param[in] ctx unused
+ */
+static void MCU_MISC_RF_readyWork(void *ctx)
+{
+	MCU_MISC_RF_readyCb_t ready_cb[RF_READY_CB_MAX];
+	uint8_t i;
+
+	KNS_CS_enter();
+	rf_ready_work_posted = false;
+	if (!MCU_MISC_RF_isReady()) {
+		KNS_CS_exit();
+		return;
+	}
+	memcpy(ready_cb, rf_ready_cb, sizeof(ready_cb));
+	memset(rf_ready_cb, 0, sizeof(rf_ready_cb));
+	KNS_CS_exit();
+
+	for (i = 0; i < RF_READY_CB_MAX; i++)
+		if (ready_cb[i] != NULL)
+			ready_cb[i]();
+}
+
+/**
+ * @brief TCXO is warm, check whether RF is ready
+ */
+static void MCU_MISC_RF_tcxoReadyCb(void)
+{
+	MCU_MISC_RF_readyWork(NULL);
+}
+
+bool MCU_MISC_RF_acquire(MCU_MISC_RF_readyCb_t ready_cb)
+{
+	/* Power-up TCXO and PA in parallel, each one on its own timer */
+	MCU_MISC_TCXO_acquire(MCU_MISC_RF_tcxoReadyCb);
+#ifdef KRD_FW_MP
+	MCU_MISC_PA_seqStart();
+#endif
+
+	KNS_CS_enter();
+	if (MCU_MISC_RF_isReady()) {
+		KNS_CS_exit();
+		return true;
+	}
+	MCU_MISC_readyCbAdd(rf_ready_cb, RF_READY_CB_MAX, ready_cb);
+	KNS_CS_exit();
+
+	return false;
+}
+
+void MCU_MISC_RF_release(void)
+{
+	MCU_MISC_TCXO_release();
+	/* No more transmission to come: forget clients still waiting for RF ready, which would keep
+	 * PA powered, and turn it OFF
+	 */
+	if (tcxo_user_nb == 0) {
+		KNS_CS_enter();
+		memset(rf_ready_cb, 0, sizeof(rf_ready_cb));
+		KNS_CS_exit();
+		MCU_MISC_turn_off_pa();
+	}
+}
 
 /**
  * @}
@@ -21,14 +21,40 @@
 
 //#undef VERBOSE // TIM verbose log disabled by default as too verbose.
 #include "mgr_log.h"
+#include "kns_os.h"
+#include "kns_cs.h"
+#include "kineis_sw_conf.h"
+#include KINEIS_SW_ASSERT_H
 
 
 /* Extern ------------------------------------------------------------*/
 
 /* Defines ------------------------------------------------------------*/
 
+/** RTC wakeup timer clock when software timers are running: RTCCLK (LSE) / 16 */
+#define MCU_TIM_SW_WUT_HZ       (LSE_VALUE / 16)
+/** Longest delay the 16-bits RTC wakeup counter can handle, longer ones are chained */
+#define MCU_TIM_SW_WUT_MAX_MS   ((0x10000UL * 1000UL) / MCU_TIM_SW_WUT_HZ)
+/** Minimum RTC wakeup counter reload value */
+#define MCU_TIM_SW_WUT_MIN_CNT  1
+/** Deadlines closer than RTC sub-second resolution are considered as reached */
+#define MCU_TIM_SW_RES_MS       4
+/** Max number of polls of WUTWF flag, which is set within 2 RTCCLK periods (61us) once wakeup
+ * timer is disabled. Far above the ~3000 CPU cycles it takes at 48MHz.
+ */
+#define MCU_TIM_SW_WUTWF_POLL_MAX 10000
+#define MCU_TIM_DAY_MS          (24UL * 3600UL * 1000UL)
+
 /* Types -----------------------------------------------------------*/
 
+/** @brief Software timer context */
+struct mcu_tim_sw_t {
+	uint32_t deadline_ms; /**< expiry time, as per MCU_TIM_getTimeMs */
+	uint32_t period_ms;   /**< period for periodic timer, 0 for one-shot timer */
+	mcu_tim_sw_cb_t cb;   /**< expiry callback */
+	bool running;         /**< timer is started */
+};
+
 /* Macro -------------------------------------------------------------*/
 
 /* Variables ---------------------------------------------------------*/
@@ -44,8 +70,177 @@ typedef enum KNS_status_t (*timeout_isr_cb_t)(void);
 __attribute__((__section__(".lpmSection")))
 static timeout_isr_cb_t timeout_isr_cb[MCU_TIM_HDLR_MAX] = {NULL};
 
+/** Software timers, sorted by identifier. Only scanned on start/stop/expiry.
+ * @attention Kept in retention RAM: TX period is the only timer running when entering standby
+ * (see lpm_cli_tim.c), its deadline shall be checked again at wakeup as the RTC wakeup timer only
+ * counts up to MCU_TIM_SW_WUT_MAX_MS.
+ */
+__attribute__((__section__(".retentionRamData")))
+static struct mcu_tim_sw_t swTimers[MCU_TIM_SW_MAX];
+
+/** Time of day at last MCU_TIM_getTimeMs call and offset of elapsed days, kept in retention RAM
+ * for software timer deadlines to remain valid over standby.
+ */
+__attribute__((__section__(".retentionRamData")))
+static uint32_t lastDayMs;
+__attribute__((__section__(".retentionRamData")))
+static uint32_t dayOffsetMs;
+
 /* Static function declaration -------------------------------------------------------------*/
 
+/**
+ * @brief Stop RTC wakeup timer, and reload it with cnt_val in RTCCLK/16 clock if not zero.
+ *
+ * RTC registers are written directly. HAL_RTCEx_SetWakeUpTimer_IT cannot be used here: it is
+ * called from ISRs and under critical section, where its hrtc lock may be taken already and its
+ * HAL_GetTick based timeout does not run.
+ *
+ * @param[in] cnt_val wakeup timer reload value, 0 to leave timer stopped
+ */
+static void MCU_TIM_swSetWakeUpTimer(uint32_t cnt_val)
+{
+	uint32_t poll = 0;
+
+	RTC->WPR = 0xCAU;
+	RTC->WPR = 0x53U;
+	CLEAR_BIT(RTC->CR, RTC_CR_WUTE | RTC_CR_WUTIE);
+	WRITE_REG(RTC->SCR, RTC_SCR_CWUTF);
+	if (cnt_val != 0) {
+		while ((READ_BIT(RTC->ICSR, RTC_ICSR_WUTWF) == 0U) &&
+		       (poll < MCU_TIM_SW_WUTWF_POLL_MAX))
+			poll++;
+		kns_assert(poll < MCU_TIM_SW_WUTWF_POLL_MAX);
+		WRITE_REG(RTC->WUTR, cnt_val);
+		MODIFY_REG(RTC->CR, RTC_CR_WUCKSEL, RTC_WAKEUPCLOCK_RTCCLK_DIV16);
+		__HAL_RTC_WAKEUPTIMER_EXTI_ENABLE_IT();
+		SET_BIT(RTC->CR, RTC_CR_WUTIE | RTC_CR_WUTE);
+	}
+	RTC->WPR = 0xFFU;
+}
+
+/**
+ * @brief Program RTC wakeup timer for the nearest software timer deadline, or stop it if no more
+ * software timer is running. Called under critical section.
+ *
+ * @param[in] now_ms current time
+ */
+static void MCU_TIM_swProgram(uint32_t now_ms)
+{
+	uint32_t delta_ms = UINT32_MAX;
+	uint32_t cnt_val;
+	int32_t remaining_ms;
+	bool isRunning = false;
+	uint8_t id;
+
+	for (id = 0; id < MCU_TIM_SW_MAX; id++) {
+		if (!swTimers[id].running)
+			continue;
+		isRunning = true;
+		remaining_ms = (int32_t)(swTimers[id].deadline_ms - now_ms);
+		if (remaining_ms < 0)
+			remaining_ms = 0;
+		if ((uint32_t)remaining_ms < delta_ms)
+			delta_ms = remaining_ms;
+	}
+
+	if (!isRunning) {
+		MCU_TIM_swSetWakeUpTimer(0);
+		return;
+	}
+
+	if (delta_ms > MCU_TIM_SW_WUT_MAX_MS)
+		delta_ms = MCU_TIM_SW_WUT_MAX_MS;
+	cnt_val = (delta_ms * MCU_TIM_SW_WUT_HZ + 999) / 1000;
+	if (cnt_val > 0)
+		cnt_val--; /** Wakeup timer period is (counter + 1) ticks */
+	if (cnt_val < MCU_TIM_SW_WUT_MIN_CNT)
+		cnt_val = MCU_TIM_SW_WUT_MIN_CNT;
+	if (cnt_val > 0xFFFF)
+		cnt_val = 0xFFFF;
+
+	MCU_TIM_swSetWakeUpTimer(cnt_val);
+}
+
+/**
+ * @brief Call callbacks of expired software timers, re-arm periodic ones and program next
+ * deadline. Called from RTC wakeup ISR.
+ */
+static void MCU_TIM_swProcess(void)
+{
+	mcu_tim_sw_cb_t expiredCb[MCU_TIM_SW_MAX];
+	uint32_t now_ms;
+	uint8_t id;
+
+	KNS_CS_enter();
+	now_ms = MCU_TIM_getTimeMs();
+	for (id = 0; id < MCU_TIM_SW_MAX; id++) {
+		expiredCb[id] = NULL;
+		if (!swTimers[id].running ||
+		    ((int32_t)(swTimers[id].deadline_ms - now_ms) > MCU_TIM_SW_RES_MS))
+			continue;
+		expiredCb[id] = swTimers[id].cb;
+		if (swTimers[id].period_ms == 0) {
+			swTimers[id].running = false;
+		} else {
+			swTimers[id].deadline_ms += swTimers[id].period_ms;
+			/** Do not try to catch up missed periods */
+			if ((int32_t)(swTimers[id].deadline_ms - now_ms) <= 0)
+				swTimers[id].deadline_ms = now_ms + swTimers[id].period_ms;
+		}
+	}
+	KNS_CS_exit();
+
+	/** Callbacks are called out of critical section, they may start/stop timers */
+	for (id = 0; id < MCU_TIM_SW_MAX; id++) {
+		if (expiredCb[id] != NULL)
+			expiredCb[id]();
+	}
+
+	KNS_CS_enter();
+	MCU_TIM_swProgram(MCU_TIM_getTimeMs());
+	KNS_CS_exit();
+}
+
+/**
+ * @brief Start a software timer, one-shot or periodic
+ *
+ * @param[in] id software timer identifier
+ * @param[in] delay_ms delay before first expiry
+ * @param[in] period_ms period, 0 for one-shot timer
+ * @param[in] cb callback function called at expiry
+ *
+ * @return  MCU_TIM_STATUS_OK if success. Error status otherwise.
+ */
+static enum mcu_tim_status_t MCU_TIM_swArm(enum mcu_tim_sw_id id, uint32_t delay_ms,
+	uint32_t period_ms, mcu_tim_sw_cb_t cb)
+{
+	uint32_t now_ms;
+
+	if ((id >= MCU_TIM_SW_MAX) || (delay_ms > INT32_MAX))
+		return MCU_TIM_STATUS_ERROR;
+
+	KNS_CS_enter();
+	now_ms = MCU_TIM_getTimeMs();
+	swTimers[id].deadline_ms = now_ms + delay_ms;
+	swTimers[id].period_ms = period_ms;
+	swTimers[id].cb = cb;
+	swTimers[id].running = true;
+	MCU_TIM_swProgram(now_ms);
+	KNS_CS_exit();
+
+	return MCU_TIM_STATUS_OK;
+}
+
+/**
+ * @brief Kineis stack TX period expiry, run as a software timer
+ */
+static void MCU_TIM_txPeriodCb(void)
+{
+	if (timeout_isr_cb[MCU_TIM_HDLR_TX_PERIOD] != NULL)
+		timeout_isr_cb[MCU_TIM_HDLR_TX_PERIOD]();
+	KNS_OS_setTaskReady(KNS_OS_TASK_MAC);
+}
+
 /* Functions -------------------------------------------------------------*/
 
 /**
@@ -65,20 +260,23 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 			__LINE__);
 		if (timeout_isr_cb[MCU_TIM_HDLR_TX_TIMEOUT] != NULL)
 			timeout_isr_cb[MCU_TIM_HDLR_TX_TIMEOUT]();
+		KNS_OS_setTaskReady(KNS_OS_TASK_MAC);
 	}
 }
 
 /**
   * @brief  Wake Up Timer callback.
+  *
+  * Also called at standby exit (see main.c). Deadlines are always checked against RTC time, as
+  * the wakeup timer may only be an intermediate step of a long delay.
+  *
   * @param[in] hrtc_local: RTC handle
   */
 void HAL_RTCEx_WakeUpTimerEventCallback(RTC_HandleTypeDef *hrtc_local)
 {
 	if (hrtc_local == &hrtc) {
 		MGR_LOG_VERBOSE("%d: %s %d\r\n", MCU_TIM_HDLR_TX_PERIOD, __FUNCTION__, __LINE__);
-		if (timeout_isr_cb[MCU_TIM_HDLR_TX_PERIOD] != NULL)
-			timeout_isr_cb[MCU_TIM_HDLR_TX_PERIOD]();
-
+		MCU_TIM_swProcess();
 	}
 }
 
@@ -146,7 +344,6 @@ enum mcu_tim_status_t MCU_TIM_deinit(enum mcu_tim_hdlr hdlr)
 enum mcu_tim_status_t MCU_TIM_start(enum mcu_tim_hdlr hdlr, uint32_t timeout_ms)
 {
 	TIM_HandleTypeDef *htim = &htim16;
-	RTC_HandleTypeDef *hrtc_local;
 	uint32_t cnt_val, cnt_val_max;
 
 	MGR_LOG_VERBOSE("%d: %s %d\r\n", hdlr, __FUNCTION__, __LINE__);
@@ -157,7 +354,6 @@ enum mcu_tim_status_t MCU_TIM_start(enum mcu_tim_hdlr hdlr, uint32_t timeout_ms)
 		htim = &htim16;
 	break;
 	case MCU_TIM_HDLR_TX_PERIOD:
-		hrtc_local = &hrtc;
 	break;
 	default:
 		return MCU_TIM_STATUS_ERROR;
@@ -182,18 +378,9 @@ enum mcu_tim_status_t MCU_TIM_start(enum mcu_tim_hdlr hdlr, uint32_t timeout_ms)
 		HAL_TIM_Base_Start_IT(htim);
 	break;
 	case MCU_TIM_HDLR_TX_PERIOD:
-		cnt_val = timeout_ms / 1000;
-		cnt_val--; /** With this config of RTC timer (1s tick), need to reduce count down
-			    * by one
-			    */
-		cnt_val_max = (1 << 16) - 1;
-		if (cnt_val > cnt_val_max)
-			return MCU_TIM_STATUS_ERROR;
-		MGR_LOG_VERBOSE("start timer %d for %d ms, cnt=%d, cnt_max=%d\r\n",
-				hdlr, timeout_ms, cnt_val, cnt_val_max);
-		if (HAL_RTCEx_SetWakeUpTimer_IT(hrtc_local, cnt_val,
-		    RTC_WAKEUPCLOCK_CK_SPRE_16BITS, 0) != HAL_OK)
-			Error_Handler();
+		/** RTC wakeup timer is shared with other software timers */
+		MGR_LOG_VERBOSE("start timer %d for %d ms\r\n", hdlr, timeout_ms);
+		return MCU_TIM_swStart(MCU_TIM_SW_TX_PERIOD, timeout_ms, MCU_TIM_txPeriodCb);
 	break;
 	default:
 		return MCU_TIM_STATUS_ERROR;
@@ -206,7 +393,7 @@ enum mcu_tim_status_t MCU_TIM_start(enum mcu_tim_hdlr hdlr, uint32_t timeout_ms)
 enum mcu_tim_status_t MCU_TIM_getCount(enum mcu_tim_hdlr hdlr, uint32_t *elapsed_time_ms)
 {
 	TIM_HandleTypeDef *htim;
-	RTC_HandleTypeDef *hrtc_local;
+	int32_t remaining_ms;
 
 	switch (hdlr) {
 	case MCU_TIM_HDLR_TX_TIMEOUT:
@@ -215,9 +402,14 @@ enum mcu_tim_status_t MCU_TIM_getCount(enum mcu_tim_hdlr hdlr, uint32_t *elapsed
 		*elapsed_time_ms = __HAL_TIM_GET_COUNTER(htim) / 2;
 	break;
 	case MCU_TIM_HDLR_TX_PERIOD:
-		hrtc_local = &hrtc;
-		/** Get counter value and divide it by 2 as it is currently a 500us-step counter */
-		*elapsed_time_ms = 1000 * HAL_RTCEx_GetWakeUpTimer(hrtc_local);
+		/** Decrementing count: time left before TX period expiry */
+		remaining_ms = 0;
+		KNS_CS_enter();
+		if (swTimers[MCU_TIM_SW_TX_PERIOD].running)
+			remaining_ms = (int32_t)(swTimers[MCU_TIM_SW_TX_PERIOD].deadline_ms -
+				MCU_TIM_getTimeMs());
+		KNS_CS_exit();
+		*elapsed_time_ms = (remaining_ms > 0) ? (uint32_t)remaining_ms : 0;
 	break;
 	default:
 		return MCU_TIM_STATUS_ERROR;
@@ -232,7 +424,6 @@ enum mcu_tim_status_t MCU_TIM_getCount(enum mcu_tim_hdlr hdlr, uint32_t *elapsed
 enum mcu_tim_status_t MCU_TIM_stop(enum mcu_tim_hdlr hdlr)
 {
 	TIM_HandleTypeDef *htim;
-	RTC_HandleTypeDef *hrtc_local;
 
 	MGR_LOG_VERBOSE("%d: %s %d\r\n", hdlr, __FUNCTION__, __LINE__);
 
@@ -242,8 +433,7 @@ enum mcu_tim_status_t MCU_TIM_stop(enum mcu_tim_hdlr hdlr)
 		HAL_TIM_Base_Stop_IT(htim);
 	break;
 	case MCU_TIM_HDLR_TX_PERIOD:
-		hrtc_local = &hrtc;
-		HAL_RTCEx_DeactivateWakeUpTimer(hrtc_local);
+		return MCU_TIM_swStop(MCU_TIM_SW_TX_PERIOD);
 	break;
 	default:
 		return MCU_TIM_STATUS_ERROR;
@@ -253,6 +443,108 @@ enum mcu_tim_status_t MCU_TIM_stop(enum mcu_tim_hdlr hdlr)
 	return MCU_TIM_STATUS_OK;
 }
 
+enum mcu_tim_status_t MCU_TIM_swStart(enum mcu_tim_sw_id id, uint32_t timeout_ms,
+	mcu_tim_sw_cb_t cb)
+{
+	return MCU_TIM_swArm(id, timeout_ms, 0, cb);
+}
+
+enum mcu_tim_status_t MCU_TIM_swStartPeriodic(enum mcu_tim_sw_id id, uint32_t period_ms,
+	mcu_tim_sw_cb_t cb)
+{
+	if (period_ms == 0)
+		return MCU_TIM_STATUS_ERROR;
+	return MCU_TIM_swArm(id, period_ms, period_ms, cb);
+}
+
+enum mcu_tim_status_t MCU_TIM_swStop(enum mcu_tim_sw_id id)
+{
+	if (id >= MCU_TIM_SW_MAX)
+		return MCU_TIM_STATUS_ERROR;
+
+	KNS_CS_enter();
+	if (swTimers[id].running) {
+		swTimers[id].running = false;
+		MCU_TIM_swProgram(MCU_TIM_getTimeMs());
+	}
+	KNS_CS_exit();
+
+	return MCU_TIM_STATUS_OK;
+}
+
+bool MCU_TIM_swIsRunning(enum mcu_tim_sw_id id)
+{
+	if (id >= MCU_TIM_SW_MAX)
+		return false;
+	return swTimers[id].running;
+}
+
+bool MCU_TIM_swGetNextDeadline(uint32_t *remaining_ms)
+{
+	uint32_t now_ms;
+	uint32_t next_ms = UINT32_MAX;
+	int32_t delta_ms;
+	bool isRunning = false;
+	uint8_t id;
+
+	KNS_CS_enter();
+	now_ms = MCU_TIM_getTimeMs();
+	for (id = 0; id < MCU_TIM_SW_MAX; id++) {
+		if (!swTimers[id].running)
+			continue;
+		isRunning = true;
+		delta_ms = (int32_t)(swTimers[id].deadline_ms - now_ms);
+		if (delta_ms < 0)
+			delta_ms = 0;
+		if ((uint32_t)delta_ms < next_ms)
+			next_ms = delta_ms;
+	}
+	KNS_CS_exit();
+
+	if (isRunning)
+		*remaining_ms = next_ms;
+	return isRunning;
+}
+
+uint32_t MCU_TIM_getTimeMs(void)
+{
+	/** RTC calendar is read as milliseconds of the day, a day offset is added at each day
+	 * rollover. Calendar is never set by the application, so a rollover is detected each
+	 * time the time of day goes backward.
+	 */
+	uint32_t ssr;
+	uint32_t tr;
+	uint32_t predivS;
+	uint32_t dayMs;
+	uint32_t now_ms;
+
+	KNS_CS_enter();
+	/** Shadow registers are bypassed (see MX_RTC_Init), so counters are up to date even just
+	 * after a low power mode exit, without waiting for any synchro. They are read again until
+	 * two consecutive reads match, so that no carry occurred in-between. Sub-seconds counter
+	 * runs at 256Hz, thus a second read is seldom needed.
+	 */
+	do {
+		ssr = RTC->SSR;
+		tr = RTC->TR;
+	} while ((ssr != RTC->SSR) || (tr != RTC->TR));
+	predivS = RTC->PRER & RTC_PRER_PREDIV_S;
+
+	dayMs = RTC_Bcd2ToByte((tr & (RTC_TR_HT | RTC_TR_HU)) >> RTC_TR_HU_Pos);
+	dayMs = dayMs * 60 + RTC_Bcd2ToByte((tr & (RTC_TR_MNT | RTC_TR_MNU)) >> RTC_TR_MNU_Pos);
+	dayMs = dayMs * 60 + RTC_Bcd2ToByte((tr & (RTC_TR_ST | RTC_TR_SU)) >> RTC_TR_SU_Pos);
+	dayMs *= 1000;
+	if (ssr <= predivS)
+		dayMs += ((predivS - ssr) * 1000) / (predivS + 1);
+	if (dayMs < lastDayMs)
+		dayOffsetMs += MCU_TIM_DAY_MS;
+	lastDayMs = dayMs;
+	now_ms = dayOffsetMs + dayMs;
+	KNS_CS_exit();
+
+	return now_ms;
+}
+
 /**
  * @}
  */
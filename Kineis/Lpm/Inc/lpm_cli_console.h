@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: no SPDX license */
+/**
+ * @file    lpm_cli_console.h
+ * @brief   AT console's LPM client. It is implementing APIs needed to interface with the low
+ *          power manager (MGR_LPM)
+ * @author  Arribada
+ */
+
+/**
+ * @addtogroup MGR_LPM
+ * @{
+ */
+
+#ifndef LPM_CLI_CONSOLE_H
+#define LPM_CLI_CONSOLE_H
+
+/* Includes ------------------------------------------------------------------------------------ */
+#include <stdbool.h>
+#include "mgr_lpm.h"
+
+/* Enums --------------------------------------------------------------------------------------- */
+
+extern struct MgrLpmClientCb_t mgrLpmCliConsole;
+
+/* Functions ----------------------------------------------------------------------------------- */
+
+/**
+ * @brief Request deepest LPM allowed by the AT console client
+ *
+ * DMA is not running in STOP mode, thus SLEEP is requested as long as some AT console TX is
+ * ongoing (\ref MCU_AT_CONSOLE_isTxOngoing). SHUTDOWN (i.e. no constraint) otherwise.
+ *
+ * @return MgrLpm_LPM_t return the low power mode as per MGR_LPM definition
+ */
+enum MgrLpm_LPM_t CONSOLE_lpmReq(void);
+
+/**
+ * @brief Notify the AT console client which LPM is going to enter
+ *
+ * @param[in] enteringLpm entering LPM as per MGR_LPM definition
+ *
+ * @return true is status is OK, false otherwise
+ */
+bool CONSOLE_lpmNotifEnter(enum MgrLpm_LPM_t enteringLpm);
+
+/**
+ * @brief Notify the AT console client from which LPM UC just exited
+ *
+ * @param[in] exitingLpm exiting LPM as per MGR_LPM definition
+ *
+ * @return true is status is OK, false otherwise
+ */
+bool CONSOLE_lpmNotifExit(enum MgrLpm_LPM_t exitingLpm);
+
+#endif /* LPM_CLI_CONSOLE_H */
+
+/**
+ * @}
+ */
@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: no SPDX license */
+/**
+ * @file    lpm_cli_tim.h
+ * @brief   Software timers' LPM client. It is implementing APIs needed to interface with the low
+ *          power manager (MGR_LPM)
+ * @author  Arribada
+ */
+
+/**
+ * @addtogroup MGR_LPM
+ * @{
+ */
+
+#ifndef LPM_CLI_TIM_H
+#define LPM_CLI_TIM_H
+
+/* Includes ------------------------------------------------------------------------------------ */
+#include <stdbool.h>
+#include "mgr_lpm.h"
+
+/* Defines ------------------------------------------------------------------------------------- */
+
+/** Below this time left before next software timer deadline, STOP mode entry/exit is not worth */
+#ifndef LPM_CLI_TIM_STOP_MIN_MS
+#define LPM_CLI_TIM_STOP_MIN_MS 5
+#endif
+
+/* Enums --------------------------------------------------------------------------------------- */
+
+extern struct MgrLpmClientCb_t mgrLpmCliTim;
+
+/* Functions ----------------------------------------------------------------------------------- */
+
+/**
+ * @brief Request deepest LPM allowed by the software timers client
+ *
+ * Deepest LPM is computed from the next software timer deadline (\ref MCU_TIM_swGetNextDeadline):
+ * * SLEEP if next deadline is closer than \ref LPM_CLI_TIM_STOP_MIN_MS
+ * * STOP if some software timer other than the Kineis stack TX period is running, as their
+ *   peripherals do not survive STANDBY/SHUTDOWN. Software timers are kept in retention RAM, so
+ *   the TX period survives STANDBY, the decision is then left to the Kineis stack client.
+ * * SHUTDOWN (i.e. no constraint) otherwise
+ *
+ * @return MgrLpm_LPM_t return the low power mode as per MGR_LPM definition
+ */
+enum MgrLpm_LPM_t TIM_lpmReq(void);
+
+/**
+ * @brief Notify the software timers client which LPM is going to enter
+ *
+ * @param[in] enteringLpm entering LPM as per MGR_LPM definition
+ *
+ * @return true is status is OK, false otherwise
+ */
+bool TIM_lpmNotifEnter(enum MgrLpm_LPM_t enteringLpm);
+
+/**
+ * @brief Notify the software timers client from which LPM UC just exited
+ *
+ * @param[in] exitingLpm exiting LPM as per MGR_LPM definition
+ *
+ * @return true is status is OK, false otherwise
+ */
+bool TIM_lpmNotifExit(enum MgrLpm_LPM_t exitingLpm);
+
+#endif /* LPM_CLI_TIM_H */
+
+/**
+ * @}
+ */
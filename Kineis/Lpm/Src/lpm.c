@@ -24,6 +24,8 @@
 #include "lpm.h"
 #include "mgr_lpm.h"
 #include "lpm_cli_kstk.h"
+#include "lpm_cli_tim.h"
+#include "lpm_cli_console.h"
 #include "mgr_log.h"
 
 #pragma GCC visibility push(default)
@@ -379,6 +381,10 @@ void LPM_init(void)
 {
 	MGR_LPM_init(lpm_config);
 	MGR_LPM_registerClient(mgrLpmCliKstk);
+	MGR_LPM_registerClient(mgrLpmCliTim);
+#ifdef USE_UART_DMA_TX
+	MGR_LPM_registerClient(mgrLpmCliConsole);
+#endif
 }
 
 void LPM_enter(void)
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: no SPDX license
+/**
+ * @file    lpm_cli_console.c
+ * @brief   AT console's LPM client. It is implementing APIs needed to interface with the low
+ *          power manager (MGR_LPM)
+ * @author  Arribada
+ */
+
+/**
+ * @addtogroup MGR_LPM
+ * @{
+ */
+
+#ifdef USE_UART_DMA_TX
+
+/* Includes ------------------------------------------------------------------------------------ */
+#include <stdbool.h>
+#include "lpm_cli_console.h"
+#include "mgr_lpm.h"
+#include "mcu_at_console.h"
+
+/* Variables ----------------------------------------------------------------------------------- */
+
+struct MgrLpmClientCb_t mgrLpmCliConsole =
+{     .fpMGR_LPM_LpmReqCb        = CONSOLE_lpmReq,
+      .fpMGR_LPM_LpmNotifEnterCb = CONSOLE_lpmNotifEnter,
+      .fpMGR_LPM_LpmNotifExitCb  = CONSOLE_lpmNotifExit
+};
+
+/* Functions ----------------------------------------------------------------------------------- */
+
+enum MgrLpm_LPM_t CONSOLE_lpmReq(void)
+{
+	if (MCU_AT_CONSOLE_isTxOngoing())
+		return LOW_POWER_MODE_SLEEP;
+
+	return LOW_POWER_MODE_SHUTDOWN;
+}
+
+bool CONSOLE_lpmNotifEnter(__attribute__((unused)) enum MgrLpm_LPM_t enteringLpm)
+{
+	return true;
+}
+
+bool CONSOLE_lpmNotifExit(__attribute__((unused)) enum MgrLpm_LPM_t exitingLpm)
+{
+	return true;
+}
+
+#endif /* USE_UART_DMA_TX */
+
+/**
+ * @}
+ */
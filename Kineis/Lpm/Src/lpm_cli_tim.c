@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: no SPDX license
+/**
+ * @file    lpm_cli_tim.c
+ * @brief   Software timers' LPM client. It is implementing APIs needed to interface with the low
+ *          power manager (MGR_LPM)
+ * @author  Arribada
+ */
+
+/**
+ * @addtogroup MGR_LPM
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------------------------ */
+#include <stdbool.h>
+#include "lpm_cli_tim.h"
+#include "mgr_lpm.h"
+#include "mcu_tim.h"
+
+/* Variables ----------------------------------------------------------------------------------- */
+
+struct MgrLpmClientCb_t mgrLpmCliTim =
+{     .fpMGR_LPM_LpmReqCb        = TIM_lpmReq,
+      .fpMGR_LPM_LpmNotifEnterCb = TIM_lpmNotifEnter,
+      .fpMGR_LPM_LpmNotifExitCb  = TIM_lpmNotifExit
+};
+
+/* Functions ----------------------------------------------------------------------------------- */
+
+enum MgrLpm_LPM_t TIM_lpmReq(void)
+{
+	uint32_t remaining_ms;
+	uint8_t id;
+
+	if (!MCU_TIM_swGetNextDeadline(&remaining_ms))
+		return LOW_POWER_MODE_SHUTDOWN;
+
+	if (remaining_ms < LPM_CLI_TIM_STOP_MIN_MS)
+		return LOW_POWER_MODE_SLEEP;
+
+	for (id = 0; id < MCU_TIM_SW_MAX; id++) {
+		if ((id != MCU_TIM_SW_TX_PERIOD) && MCU_TIM_swIsRunning(id))
+			return LOW_POWER_MODE_STOP;
+	}
+
+	return LOW_POWER_MODE_SHUTDOWN;
+}
+
+bool TIM_lpmNotifEnter(__attribute__((unused)) enum MgrLpm_LPM_t enteringLpm)
+{
+	return true;
+}
+
+bool TIM_lpmNotifExit(__attribute__((unused)) enum MgrLpm_LPM_t exitingLpm)
+{
+	return true;
+}
+
+/**
+ * @}
+ */
@@ -247,17 +247,17 @@ static void vMGR_LPM_enterStop(struct MgrLpm_EnvConfig_t env_config)
 
 #if defined(STM32L476xx) || defined(STM32WLE5xx) || defined(STM32G491xx)
 #ifdef USE_BAREMETAL
-	if (!KNS_Q_isEvtInSomeQ()) // recheck all queues empty before LPM
+	if (KNS_Q_getEvtMask() == 0) // recheck all queues empty before LPM
 #endif
 		HAL_PWREx_EnterSTOP1Mode(PWR_STOPENTRY_WFI);
 #elif defined(STM32L071xx)
 #ifdef USE_BAREMETAL
-	if (!KNS_Q_isEvtInSomeQ()) // recheck all queues empty before LPM
+	if (KNS_Q_getEvtMask() == 0) // recheck all queues empty before LPM
 #endif
 		HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
 #elif defined(STM32WL55xx)
 #ifdef USE_BAREMETAL
-	if (!KNS_Q_isEvtInSomeQ()) // recheck all queues empty before LPM
+	if (KNS_Q_getEvtMask() == 0) // recheck all queues empty before LPM
 #endif
 //		HAL_PWREx_EnterSTOP1Mode(PWR_STOPENTRY_WFI);
 		HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
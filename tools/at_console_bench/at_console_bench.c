@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: no SPDX license
+/**
+ * @file    at_console_bench.c
+ * @author  Arribada
+ * @brief   Host benchmark of AT console data buffer encoding (MCU_AT_CONSOLE_send_dataBuf)
+ *
+ * AT console sources are built as is for the host, in blocking UART TX mode, HAL_UART_Transmit
+ * being replaced by a capture of sent characters. A payload of HDA4 max size is encoded by
+ * MCU_AT_CONSOLE_send_dataBuf, and by the former per-byte path calling MCU_AT_CONSOLE_send("%02X")
+ * for each byte, kept here as reference. Both outputs are checked equal, then both paths are
+ * timed and their number of UART transfers is reported.
+ *
+ * Build and run from repository root:
+ * @code
+ * gcc -O2 -std=gnu11 -DSTM32WL55xx -DUSE_HAL_DRIVER -DUSE_BAREMETAL -DCORE_CM4 -DUSE_HDA4 \
+ *     -I. -ICore/Inc -IDrivers/STM32WLxx_HAL_Driver/Inc -IDrivers/CMSIS/Include \
+ *     -IDrivers/CMSIS/Device/ST/STM32WLxx/Include -IKineis/Lib -IKineis/Extdep/Conf \
+ *     -IKineis/Extdep/Mcu/Inc -IKineis/Extdep/MGR_LOG/Inc -IKineis/Appconf \
+ *     -IKineis/App/Kineis_os/KNS_Q/Inc -IKineis/App/Kineis_os/KNS_OS/Inc -IKineis/App/Mcu/Inc \
+ *     -IKineis/App/Mcu/Src \
+ *     tools/at_console_bench/at_console_bench.c -o at_console_bench && ./at_console_bench
+ * @endcode
+ *
+ * Figures are host ones: they compare implementations, target cycles have to be measured with
+ * MCU_PROF. On target, each UART transfer also costs its own blocking transmit.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** Cortex-M exclusive access intrinsics, used by UART RX start which is not run here */
+#define __LDREXW(addr)         (*(addr))
+#define __STREXW(value, addr)  ((*(addr) = (value)), 0U)
+
+#include "mcu_at_console_stm.c"
+
+/** HDA4 max payload, in bytes */
+#define BENCH_PAYLOAD_LEN 633
+/** Number of encodings of the payload per timed run */
+#define BENCH_ROUND_NB 2000
+
+/* Host stubs ---------------------------------------------------------------------------------- */
+
+static UART_HandleTypeDef benchUart;
+static char capBuf[2 * BENCH_PAYLOAD_LEN + 1]; /**< characters sent on UART by last encoding */
+static uint32_t capLen;
+static uint32_t txNb;                          /**< number of UART transfers */
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData,
+	uint16_t Size, uint32_t Timeout)
+{
+	if ((capLen + Size) > sizeof(capBuf))
+		abort();
+	memcpy(&capBuf[capLen], pData, Size);
+	capLen += Size;
+	txNb++;
+	return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return 0;
+}
+
+uint32_t MCU_TIM_getTimeMs(void)
+{
+	return 0;
+}
+
+enum mcu_tim_status_t MCU_TIM_swStart(enum mcu_tim_sw_id id, uint32_t timeout_ms,
+	mcu_tim_sw_cb_t cb)
+{
+	return MCU_TIM_STATUS_OK;
+}
+
+enum mcu_tim_status_t MCU_TIM_swStop(enum mcu_tim_sw_id id)
+{
+	return MCU_TIM_STATUS_OK;
+}
+
+enum KNS_status_t KNS_OS_postWork(void (*work)(void *ctx), void *ctx)
+{
+	return KNS_STATUS_ERROR;
+}
+
+void KNS_CS_enter(void)
+{
+}
+
+void KNS_CS_exit(void)
+{
+}
+
+void kns_assert_failed(uint8_t *file, uint32_t line)
+{
+	fprintf(stderr, "assert failed %s:%u\n", (char *)file, (unsigned int)line);
+	abort();
+}
+
+/* Reference encoder --------------------------------------------------------------------------- */
+
+/**
+ * @brief Former encoder: one formatted UART transfer per byte, whole bytes only
+ */
+static void BENCH_perByteSendDataBuf(uint8_t *pu8_inDataBuff, uint16_t u16_dataLenBit)
+{
+	uint8_t *pu8_hex;
+
+	for (pu8_hex = pu8_inDataBuff; pu8_hex < (pu8_inDataBuff + (u16_dataLenBit >> 3)); pu8_hex++)
+		MCU_AT_CONSOLE_send("%02X", *pu8_hex);
+}
+
+/* Benchmark ----------------------------------------------------------------------------------- */
+
+static inline uint64_t BENCH_nowNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void BENCH_run(const char *name, void (*sendDataBuf)(uint8_t *, uint16_t),
+	uint8_t *pu8_payload)
+{
+	uint64_t t0;
+	uint32_t round;
+
+	t0 = BENCH_nowNs();
+	for (round = 0; round < BENCH_ROUND_NB; round++) {
+		capLen = 0;
+		txNb = 0;
+		sendDataBuf(pu8_payload, BENCH_PAYLOAD_LEN * 8);
+	}
+	printf("%-8s %u B: %7.2f us per payload, %u UART transfers\n", name,
+		(unsigned int)BENCH_PAYLOAD_LEN,
+		(double)(BENCH_nowNs() - t0) / (BENCH_ROUND_NB * 1000.0), (unsigned int)txNb);
+}
+
+int main(void)
+{
+	static uint8_t payload[BENCH_PAYLOAD_LEN];
+	static char refBuf[sizeof(capBuf)];
+	uint32_t refLen;
+	uint16_t i;
+
+	huart_handle = &benchUart;
+	for (i = 0; i < BENCH_PAYLOAD_LEN; i++)
+		payload[i] = (uint8_t)(i * 37 + 5);
+
+	/* Same characters as former per-byte path for whole bytes */
+	capLen = 0;
+	BENCH_perByteSendDataBuf(payload, BENCH_PAYLOAD_LEN * 8);
+	memcpy(refBuf, capBuf, capLen);
+	refLen = capLen;
+	capLen = 0;
+	MCU_AT_CONSOLE_send_dataBuf(payload, BENCH_PAYLOAD_LEN * 8);
+	if ((capLen != refLen) || (memcmp(capBuf, refBuf, refLen) != 0)) {
+		printf("encoded payloads differ\n");
+		return 1;
+	}
+
+	/* Last nibble is MSB aligned */
+	capLen = 0;
+	payload[0] = 0xA5;
+	payload[1] = 0x70;
+	MCU_AT_CONSOLE_send_dataBuf(payload, 12);
+	if ((capLen != 3) || (memcmp(capBuf, "A57", 3) != 0)) {
+		printf("bad odd nibble encoding %.*s\n", (int)capLen, capBuf);
+		return 1;
+	}
+
+	BENCH_run("per-byte", BENCH_perByteSendDataBuf, payload);
+	BENCH_run("table", MCU_AT_CONSOLE_send_dataBuf, payload);
+	return 0;
+}
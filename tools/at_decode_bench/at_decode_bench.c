@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: no SPDX license
+/**
+ * @file    at_decode_bench.c
+ * @author  Arribada
+ * @brief   Host benchmark of AT command name decoding (MGR_AT_CMD_getAtType)
+ *
+ * MGR_AT_CMD sources are built as is for the host, AT command handlers being stubbed. Every
+ * command of cas_atcmd_list_array is decoded in status, action with parameters and action without
+ * parameter modes, and checked against its own index, as well as some unknown names. Then decode
+ * latency across the command set is timed for the binary search decoder and for the former linear
+ * prefix scan, kept here as reference.
+ *
+ * Build and run from repository root:
+ * @code
+ * gcc -O2 -std=gnu11 -DSTM32WL55xx -DUSE_HAL_DRIVER -DUSE_BAREMETAL -DCORE_CM4 \
+ *     -I. -ICore/Inc -IDrivers/STM32WLxx_HAL_Driver/Inc -IDrivers/CMSIS/Include \
+ *     -IDrivers/CMSIS/Device/ST/STM32WLxx/Include -IKineis/Lib -IKineis/Extdep/Conf \
+ *     -IKineis/Extdep/Mcu/Inc -IKineis/Extdep/MGR_LOG/Inc -IKineis/Appconf \
+ *     -IKineis/App/Kineis_os/KNS_Q/Inc -IKineis/App/Kineis_os/KNS_OS/Inc -IKineis/App/Mcu/Inc \
+ *     -IKineis/App/Managers/MGR_AT_CMD/Inc -IKineis/App/Libs/STRUTIL/Inc \
+ *     -IKineis/App/Libs/USERDATA/Inc -IKineis/App/Managers/MGR_AT_CMD/Src \
+ *     tools/at_decode_bench/at_decode_bench.c -o at_decode_bench && ./at_decode_bench
+ * @endcode
+ *
+ * Figures are host ones: they compare implementations, target cycles have to be measured with
+ * MCU_PROF.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "mgr_at_cmd.c"
+#include "mgr_at_cmd_list.c"
+
+/** Number of decoding rounds over the whole command set */
+#define BENCH_ROUND_NB 200000
+
+/* Host stubs ---------------------------------------------------------------------------------- */
+
+#define BENCH_CMD_STUB(name) \
+	bool bMGR_AT_CMD_##name##_cmd(uint8_t *pu8_cmdParamString, enum atcmd_type_t e_exec_mode) \
+	{ \
+		return true; \
+	}
+
+BENCH_CMD_STUB(VERSION)
+BENCH_CMD_STUB(PING)
+BENCH_CMD_STUB(FW)
+BENCH_CMD_STUB(ADDR)
+BENCH_CMD_STUB(ID)
+BENCH_CMD_STUB(SECKEY)
+BENCH_CMD_STUB(SN)
+BENCH_CMD_STUB(RCONF)
+BENCH_CMD_STUB(SAVE_RCONF)
+BENCH_CMD_STUB(LPM)
+BENCH_CMD_STUB(TCXO)
+BENCH_CMD_STUB(QSTAT)
+BENCH_CMD_STUB(TX)
+BENCH_CMD_STUB(TXB)
+BENCH_CMD_STUB(TXBATCH)
+BENCH_CMD_STUB(CW)
+BENCH_CMD_STUB(PREPASS_EN)
+BENCH_CMD_STUB(UDATE)
+BENCH_CMD_STUB(KMAC)
+
+bool bMGR_AT_CMD_logFailedMsg(enum ERROR_RETURN_T eErrorType)
+{
+	return false;
+}
+
+bool MCU_AT_CONSOLE_register(void *context,
+		bool (*rx_evt_cb)(uint8_t *pu8_RxBuffer, int16_t *pi16_nbRxValidChar))
+{
+	return true;
+}
+
+bool MCU_AT_CONSOLE_rxRaw(uint8_t *pu8_dst, uint16_t u16_len,
+		void (*raw_evt_cb)(uint16_t u16_rxLen))
+{
+	return false;
+}
+
+void KNS_OS_setTaskReady(enum KNS_OS_taskHdlr_t tskHdlr)
+{
+}
+
+void KNS_CS_enter(void)
+{
+}
+
+void KNS_CS_exit(void)
+{
+}
+
+void kns_assert_failed(uint8_t *file, uint32_t line)
+{
+	fprintf(stderr, "assert failed %s:%u\n", (char *)file, (unsigned int)line);
+	abort();
+}
+
+/* Reference decoder --------------------------------------------------------------------------- */
+
+/**
+ * @brief Former decoder: linear scan of the list, first name being a prefix of the command wins
+ */
+static struct atcmd_info_t BENCH_linearGetAtType(uint8_t *pu8_atcmd)
+{
+	struct atcmd_info_t atcmd_info = { ATCMD_UNKNOWN_COMMAND, ATCMD_INVALID_USAGE };
+	uint16_t u16_len;
+	uint8_t u8_k;
+
+	for (u8_k = 0; u8_k < ATCMD_MAX_COUNT; u8_k++) {
+		u16_len = cas_atcmd_list_array[u8_k].u8_cmdNameLen;
+		if (memcmp(cas_atcmd_list_array[u8_k].pu8_cmdNameString, pu8_atcmd, u16_len) != 0)
+			continue;
+		if ((pu8_atcmd[u16_len] == '=') && (pu8_atcmd[u16_len + 1] == '?') &&
+				((pu8_atcmd[u16_len + 2] == '\r') || (pu8_atcmd[u16_len + 2] == '\n'))) {
+			atcmd_info.ATcmdExecType = ATCMD_STATUS_MODE;
+			atcmd_info.ATcmdIndex = (enum atcmd_idx_t)u8_k;
+		} else if ((pu8_atcmd[u16_len] == '=') || (pu8_atcmd[u16_len] == '\r') ||
+				(pu8_atcmd[u16_len] == '\n')) {
+			atcmd_info.ATcmdExecType = ATCMD_ACTION_MODE;
+			atcmd_info.ATcmdIndex = (enum atcmd_idx_t)u8_k;
+		}
+		break;
+	}
+	return atcmd_info;
+}
+
+/* Benchmark ----------------------------------------------------------------------------------- */
+
+static inline uint64_t BENCH_nowNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/** @return number of commands not decoded as expected */
+static uint32_t BENCH_check(void)
+{
+	static const char *const suffix[] = { "=?\r\n", "=1,2\r\n", "\r\n" };
+	static const enum atcmd_type_t mode[] = {
+		ATCMD_STATUS_MODE, ATCMD_ACTION_MODE, ATCMD_ACTION_MODE
+	};
+	static const char *const unknown[] = {
+		"AT+T\r\n", "AT+TXBA=1\r\n", "AT+ZZZ=?\r\n", "AT+VERSIONX\r\n", "AT+A=?\r\n", "AT+PING"
+	};
+	struct atcmd_info_t info;
+	char cmd[32];
+	uint32_t errNb = 0;
+	uint8_t k;
+	uint8_t s;
+
+	if (!MGR_AT_CMD_isListSorted()) {
+		printf("command list is not sorted\n");
+		errNb++;
+	}
+	for (k = 0; k < ATCMD_MAX_COUNT; k++) {
+		for (s = 0; s < sizeof(suffix) / sizeof(suffix[0]); s++) {
+			snprintf(cmd, sizeof(cmd), "%s%s", cas_atcmd_list_array[k].pu8_cmdNameString,
+				suffix[s]);
+			info = MGR_AT_CMD_getAtType((uint8_t *)cmd);
+			if ((info.ATcmdIndex != k) || (info.ATcmdExecType != mode[s])) {
+				printf("bad decoding of %s", cmd);
+				errNb++;
+			}
+		}
+	}
+	for (k = 0; k < sizeof(unknown) / sizeof(unknown[0]); k++) {
+		info = MGR_AT_CMD_getAtType((uint8_t *)unknown[k]);
+		if (info.ATcmdIndex != ATCMD_UNKNOWN_COMMAND) {
+			printf("%s decoded as a known command\n", unknown[k]);
+			errNb++;
+		}
+	}
+	return errNb;
+}
+
+static void BENCH_run(const char *name, struct atcmd_info_t (*getAtType)(uint8_t *))
+{
+	static char cmd[ATCMD_MAX_COUNT][32];
+	volatile uint32_t sink = 0;
+	uint64_t t0;
+	uint32_t round;
+	uint8_t k;
+
+	for (k = 0; k < ATCMD_MAX_COUNT; k++)
+		snprintf(cmd[k], sizeof(cmd[k]), "%s=?\r\n", cas_atcmd_list_array[k].pu8_cmdNameString);
+
+	t0 = BENCH_nowNs();
+	for (round = 0; round < BENCH_ROUND_NB; round++)
+		for (k = 0; k < ATCMD_MAX_COUNT; k++)
+			sink += getAtType((uint8_t *)cmd[k]).ATcmdIndex;
+	printf("%-8s %2u cmds: %6.1f ns per decode\n", name, (unsigned int)ATCMD_MAX_COUNT,
+		(double)(BENCH_nowNs() - t0) / ((double)BENCH_ROUND_NB * ATCMD_MAX_COUNT));
+}
+
+int main(void)
+{
+	uint32_t errNb = BENCH_check();
+
+	if (errNb != 0) {
+		printf("%u decoding errors\n", (unsigned int)errNb);
+		return 1;
+	}
+
+	BENCH_run("linear", BENCH_linearGetAtType);
+	BENCH_run("bsearch", MGR_AT_CMD_getAtType);
+	return 0;
+}
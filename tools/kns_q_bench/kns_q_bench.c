@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: no SPDX license
+/**
+ * @file    kns_q_bench.c
+ * @author  Arribada
+ * @brief   Host benchmark of baremetal KNS_Q push/pop cost and IRQ-masked window
+ *
+ * KNS_Q sources are built as is for the host, with KNS_CS_enter/exit replaced by probes timing
+ * each outermost critical section, i.e. the time IRQs would be masked on target. APP2MAC queue
+ * (largest fixed-size elements) is filled then drained, in locked mode then in SPSC mode.
+ *
+ * Build and run from repository root:
+ * @code
+ * gcc -O2 -std=gnu11 -DSTM32WL55xx -DUSE_HAL_DRIVER -DUSE_BAREMETAL -DCORE_CM4 \
+ *     -I. -ICore/Inc -IDrivers/STM32WLxx_HAL_Driver/Inc -IDrivers/CMSIS/Include \
+ *     -IDrivers/CMSIS/Device/ST/STM32WLxx/Include -IKineis/Lib -IKineis/Extdep/Conf \
+ *     -IKineis/Extdep/Mcu/Inc -IKineis/Extdep/MGR_LOG/Inc -IKineis/Appconf \
+ *     -IKineis/App/Kineis_os/KNS_Q/Inc -IKineis/App/Kineis_os/KNS_OS/Inc \
+ *     -IKineis/App/Kineis_os/KNS_Q/Src -IKineis/App/Mcu/Inc \
+ *     tools/kns_q_bench/kns_q_bench.c -o kns_q_bench && ./kns_q_bench
+ * @endcode
+ *
+ * Add -DKNS_Q_BENCH_OLD and put an include directory holding the former kns_q_baremetal.c,
+ * kns_q.h, kns_q_conf.h and kns_q_conf.c first, to measure an implementation without SPSC mode.
+ *
+ * Figures are host ones: they compare implementations, target cycles have to be measured with
+ * MCU_PROF.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "kns_q_baremetal.c"
+#include "kns_q_conf.c"
+
+/** Number of fill/drain rounds of each run, timed then probed */
+#define BENCH_ROUND_NB 200000
+
+/* Host stubs ---------------------------------------------------------------------------------- */
+
+uint32_t MCU_TIM_getTimeMs(void)
+{
+	return 0;
+}
+
+void kns_assert_failed(uint8_t *file, uint32_t line)
+{
+	fprintf(stderr, "assert failed %s:%u\n", (char *)file, (unsigned int)line);
+	abort();
+}
+
+/* Critical section probes --------------------------------------------------------------------- */
+
+static bool csProbeOn;
+static uint8_t csDepth;
+static uint64_t csStartNs;
+static uint32_t *csWinNs;    /**< IRQ-masked window of each outermost critical section */
+static uint32_t csWinNb;
+static uint32_t csWinMax;
+static uint64_t csProbeNs;   /**< cost of the probes themselves, removed from each window */
+
+static inline uint64_t BENCH_nowNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void KNS_CS_enter(void)
+{
+	if ((csDepth++ == 0) && csProbeOn)
+		csStartNs = BENCH_nowNs();
+}
+
+void KNS_CS_exit(void)
+{
+	uint64_t winNs;
+
+	if ((--csDepth != 0) || !csProbeOn)
+		return;
+	winNs = BENCH_nowNs() - csStartNs;
+	winNs = (winNs > csProbeNs) ? (winNs - csProbeNs) : 0;
+	if (csWinNb < csWinMax)
+		csWinNs[csWinNb++] = (uint32_t)winNs;
+}
+
+static int BENCH_cmpU32(const void *a, const void *b)
+{
+	uint32_t va = *(const uint32_t *)a;
+	uint32_t vb = *(const uint32_t *)b;
+
+	return (va > vb) - (va < vb);
+}
+
+/** Measure the cost of an empty critical section, i.e. of the probes */
+static void BENCH_calibrate(void)
+{
+	uint32_t i;
+
+	csProbeNs = 0;
+	csWinNb = 0;
+	csProbeOn = true;
+	for (i = 0; i < csWinMax; i++) {
+		KNS_CS_enter();
+		KNS_CS_exit();
+	}
+	qsort(csWinNs, csWinNb, sizeof(csWinNs[0]), BENCH_cmpU32);
+	csProbeNs = csWinNs[csWinNb / 2];
+	csProbeOn = false;
+}
+
+/* Benchmark ----------------------------------------------------------------------------------- */
+
+static void BENCH_run(const char *name)
+{
+	static struct KNS_MAC_appEvt_t evtIn;
+	static struct KNS_MAC_appEvt_t evtOut;
+	struct q_desc_t *q = qPool[KNS_Q_DL_APP2MAC];
+	uint8_t depth = q->nbElt - 1;
+	uint64_t pairNs;
+	uint64_t t0;
+	uint32_t round;
+	uint8_t i;
+
+	memset(&evtIn, 0x5A, sizeof(evtIn));
+
+	/* Time push/pop pairs without probes, queue being filled then drained at each round */
+	t0 = BENCH_nowNs();
+	for (round = 0; round < BENCH_ROUND_NB; round++) {
+		for (i = 0; i < depth; i++)
+			if (KNS_Q_push(KNS_Q_DL_APP2MAC, &evtIn) != KNS_STATUS_OK)
+				abort();
+		for (i = 0; i < depth; i++)
+			if (KNS_Q_pop(KNS_Q_DL_APP2MAC, &evtOut) != KNS_STATUS_OK)
+				abort();
+	}
+	pairNs = BENCH_nowNs() - t0;
+	if (memcmp(&evtIn, &evtOut, sizeof(evtIn)) != 0)
+		abort();
+
+	/* Then record masked windows */
+	csWinNb = 0;
+	csProbeOn = true;
+	for (round = 0; round < BENCH_ROUND_NB; round++) {
+		for (i = 0; i < depth; i++)
+			KNS_Q_push(KNS_Q_DL_APP2MAC, &evtIn);
+		for (i = 0; i < depth; i++)
+			KNS_Q_pop(KNS_Q_DL_APP2MAC, &evtOut);
+	}
+	csProbeOn = false;
+
+	printf("%-8s %4u B elt: push+pop %6.1f ns", name, (unsigned int)q->eltSize,
+		(double)pairNs / ((double)BENCH_ROUND_NB * depth));
+	if (csWinNb == 0) {
+		printf(", IRQs never masked\n");
+	} else {
+		qsort(csWinNs, csWinNb, sizeof(csWinNs[0]), BENCH_cmpU32);
+		printf(", %u masked windows: median %u ns, p99.9 %u ns\n", (unsigned int)csWinNb,
+			csWinNs[csWinNb / 2], csWinNs[(uint32_t)(csWinNb * 0.999)]);
+	}
+}
+
+int main(void)
+{
+	csWinMax = 2 * BENCH_ROUND_NB * KNS_Q_DL_APP2MAC_LEN;
+	csWinNs = malloc(csWinMax * sizeof(csWinNs[0]));
+	if (csWinNs == NULL)
+		return 1;
+
+	BENCH_calibrate();
+	printf("probe cost %u ns, removed from masked windows\n", (unsigned int)csProbeNs);
+
+#ifdef KNS_Q_BENCH_OLD
+	BENCH_run("old");
+#else
+	qPool[KNS_Q_DL_APP2MAC]->isSpsc = false;
+	BENCH_run("locked");
+
+	qPool[KNS_Q_DL_APP2MAC]->isSpsc = true;
+	BENCH_run("spsc");
+#endif
+
+	free(csWinNs);
+	return 0;
+}